@@ -0,0 +1,236 @@
+#include "BenchHarness.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static double Median(std::vector<double> v) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return (n & 1) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+static double Mad(const std::vector<double>& v, double median) {
+    std::vector<double> dev;
+    dev.reserve(v.size());
+    for (double x : v) dev.push_back(std::fabs(x - median));
+    return Median(std::move(dev));
+}
+
+BenchSummary SummarizeSamples(const std::vector<double>& samples, double outlierCutoff) {
+    BenchSummary s;
+    s.samples = samples;
+    s.rejected.assign(samples.size(), false);
+    if (samples.empty()) return s;
+
+    double median = Median(samples), mad = Mad(samples, median);
+    // With MAD == 0 most samples are identical and the z-score is undefined; keep everything
+    if (outlierCutoff > 0.0 && mad > 0.0) {
+        for (size_t i = 0; i < samples.size(); i++) s.rejected[i] = 0.6745 * std::fabs(samples[i] - median) / mad > outlierCutoff;
+    }
+
+    std::vector<double> kept;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (!s.rejected[i]) kept.push_back(samples[i]);
+    }
+    std::sort(kept.begin(), kept.end());
+    s.kept = (int)kept.size();
+    s.median = Median(kept);
+    s.mad = Mad(kept, s.median);
+    s.min = kept.front();
+    s.max = kept.back();
+
+    // Ranks n/2 -+ 1.96*sqrt(n)/2 bracket the median with ~95% coverage for any distribution.
+    // Below six samples this widens to the full range, which is the honest answer.
+    double n = (double)kept.size(), half = 1.96 * std::sqrt(n) / 2.0;
+    int lo = (int)std::floor(n / 2.0 - half), hi = (int)std::ceil(1.0 + n / 2.0 + half);
+    lo = (std::max)(lo, 1);
+    hi = (std::min)(hi, (int)kept.size());
+    s.ciLow = kept[lo - 1];
+    s.ciHigh = kept[hi - 1];
+    return s;
+}
+
+BenchSummary RunRepeated(const BenchHarnessConfig& cfg, const std::function<double()>& run,
+    const std::function<void(int, int)>& progress) {
+    int warmup = (std::max)(cfg.warmup, 0), reps = (std::max)(cfg.repetitions, 1);
+    std::vector<double> samples;
+    for (int i = 0; i < warmup + reps; i++) {
+        double score = run();
+        if (i >= warmup) samples.push_back(score);
+        if (progress) progress(i + 1, warmup + reps);
+    }
+    return SummarizeSamples(samples, cfg.outlierCutoff);
+}
+
+std::string BenchBuildString() {
+    char buf[128];
+#if defined(_MSC_VER)
+    snprintf(buf, sizeof(buf), "msvc %d, %s", _MSC_FULL_VER, __DATE__);
+#elif defined(__clang__)
+    snprintf(buf, sizeof(buf), "clang %d.%d.%d, %s", __clang_major__, __clang_minor__, __clang_patchlevel__, __DATE__);
+#elif defined(__GNUC__)
+    snprintf(buf, sizeof(buf), "gcc %d.%d.%d, %s", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__, __DATE__);
+#else
+    snprintf(buf, sizeof(buf), "unknown, %s", __DATE__);
+#endif
+    return buf;
+}
+
+// ---------------------------------------------------------
+//  JSON
+//  The writer emits one flat object plus number arrays; the baseline
+//  reader only needs the flat fields, so it looks them up by key
+//  instead of carrying a general parser.
+// ---------------------------------------------------------
+static void AppendString(std::string& out, const std::string& s) {
+    out += '"';
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') { out += '\\'; out += (char)c; }
+        else if (c < 0x20) { char esc[8]; snprintf(esc, sizeof(esc), "\\u%04x", c); out += esc; }
+        else out += (char)c;
+    }
+    out += '"';
+}
+
+static void AppendNumber(std::string& out, double v) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.6g", v);
+    out += buf;
+}
+
+std::string BenchRecordToJson(const BenchRecord& r) {
+    const BenchSummary& s = r.summary;
+    std::string j = "{\n";
+    auto key = [&j](const char* k) { j += "  \""; j += k; j += "\": "; };
+    auto str = [&](const char* k, const std::string& v) { key(k); AppendString(j, v); j += ",\n"; };
+    auto num = [&](const char* k, double v) { key(k); AppendNumber(j, v); j += ",\n"; };
+    auto integer = [&](const char* k, long long v) { key(k); j += std::to_string(v); j += ",\n"; };
+    auto temp = [&](const char* k, float v) { key(k); if (v < 0.0f) j += "null"; else AppendNumber(j, v); j += ",\n"; };
+
+    str("benchmark", r.benchmark);
+    str("version", r.version);
+    str("build", r.build);
+    str("cpu", r.cpuName);
+    str("kernel", r.kernel);
+    integer("threads", r.threads);
+    integer("timestamp_ms", (long long)r.timestampMs);
+    temp("temp_before_c", r.tempBefore);
+    temp("temp_after_c", r.tempAfter);
+    integer("warmup", r.config.warmup);
+    integer("repetitions", r.config.repetitions);
+    num("outlier_cutoff", r.config.outlierCutoff);
+    integer("work_per_run", (long long)r.workPerRun);
+    key("work_consistent"); j += r.workConsistent ? "true,\n" : "false,\n";
+    integer("kept", s.kept);
+    num("median", s.median);
+    num("mad", s.mad);
+    num("ci95_low", s.ciLow);
+    num("ci95_high", s.ciHigh);
+    num("min", s.min);
+    num("max", s.max);
+    num("last_pass_imbalance", r.lastPass.imbalance);
+    key("per_thread"); j += "[";
+    for (size_t i = 0; i < r.lastPass.perThread.size(); i++) {
+        const BenchThreadStats& t = r.lastPass.perThread[i];
+        j += i ? ",\n    {" : "\n    {";
+        j += "\"tiles\": " + std::to_string(t.tiles) + ", \"iterations\": " + std::to_string(t.iterations) + ", \"busy_ms\": ";
+        AppendNumber(j, t.busyMs);
+        j += ", \"idle_ms\": ";
+        AppendNumber(j, t.idleMs);
+        j += "}";
+    }
+    j += r.lastPass.perThread.empty() ? "],\n" : "\n  ],\n";
+    key("metrics"); j += "{";
+    for (size_t i = 0; i < r.metrics.size(); i++) {
+        j += i ? ", " : "";
+        AppendString(j, r.metrics[i].first);
+        j += ": ";
+        AppendNumber(j, r.metrics[i].second);
+    }
+    j += "},\n";
+    key("samples"); j += "[";
+    for (size_t i = 0; i < s.samples.size(); i++) { if (i) j += ", "; AppendNumber(j, s.samples[i]); }
+    j += "],\n";
+    key("rejected"); j += "[";
+    for (size_t i = 0; i < s.rejected.size(); i++) { if (i) j += ", "; j += s.rejected[i] ? "true" : "false"; }
+    j += "]\n}\n";
+    return j;
+}
+
+// Start of the value for a top-level "key", or npos
+static size_t FindValue(const std::string& json, const char* key) {
+    std::string quoted = std::string("\"") + key + "\"";
+    size_t at = json.find(quoted);
+    if (at == std::string::npos) return at;
+    at = json.find(':', at + quoted.size());
+    if (at == std::string::npos) return at;
+    return json.find_first_not_of(" \t\r\n", at + 1);
+}
+
+static bool ReadString(const std::string& json, const char* key, std::string& out) {
+    size_t at = FindValue(json, key);
+    if (at == std::string::npos || json[at] != '"') return false;
+    out.clear();
+    for (size_t i = at + 1; i < json.size(); i++) {
+        if (json[i] == '"') return true;
+        if (json[i] == '\\' && i + 1 < json.size()) i++;
+        out += json[i];
+    }
+    return false;
+}
+
+static bool ReadNumber(const std::string& json, const char* key, double& out) {
+    size_t at = FindValue(json, key);
+    if (at == std::string::npos) return false;
+    char* end = nullptr;
+    out = strtod(json.c_str() + at, &end);
+    return end != json.c_str() + at;
+}
+
+bool ParseBenchBaseline(const std::string& json, BenchBaseline& out) {
+    double threads = 0.0;
+    if (!ReadString(json, "benchmark", out.benchmark) || !ReadNumber(json, "median", out.median)) return false;
+    ReadString(json, "kernel", out.kernel);
+    if (ReadNumber(json, "threads", threads)) out.threads = (int)threads;
+    return out.median > 0.0;
+}
+
+BenchComparison CompareToBaseline(const BenchRecord& current, const BenchBaseline& baseline, double thresholdPct) {
+    BenchComparison c;
+    c.comparable = current.benchmark == baseline.benchmark && current.kernel == baseline.kernel && current.threads == baseline.threads;
+    // Another benchmark, kernel or thread count has its own scale; no verdict either way
+    if (!c.comparable || baseline.median <= 0.0) return c;
+    c.changePct = (current.summary.median - baseline.median) / baseline.median * 100.0;
+    c.regressed = c.changePct < -thresholdPct;
+    return c;
+}
+
+BenchRecord RunMandelHarness(const BenchHarnessConfig& cfg, const MandelKernelInfo& kernel, int threads,
+    const std::function<float()>& readTemp, const std::function<void(int, int)>& progress) {
+    BenchRecord r;
+    r.benchmark = "cpu.mandelbrot";
+    r.build = BenchBuildString();
+    r.kernel = kernel.name;
+    r.threads = (std::max)(threads, 1);
+    r.config = cfg;
+    r.tempBefore = readTemp ? readTemp() : -1.0f;
+
+    bool first = true;
+    r.summary = RunRepeated(cfg, [&]() {
+        TiledBenchResult pass = RunTiledBenchmark(r.threads, kernel.fn);
+        if (first) r.workPerRun = pass.iterations;
+        else if (pass.iterations != r.workPerRun) r.workConsistent = false;
+        first = false;
+        double score = pass.score;
+        r.lastPass = std::move(pass);
+        return score;
+    }, progress);
+
+    r.tempAfter = readTemp ? readTemp() : -1.0f;
+    r.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return r;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "MandelKernels.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Stamped into every record; release builds pass /DAPP_VERSION="x.y.z"
+#ifndef APP_VERSION
+#define APP_VERSION "dev"
+#endif
+
+// ---------------------------------------------------------
+//  BENCHMARK HARNESS
+//  Warmup runs are thrown away, then each measured repetition yields one
+//  score. Samples whose modified z-score (0.6745 * |x - median| / MAD)
+//  exceeds the cutoff are rejected, and the rest reduce to a median, its
+//  MAD and a distribution-free 95% interval from order statistics.
+//  Records serialise to one JSON object that doubles as a baseline.
+// ---------------------------------------------------------
+struct BenchHarnessConfig {
+    int warmup = 1;
+    int repetitions = 5;
+    double outlierCutoff = 3.5;     // 0 keeps every sample
+};
+
+struct BenchSummary {
+    std::vector<double> samples;    // Run order, rejected ones included
+    std::vector<bool> rejected;
+    int kept = 0;
+    double median = 0.0;
+    double mad = 0.0;               // Raw median absolute deviation of the kept samples
+    double ciLow = 0.0, ciHigh = 0.0;
+    double min = 0.0, max = 0.0;
+};
+
+BenchSummary SummarizeSamples(const std::vector<double>& samples, double outlierCutoff);
+
+// Calls 'run' for every warmup and measured pass; 'run' returns the pass's score.
+// 'progress' is told after each pass how many of the total are done.
+BenchSummary RunRepeated(const BenchHarnessConfig& cfg, const std::function<double()>& run,
+    const std::function<void(int done, int total)>& progress = nullptr);
+
+struct BenchRecord {
+    std::string benchmark;          // "cpu.mandelbrot", "gpu.fill"
+    std::string version = APP_VERSION;
+    std::string build;              // Compiler and build date, filled by BenchBuildString()
+    std::string cpuName;
+    std::string kernel;
+    int threads = 0;
+    float tempBefore = -1.0f;       // Celsius; negative when no sensor was readable
+    float tempAfter = -1.0f;
+    int64_t timestampMs = 0;        // Unix time at the end of the run
+    BenchHarnessConfig config;
+    uint64_t workPerRun = 0;        // Iterations per pass; a fixed domain makes this constant
+    bool workConsistent = true;     // False if any pass disagreed: a miscomputing CPU, not noise
+    BenchSummary summary;
+    TiledBenchResult lastPass;      // Per-thread timing of the final measured pass
+    std::vector<std::pair<std::string, double>> metrics;   // Extra named figures, written under "metrics"
+};
+
+std::string BenchBuildString();
+std::string BenchRecordToJson(const BenchRecord& r);
+
+// The fields of a stored record that a comparison needs
+struct BenchBaseline {
+    std::string benchmark;
+    std::string kernel;
+    int threads = 0;
+    double median = 0.0;
+};
+
+bool ParseBenchBaseline(const std::string& json, BenchBaseline& out);
+
+struct BenchComparison {
+    bool comparable = false;        // Same benchmark, kernel and thread count
+    double changePct = 0.0;         // Median against the baseline's; scores are higher-is-better. 0 unless comparable.
+    bool regressed = false;         // Comparable, and changePct fell below -thresholdPct
+};
+
+BenchComparison CompareToBaseline(const BenchRecord& current, const BenchBaseline& baseline, double thresholdPct);
+
+// The Mandelbrot benchmark under the harness. 'readTemp' returns Celsius or a negative value.
+BenchRecord RunMandelHarness(const BenchHarnessConfig& cfg, const MandelKernelInfo& kernel, int threads,
+    const std::function<float()>& readTemp, const std::function<void(int done, int total)>& progress = nullptr);
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+// ---------------------------------------------------------
+//  CORE CLOCKS
+//  APERF counts actual cycles and MPERF reference cycles, both only
+//  while the core is in C0. So APERF/MPERF scaled by the reference
+//  (TSC) rate is the clock the core really ran at while busy, with
+//  turbo and throttling included. That is the effective clock, not
+//  the P-state the OS asked for.
+// ---------------------------------------------------------
+struct CoreClockSample {
+    double seconds = 0.0;       // Monotonic time of the read
+    uint64_t tsc = 0;
+    uint64_t aperf = 0;
+    uint64_t mperf = 0;
+};
+
+struct CoreClock {
+    float mhz = 0.0f;           // Effective clock while in C0
+    float baseMhz = 0.0f;       // TSC rate: the nominal (base) clock on invariant-TSC parts
+    float busyPct = 0.0f;       // C0 residency
+};
+
+inline bool ComputeCoreClock(const CoreClockSample& prev, const CoreClockSample& cur, CoreClock& out) {
+    double dt = cur.seconds - prev.seconds;
+    uint64_t dTsc = cur.tsc - prev.tsc, dA = cur.aperf - prev.aperf, dM = cur.mperf - prev.mperf;
+    if (dt <= 0.0 || dTsc == 0) return false;
+    out.baseMhz = (float)(dTsc / dt / 1e6);
+    out.busyPct = (float)(100.0 * dM / dTsc);
+    out.mhz = dM ? (float)(out.baseMhz * ((double)dA / dM)) : 0.0f;
+    return true;
+}
+
+// Throttled: nearly fully busy yet clocked below base. A lightly loaded core
+// parked at a low P-state is saving power, not throttling.
+constexpr float THROTTLE_MIN_LOAD = 90.0f;
+constexpr float THROTTLE_CLOCK_RATIO = 0.95f;
+
+inline bool IsCoreThrottled(float loadPct, float mhz, float baseMhz) {
+    return baseMhz > 0.0f && mhz > 0.0f && loadPct >= THROTTLE_MIN_LOAD && mhz < baseMhz * THROTTLE_CLOCK_RATIO;
+}
@@ -0,0 +1,210 @@
+#include "CpuStress.hpp"
+#include "MandelKernels.hpp"
+#include "MemBench.hpp"
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define STRESS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define STRESS_TARGET(isa)
+#else
+#define STRESS_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+const char* StressProfileName(StressProfile p) {
+    static const char* names[] = { "fma", "integer", "cache", "mixed" };
+    return (int)p < (int)StressProfile::Count ? names[(int)p] : "?";
+}
+
+bool ParseStressProfile(const char* name, StressProfile& out) {
+    for (int i = 0; i < (int)StressProfile::Count; i++) {
+        if (strcmp(name, StressProfileName((StressProfile)i)) == 0) { out = (StressProfile)i; return true; }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------
+//  WORKLOADS
+//  Each call is one chunk of roughly 50-200 us. The FMA chains
+//  converge to 1.0 (x * (1 - 1e-7) + 1e-7), so they never reach
+//  denormals or infinities, which run slower and draw less power.
+// ---------------------------------------------------------
+static float volatile s_FloatSink;
+static uint64_t volatile s_IntSink;
+
+static const int FMA_ROUNDS = 50000;
+
+// Twelve named chains rather than an array, so every compiler keeps them
+// in registers; an array spills and the store-forward latency caps the rate
+#define STRESS_CHAINS(X, op) X(0, op) X(1, op) X(2, op) X(3, op) X(4, op) X(5, op) X(6, op) X(7, op) X(8, op) X(9, op) X(10, op) X(11, op)
+#define STRESS_DECL(k, set1) auto r##k = set1(1.0f + k * 0.01f);
+#define STRESS_STEP(k, fmadd) r##k = fmadd(r##k, m, a);
+#define STRESS_SUM(k, add) if (k) r0 = add(r0, r##k);
+#define STRESS_FMA_KERNEL(vec, set1, fmadd, add, store, lanes)                  \
+    const vec m = set1(0.9999999f), a = set1(1e-7f);                            \
+    STRESS_CHAINS(STRESS_DECL, set1)                                            \
+    for (int i = 0; i < FMA_ROUNDS; i++) { STRESS_CHAINS(STRESS_STEP, fmadd) }  \
+    STRESS_CHAINS(STRESS_SUM, add)                                              \
+    alignas(64) float out[lanes]; store(out, r0);                              \
+    s_FloatSink = out[0];                                                       \
+    return (uint64_t)FMA_ROUNDS * 12 * lanes * 2;
+
+#ifdef STRESS_X86
+STRESS_TARGET("avx512f")
+static uint64_t FmaAvx512() { STRESS_FMA_KERNEL(__m512, _mm512_set1_ps, _mm512_fmadd_ps, _mm512_add_ps, _mm512_store_ps, 16) }
+
+STRESS_TARGET("avx2,fma")
+static uint64_t FmaAvx2() { STRESS_FMA_KERNEL(__m256, _mm256_set1_ps, _mm256_fmadd_ps, _mm256_add_ps, _mm256_store_ps, 8) }
+
+// No FMA: a multiply and an add per step, which still keeps both FP ports busy
+static inline __m128 MulAdd128(__m128 x, __m128 y, __m128 z) { return _mm_add_ps(_mm_mul_ps(x, y), z); }
+static uint64_t FmaSse2() { STRESS_FMA_KERNEL(__m128, _mm_set1_ps, MulAdd128, _mm_add_ps, _mm_store_ps, 4) }
+#else
+static inline float SetScalar(float v) { return v; }
+static inline float MulAddScalar(float x, float y, float z) { return x * y + z; }
+static inline float AddScalar(float x, float y) { return x + y; }
+static inline void StoreScalar(float* out, float v) { out[0] = v; }
+static uint64_t FmaScalar() { STRESS_FMA_KERNEL(float, SetScalar, MulAddScalar, AddScalar, StoreScalar, 1) }
+#endif
+
+using FmaKernel = uint64_t(*)();
+
+static FmaKernel PickFma(const char** isa) {
+#ifdef STRESS_X86
+    const CpuFeatures& f = DetectCpuFeatures();
+    if (f.avx512f) { *isa = "avx512"; return FmaAvx512; }
+    if (f.avx2 && f.fma) { *isa = "avx2-fma"; return FmaAvx2; }
+    *isa = "sse2";
+    return FmaSse2;
+#else
+    *isa = "scalar";
+    return FmaScalar;
+#endif
+}
+
+// Divides, multiplies and two branches on random bits: the predictor is wrong half the time
+static uint64_t IntegerMix(uint64_t& state) {
+    const int rounds = 20000;
+    uint64_t x = state, acc = 0;
+    for (int i = 0; i < rounds; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        if (x & 1) acc += x * 0x9E3779B97F4A7C15ull;
+        else acc ^= x / ((x >> 40) | 3);
+        if (x & 0x100) acc = (acc << 3) | (acc >> 61);
+    }
+    state = x;
+    s_IntSink = acc;
+    return rounds;
+}
+
+// Random lines of a per-thread buffer; together the workers overflow the last-level cache
+static uint64_t CacheThrash(std::vector<uint64_t>& buffer, uint64_t& state) {
+    const int rounds = 20000;
+    const size_t lines = buffer.size() / 8;
+    uint64_t x = state;
+    for (int i = 0; i < rounds; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        uint64_t* line = &buffer[(x % lines) * 8];
+        line[0] += x;
+        line[4] ^= line[0];
+    }
+    state = x;
+    return rounds;
+}
+
+// ---------------------------------------------------------
+//  ENGINE
+// ---------------------------------------------------------
+// Sleeps to an absolute steady-clock time. Windows gets a high-resolution
+// waitable timer, because a plain sleep there rounds up to the 15.6 ms tick.
+static void IdleUntil(std::chrono::steady_clock::time_point until) {
+#ifdef _WIN32
+    static thread_local HANDLE timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    auto left = std::chrono::duration_cast<std::chrono::microseconds>(until - std::chrono::steady_clock::now()).count();
+    if (left <= 0) return;
+    if (timer) {
+        LARGE_INTEGER due; due.QuadPart = -left * 10;
+        SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE);
+        WaitForSingleObject(timer, INFINITE);
+        return;
+    }
+#endif
+    std::this_thread::sleep_until(until);
+}
+
+void CpuStressEngine::Worker(int index, int cpu) {
+    if (config.pin) PinCurrentThread(cpu);
+    const char* isa;
+    FmaKernel fma = PickFma(&isa);
+    uint64_t state = 0x9E3779B97F4A7C15ull * (uint64_t)(index + 1);
+    std::vector<uint64_t> buffer;
+    if (config.profile == StressProfile::CacheThrash || config.profile == StressProfile::Mixed) buffer.assign((size_t(8) << 20) / sizeof(uint64_t), 0);
+
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::milliseconds((std::max)(config.periodMs, 1));
+    while (!stop.load(std::memory_order_relaxed)) {
+        Clock::time_point now = Clock::now();
+        Clock::time_point periodStart = now - (now.time_since_epoch() % period);
+        if (now >= periodStart + period * duty.load(std::memory_order_relaxed) / 100) {
+            IdleUntil(periodStart + period);
+            continue;
+        }
+
+        StressProfile p = config.profile;
+        if (p == StressProfile::Mixed) {
+            // Workers are offset, so all three loads run at once and every core keeps switching
+            int64_t slice = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() / 10;
+            p = (StressProfile)((slice + index) % 3);
+        }
+        uint64_t units = 0;
+        switch (p) {
+        case StressProfile::FmaVirus: units = fma(); break;
+        case StressProfile::Integer: units = IntegerMix(state); break;
+        default: units = CacheThrash(buffer, state); break;
+        }
+        work[index].units.fetch_add(units, std::memory_order_relaxed);
+    }
+}
+
+void CpuStressEngine::Start(const CpuStressConfig& cfg) {
+    Stop();
+    config = cfg;
+    duty = (std::min)((std::max)(cfg.dutyPct, 0), 100);
+    std::vector<int> cpus;
+    for (const NumaNode& n : NumaTopology()) cpus.insert(cpus.end(), n.cpus.begin(), n.cpus.end());
+    int threads = cfg.threads > 0 ? (std::min)(cfg.threads, (int)cpus.size()) : (int)cpus.size();
+
+    stop = false;
+    work.reset(new WorkCounter[threads]);
+    for (int i = 0; i < threads; i++) workers.emplace_back(&CpuStressEngine::Worker, this, i, cpus[i]);
+}
+
+void CpuStressEngine::Stop() {
+    stop = true;
+    for (auto& t : workers) t.join();
+    workers.clear();
+}
+
+void CpuStressEngine::SetDuty(int pct) {
+    duty.store((std::min)((std::max)(pct, 0), 100), std::memory_order_relaxed);
+}
+
+const char* CpuStressEngine::FmaIsa() const {
+    const char* isa;
+    PickFma(&isa);
+    return isa;
+}
+
+uint64_t CpuStressEngine::Work() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < workers.size(); i++) total += work[i].units.load(std::memory_order_relaxed);
+    return total;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------
+//  CPU STRESS
+//  One pinned worker per logical processor runs the chosen workload
+//  in short chunks. Between chunks it checks the stop flag and the duty
+//  cycle. Every worker shares the same wall-clock period, so package
+//  power square-waves in step instead of averaging out. The engine owns
+//  its threads: Stop() joins them, and Start() on a running engine
+//  stops it first, so a restart never leaves stragglers.
+// ---------------------------------------------------------
+enum class StressProfile : uint8_t {
+    FmaVirus,       // Widest FMA the CPU has, enough chains to fill both ports
+    Integer,        // Multiplies, divides and unpredictable branches
+    CacheThrash,    // Random read-modify-write of lines in a buffer larger than L2
+    Mixed,          // Rotates through the three every 10 ms
+    Count
+};
+
+const char* StressProfileName(StressProfile p);     // "fma", "integer", "cache", "mixed"
+bool ParseStressProfile(const char* name, StressProfile& out);
+
+struct CpuStressConfig {
+    StressProfile profile = StressProfile::FmaVirus;
+    int threads = 0;            // 0 = every logical processor
+    int dutyPct = 100;          // Busy share of each period
+    int periodMs = 100;
+    bool pin = true;
+};
+
+class CpuStressEngine {
+public:
+    CpuStressEngine() = default;
+    ~CpuStressEngine() { Stop(); }
+    CpuStressEngine(const CpuStressEngine&) = delete;
+    CpuStressEngine& operator=(const CpuStressEngine&) = delete;
+
+    void Start(const CpuStressConfig& cfg);
+    void Stop();
+    bool Running() const { return !workers.empty(); }
+
+    // Takes effect from the next period
+    void SetDuty(int pct);
+    int Duty() const { return duty.load(std::memory_order_relaxed); }
+    const CpuStressConfig& Config() const { return config; }
+    // Instruction set the FMA workload runs on: "avx512", "avx2-fma" or "sse2"
+    const char* FmaIsa() const;
+    // Workload units completed by all workers; a steady rate shows nothing throttled
+    uint64_t Work() const;
+
+private:
+    void Worker(int index, int cpu);
+
+    CpuStressConfig config;
+    std::vector<std::thread> workers;
+    struct alignas(64) WorkCounter { std::atomic<uint64_t> units{ 0 }; };    // One line per worker
+    std::unique_ptr<WorkCounter[]> work;
+    std::atomic<bool> stop{ false };
+    std::atomic<int> duty{ 100 };
+};
@@ -0,0 +1,217 @@
+#include "FanControl.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+float FanCurve::Eval(float tempC) const {
+    if (count <= 0) return 100.0f;
+    if (tempC <= points[0].tempC) return points[0].pct;
+    for (int i = 1; i < count; i++) {
+        const FanCurvePoint& a = points[i - 1];
+        const FanCurvePoint& b = points[i];
+        if (tempC <= b.tempC) {
+            float span = b.tempC - a.tempC;
+            return span > 0.0f ? a.pct + (b.pct - a.pct) * (tempC - a.tempC) / span : b.pct;
+        }
+    }
+    return points[count - 1].pct;
+}
+
+bool ParseFanCurve(const char* text, FanCurve& out) {
+    FanCurve c;
+    const char* p = text;
+    while (*p) {
+        if (c.count == FAN_CURVE_POINTS) return false;
+        char* end;
+        float t = strtof(p, &end);
+        if (end == p || *end != ':') return false;
+        p = end + 1;
+        float pct = strtof(p, &end);
+        if (end == p || pct < 0.0f || pct > 100.0f) return false;
+        if (c.count && t <= c.points[c.count - 1].tempC) return false;
+        c.points[c.count++] = { t, pct };
+        p = end;
+        if (*p == ',') p++;
+        else if (*p) return false;
+    }
+    if (c.count == 0) return false;
+    out = c;
+    return true;
+}
+
+bool ParseFanChannel(const char* text, FanChannelConfig& out) {
+    FanChannelConfig cfg;
+    cfg.mode = FanMode::Curve;
+    bool haveCurve = false;
+    char word[160];
+    for (const char* p = text; *p;) {
+        while (*p == ' ') p++;
+        size_t len = strcspn(p, " ");
+        if (len == 0) break;
+        if (len >= sizeof(word)) return false;
+        memcpy(word, p, len); word[len] = 0;
+        p += len;
+
+        char* value = strchr(word, '=');
+        if (!value) return false;
+        *value++ = 0;
+        if (strcmp(word, "sensor") == 0) snprintf(cfg.sensor, sizeof(cfg.sensor), "%s", value);
+        else if (strcmp(word, "curve") == 0) { if (!ParseFanCurve(value, cfg.curve)) return false; haveCurve = true; }
+        else if (strcmp(word, "hyst") == 0) cfg.hysteresisC = (float)atof(value);
+        else if (strcmp(word, "up") == 0) cfg.rampUpPctPerSec = (float)atof(value);
+        else if (strcmp(word, "down") == 0) cfg.rampDownPctPerSec = (float)atof(value);
+        else if (strcmp(word, "min") == 0) cfg.minPct = atoi(value);
+        else if (strcmp(word, "manual") == 0) { cfg.mode = FanMode::Manual; cfg.manualPct = atoi(value); }
+        else return false;
+    }
+    if (cfg.mode == FanMode::Curve && (!haveCurve || !cfg.sensor[0])) return false;
+    out = cfg;
+    return true;
+}
+
+FanChannelConfig DefaultFanProfile(int channel) {
+    FanChannelConfig cfg;
+    if (channel == 0) ParseFanChannel("sensor=nct.cpu_temp curve=40:25,60:45,75:75,85:100", cfg);
+    else ParseFanChannel("sensor=nct.vrm_temp curve=45:25,70:50,90:100", cfg);
+    return cfg;
+}
+
+void StepFanChannel(const FanChannelConfig& cfg, FanChannelState& state, float tempC, float dtSec) {
+    if (cfg.mode == FanMode::Manual) {
+        // The slider is direct: whoever drags it wants to hear the result now
+        state.target = (float)(std::clamp)(cfg.manualPct, 0, 100);
+        state.output = state.target;
+        state.sensorOk = true;
+        return;
+    }
+
+    state.sensorOk = !std::isnan(tempC);
+    if (!state.sensorOk) {
+        state.target = cfg.curve.count ? cfg.curve.points[cfg.curve.count - 1].pct : 100.0f;
+        state.holdTempC = 1000.0f;     // Any real reading afterwards counts as a drop
+    }
+    else {
+        float desired = cfg.curve.Eval(tempC);
+        if (state.output < 0.0f || desired >= state.target) { state.target = desired; state.holdTempC = tempC; }
+        else if (tempC <= state.holdTempC - cfg.hysteresisC) { state.target = desired; state.holdTempC = tempC; }
+    }
+    state.target = (std::max)(state.target, (float)cfg.minPct);
+
+    if (state.output < 0.0f) { state.output = state.target; return; }
+    float step = state.target - state.output;
+    float up = cfg.rampUpPctPerSec * dtSec, down = cfg.rampDownPctPerSec * dtSec;
+    state.output += (std::clamp)(step, -down, up);
+}
+
+// ---------------------------------------------------------
+//  CONTROLLER
+// ---------------------------------------------------------
+FanController::FanController() {
+    for (int i = 0; i < FAN_MAX_CHANNELS; i++) { sensorIds[i] = -1; outputPct[i] = -1; }
+}
+
+bool FanController::Start(const SensorHub& hub, IFanWriter& writer, int periodMs) {
+    if (thread.joinable()) return false;
+    Attach(hub, writer);
+    stop = false;
+    thread = std::thread(&FanController::Run, this, periodMs);
+    return true;
+}
+
+void FanController::Stop() {
+    if (!thread.joinable()) return;
+    { std::lock_guard<std::mutex> lock(mutex); stop = true; }
+    wake.notify_one();
+    thread.join();
+}
+
+void FanController::SetChannel(int channel, const FanChannelConfig& cfg) {
+    if (channel < 0 || channel >= FAN_MAX_CHANNELS) return;
+    { std::lock_guard<std::mutex> lock(mutex); configs[channel] = cfg; dirty = true; }
+    wake.notify_one();
+}
+
+FanChannelConfig FanController::Channel(int channel) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return configs[channel];
+}
+
+void FanController::SetManualAll(int pct) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& c : configs) { c.mode = FanMode::Manual; c.manualPct = pct; }
+        dirty = true;
+    }
+    wake.notify_one();
+}
+
+void FanController::SetAutoAll() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < FAN_MAX_CHANNELS; i++) configs[i] = DefaultFanProfile(i);
+        dirty = true;
+    }
+    wake.notify_one();
+}
+
+void FanController::Run(int periodMs) {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point last = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stop) {
+        // Slider drags arriving while a batch is being written collapse into the next one
+        wake.wait_for(lock, std::chrono::milliseconds(periodMs), [this]() { return stop || dirty; });
+        if (stop) break;
+        dirty = false;
+        lock.unlock();
+        Clock::time_point now = Clock::now();
+        Tick(std::chrono::duration<float>(now - last).count());
+        last = now;
+        lock.lock();
+    }
+}
+
+int FanController::ResolveSensor(int channel, const char* name) {
+    if (sensorIds[channel] >= 0 && strcmp(sensorNames[channel], name) == 0) return sensorIds[channel];
+    // Providers register lazily (the board sweep starts once the chip is found), so keep looking
+    sensorIds[channel] = -1;
+    snprintf(sensorNames[channel], sizeof(sensorNames[channel]), "%s", name);
+    for (int id = 0; id < hub->SensorCount(); id++) {
+        if (strcmp(hub->Sensor(id).name, name) == 0) { sensorIds[channel] = id; break; }
+    }
+    return sensorIds[channel];
+}
+
+void FanController::Tick(float dtSec) {
+    if (!hub || !writer) return;
+    int count = (std::min)(writer->ChannelCount(), FAN_MAX_CHANNELS);
+    FanChannelConfig cfg[FAN_MAX_CHANNELS];
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::copy(configs, configs + count, cfg);
+    }
+
+    uint8_t pwm[FAN_MAX_CHANNELS] = {};
+    uint32_t mask = 0;
+    for (int i = 0; i < count; i++) {
+        float temp = NAN;
+        if (cfg[i].mode == FanMode::Curve) {
+            int id = ResolveSensor(i, cfg[i].sensor);
+            float v = id >= 0 ? hub->Value(id) : NAN;
+            if (v > 0.0f && v < 150.0f) temp = v;     // 0 = not polled yet; chips report 255 or -128 for open probes
+        }
+        StepFanChannel(cfg[i], states[i], temp, dtSec);
+        pwm[i] = (uint8_t)std::lround(states[i].output * 2.55f);
+        outputPct[i].store((int)std::lround(states[i].output), std::memory_order_relaxed);
+        if (!(writtenMask & (1u << i)) || pwm[i] != written[i]) mask |= 1u << i;
+    }
+    if (!mask || !writer->WritePwm(mask, pwm)) return;
+    for (int i = 0; i < count; i++) if (mask & (1u << i)) written[i] = pwm[i];
+    writtenMask |= mask;
+    batches.fetch_add(1, std::memory_order_relaxed);
+    channelWrites.fetch_add(std::popcount(mask), std::memory_order_relaxed);
+}
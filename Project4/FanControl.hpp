@@ -0,0 +1,122 @@
+#pragma once
+#include "SensorProvider.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// ---------------------------------------------------------
+//  FAN CONTROL
+//  Each fan header follows either a fixed duty (the overlay slider)
+//  or a temperature curve driven by any hub sensor. A curve target
+//  rises as soon as the temperature does, but only falls once the
+//  temperature has dropped 'hysteresisC' below the reading that set
+//  it, and the output slews toward the target at a limited rate.
+//  All of this runs on the controller's own thread; the EC is only
+//  touched for channels whose PWM byte changed, in one batch.
+// ---------------------------------------------------------
+constexpr int FAN_MAX_CHANNELS = 8;
+constexpr int FAN_CURVE_POINTS = 8;
+
+struct FanCurvePoint {
+    float tempC = 0.0f;
+    float pct = 0.0f;
+};
+
+// Piecewise linear, flat beyond the end points. Points are sorted by temperature.
+struct FanCurve {
+    FanCurvePoint points[FAN_CURVE_POINTS];
+    int count = 0;
+    float Eval(float tempC) const;
+};
+
+enum class FanMode { Manual, Curve };
+
+struct FanChannelConfig {
+    FanMode mode = FanMode::Manual;
+    int manualPct = 50;
+    char sensor[48] = {};           // Hub sensor name, e.g. "nct.cpu_temp"
+    FanCurve curve;
+    float hysteresisC = 3.0f;
+    float rampUpPctPerSec = 15.0f;
+    float rampDownPctPerSec = 5.0f;
+    int minPct = 20;                // Never stall a fan from the curve
+};
+
+// "30:25,60:50,80:100" -> curve points
+bool ParseFanCurve(const char* text, FanCurve& out);
+// "sensor=nct.vrm_temp curve=40:30,70:60,85:100 hyst=3 up=15 down=5 min=20", or "manual=60"
+bool ParseFanChannel(const char* text, FanChannelConfig& out);
+// CPU fan on the CPU temperature, the rest on the VRM: the profile the overlay's Auto mode uses
+FanChannelConfig DefaultFanProfile(int channel);
+
+struct FanChannelState {
+    float output = -1.0f;           // Commanded percent; -1 until the first step
+    float target = 0.0f;
+    float holdTempC = 0.0f;         // Reading that set 'target'
+    bool sensorOk = false;
+};
+
+// One control step. 'tempC' is ignored in manual mode; a missing or implausible
+// reading (NaN) drives the curve's top point, so a lost sensor fails loud, not hot.
+void StepFanChannel(const FanChannelConfig& cfg, FanChannelState& state, float tempC, float dtSec);
+
+// Batched PWM output. 'mask' bit i set = pwm[i] (0-255) is new for channel i.
+class IFanWriter {
+public:
+    virtual ~IFanWriter() = default;
+    virtual int ChannelCount() const = 0;
+    virtual bool WritePwm(uint32_t mask, const uint8_t* pwm) = 0;
+};
+
+class FanController {
+public:
+    FanController();
+    ~FanController() { Stop(); }
+    FanController(const FanController&) = delete;
+    FanController& operator=(const FanController&) = delete;
+
+    // The thread ticks every 'periodMs', and at once after a config change
+    bool Start(const SensorHub& hub, IFanWriter& writer, int periodMs = 250);
+    void Stop();
+    bool Running() const { return thread.joinable(); }
+
+    void SetChannel(int channel, const FanChannelConfig& cfg);
+    FanChannelConfig Channel(int channel) const;
+    // The slider: every channel to a fixed duty
+    void SetManualAll(int pct);
+    // Every channel to DefaultFanProfile
+    void SetAutoAll();
+
+    // One control pass: read temperatures, step, write what changed. The thread
+    // calls this; a simulation can drive it directly with its own clock instead.
+    void Tick(float dtSec);
+    void Attach(const SensorHub& hub, IFanWriter& writer) { this->hub = &hub; this->writer = &writer; }
+
+    int OutputPct(int channel) const { return outputPct[channel].load(std::memory_order_relaxed); }
+    uint64_t Batches() const { return batches.load(std::memory_order_relaxed); }
+    uint64_t ChannelWrites() const { return channelWrites.load(std::memory_order_relaxed); }
+
+private:
+    void Run(int periodMs);
+    int ResolveSensor(int channel, const char* name);
+
+    const SensorHub* hub = nullptr;
+    IFanWriter* writer = nullptr;
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    bool stop = false;
+    bool dirty = false;
+    FanChannelConfig configs[FAN_MAX_CHANNELS];
+
+    // Controller thread only
+    FanChannelState states[FAN_MAX_CHANNELS];
+    int sensorIds[FAN_MAX_CHANNELS];
+    char sensorNames[FAN_MAX_CHANNELS][48] = {};
+    uint8_t written[FAN_MAX_CHANNELS] = {};
+    uint32_t writtenMask = 0;       // Channels with a known PWM on the chip
+
+    std::atomic<int> outputPct[FAN_MAX_CHANNELS];
+    std::atomic<uint64_t> batches{ 0 }, channelWrites{ 0 };
+};
@@ -0,0 +1,139 @@
+#include "GlyphAtlas.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Column-major, bit 0 is the top row
+static const uint8_t g_Font5x7[][5] = {
+    {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14}, // space ! " #
+    {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00}, // $ % & '
+    {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x08,0x2A,0x1C,0x2A,0x08}, {0x08,0x08,0x3E,0x08,0x08}, // ( ) * +
+    {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02}, // , - . /
+    {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31}, // 0 1 2 3
+    {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03}, // 4 5 6 7
+    {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00}, // 8 9 : ;
+    {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06}, // < = > ?
+    {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22}, // @ A B C
+    {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A}, // D E F G
+    {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41}, // H I J K
+    {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E}, // L M N O
+    {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31}, // P Q R S
+    {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F}, // T U V W
+    {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00}, // X Y Z [
+    {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40}, // \ ] ^ _
+    {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20}, // ` a b c
+    {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E}, // d e f g
+    {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00}, // h i j k
+    {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38}, // l m n o
+    {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20}, // p q r s
+    {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C}, // t u v w
+    {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00}, // x y z {
+    {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x08,0x04,0x08,0x10,0x08},                              // | } ~
+    {0x00,0x06,0x09,0x09,0x06}, {0x00,0x1C,0x1C,0x1C,0x00},                                                          // degree, bullet
+};
+
+// Source cell scale per UiFont, picked to match the GDI+ point sizes at 96 DPI
+static const float g_FontScale[] = { 1.75f, 1.5f, 1.25f };    // Header (bold), Body, Small
+static const int ATLAS_WIDTH = 512;
+static std::unique_ptr<GlyphAtlas> g_InstalledAtlas;
+
+int GlyphAtlas::Index(wchar_t ch) {
+    if (ch >= 0x20 && ch <= 0x7E) return ch - 0x20;
+    if (ch == 0x00B0) return 95;
+    if (ch == 0x2022) return 96;
+    return '?' - 0x20;
+}
+
+wchar_t GlyphAtlas::Char(int index) {
+    if (index == 95) return 0x00B0;
+    if (index == 96) return 0x2022;
+    return (wchar_t)(0x20 + index);
+}
+
+static bool SourceBit(int index, bool bold, int col, int row) {
+    if (row < 0 || row >= 7) return false;
+    auto lit = [&](int c) { return c >= 0 && c < 5 && (g_Font5x7[index][c] >> row) & 1; };
+    return lit(col) || (bold && lit(col - 1));  // Bold smears one column to the right
+}
+
+GlyphRasterizer GlyphAtlas::BuiltinFace() {
+    return [](UiFont font, wchar_t ch, GlyphBitmap& out) {
+        const int SS = 4;   // Supersamples per axis for the box filter
+        float s = g_FontScale[(int)font];
+        bool bold = font == UiFont::Header;
+        int index = Index(ch);
+        out.w = (int)std::ceil((bold ? 6 : 5) * s);
+        out.h = (int)std::ceil(7 * s);
+        out.left = 0;
+        out.top = (int)std::lround((UiLineHeight(font) - out.h) * 0.4f);
+        out.advance = (int)std::lround((bold ? 7 : 6) * s);
+        out.coverage.assign((size_t)out.w * out.h, 0);
+        for (int y = 0; y < out.h; y++) {
+            for (int x = 0; x < out.w; x++) {
+                int hits = 0;
+                for (int sy = 0; sy < SS; sy++) {
+                    for (int sx = 0; sx < SS; sx++) {
+                        float u = (x + (sx + 0.5f) / SS) / s, v = (y + (sy + 0.5f) / SS) / s;
+                        hits += SourceBit(index, bold, (int)u, (int)v);
+                    }
+                }
+                out.coverage[(size_t)y * out.w + x] = (uint8_t)(hits * 255 / (SS * SS));
+            }
+        }
+    };
+}
+
+GlyphAtlas::GlyphAtlas(const GlyphRasterizer& rasterize) {
+    std::vector<GlyphBitmap> bitmaps((size_t)UiFont::Count * GLYPHS);
+    int penX = 0, penY = 0, rowH = 0;
+    for (int f = 0; f < (int)UiFont::Count; f++) {
+        GlyphBitmap* row = &bitmaps[(size_t)f * GLYPHS];
+        for (int i = 0; i < GLYPHS; i++) rasterize((UiFont)f, Char(i), row[i]);
+
+        // Tabular digits: widest advance for all ten, each glyph centred in it
+        int digitAdvance = 0;
+        for (int d = 0; d < 10; d++) digitAdvance = (std::max)(digitAdvance, row[Index(L'0' + d)].advance);
+        for (int d = 0; d < 10; d++) {
+            GlyphBitmap& b = row[Index(L'0' + d)];
+            b.left += (digitAdvance - b.advance) / 2;
+            b.advance = digitAdvance;
+        }
+
+        for (int i = 0; i < GLYPHS; i++) {
+            const GlyphBitmap& b = row[i];
+            if (penX + b.w > ATLAS_WIDTH) { penX = 0; penY += rowH + 1; rowH = 0; }
+            GlyphInfo& g = glyphs[f][i];
+            g.x = (uint16_t)penX; g.y = (uint16_t)penY;
+            g.w = (uint8_t)b.w; g.h = (uint8_t)b.h;
+            g.left = (int8_t)b.left; g.top = (int8_t)b.top;
+            g.advance = (uint8_t)b.advance;
+            penX += b.w + 1;    // One empty column so filtering never bleeds between glyphs
+            rowH = (std::max)(rowH, b.h);
+        }
+    }
+    width = ATLAS_WIDTH;
+    height = penY + rowH;
+    pixels.assign((size_t)width * height, 0);
+    for (int f = 0; f < (int)UiFont::Count; f++) {
+        for (int i = 0; i < GLYPHS; i++) {
+            const GlyphBitmap& b = bitmaps[(size_t)f * GLYPHS + i];
+            const GlyphInfo& g = glyphs[f][i];
+            for (int y = 0; y < b.h; y++) std::copy_n(&b.coverage[(size_t)y * b.w], b.w, &pixels[(size_t)(g.y + y) * width + g.x]);
+        }
+    }
+}
+
+const GlyphAtlas& GlyphAtlas::Get() {
+    if (g_InstalledAtlas) return *g_InstalledAtlas;
+    static const GlyphAtlas builtin(BuiltinFace());
+    return builtin;
+}
+
+void GlyphAtlas::Install(std::unique_ptr<GlyphAtlas> atlas) {
+    g_InstalledAtlas = std::move(atlas);
+}
+
+int GlyphAtlas::Measure(UiFont font, const wchar_t* text) const {
+    int w = 0;
+    for (; *text; text++) w += Glyph(font, *text).advance;
+    return w;
+}
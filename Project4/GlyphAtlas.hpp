@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "UiTree.hpp"
+
+// ---------------------------------------------------------
+//  GLYPH ATLAS
+//  Every glyph the overlay can print, pre-rasterized per UiFont into
+//  one 8-bit coverage texture: printable ASCII plus the degree sign
+//  and bullet. Glyphs come from a rasterizer callback. The built-in
+//  5x7 face needs no font files (headless); the desktop installs one
+//  backed by Segoe UI. Digits always share one advance (tabular), so
+//  a changing number never moves the text after it.
+// ---------------------------------------------------------
+struct GlyphBitmap {
+    int w = 0, h = 0;
+    int left = 0, top = 0;  // Bitmap offset from the pen position / top of the line box
+    int advance = 0;
+    std::vector<uint8_t> coverage;  // w * h, row-major
+};
+
+using GlyphRasterizer = std::function<void(UiFont font, wchar_t ch, GlyphBitmap& out)>;
+
+struct GlyphInfo {
+    uint16_t x, y;      // Top-left in the atlas
+    uint8_t w, h;
+    int8_t left, top;
+    uint8_t advance;
+};
+
+class GlyphAtlas {
+public:
+    explicit GlyphAtlas(const GlyphRasterizer& rasterize);
+
+    // The installed atlas, or the built-in face on first use
+    static const GlyphAtlas& Get();
+    // Call before the first frame; the render thread reads it without locking
+    static void Install(std::unique_ptr<GlyphAtlas> atlas);
+    static GlyphRasterizer BuiltinFace();
+
+    static int Index(wchar_t ch);
+    static wchar_t Char(int index);
+    static constexpr int GLYPHS = 97;   // 0x20..0x7E, degree, bullet
+
+    const GlyphInfo& Glyph(UiFont font, wchar_t ch) const { return glyphs[(int)font][Index(ch)]; }
+    int Measure(UiFont font, const wchar_t* text) const;
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    const uint8_t* Row(int y) const { return pixels.data() + (size_t)y * width; }
+
+private:
+    GlyphInfo glyphs[(int)UiFont::Count][GLYPHS] = {};
+    int width = 0, height = 0;
+    std::vector<uint8_t> pixels;
+};
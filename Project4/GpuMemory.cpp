@@ -0,0 +1,44 @@
+#include "GpuMemory.hpp"
+#include <cwchar>
+
+bool GpuMonitor::Refresh() {
+    GpuAdapterInfo infos[MAX_GPUS];
+    int count = backend.EnumerateAdapters(infos, MAX_GPUS);
+    enumerations++;
+    enumerated = true;
+
+    // Same count is not enough: one adapter may have been swapped for another. A slot that
+    // still holds the same adapter keeps its usage, so re-enumerating alone is not a change.
+    bool changed = (count != adapterCount);
+    for (int i = 0; i < count; i++) {
+        bool same = i < adapterCount && wcscmp(adapters[i].info.name, infos[i].name) == 0 &&
+            adapters[i].info.dedicatedBytes == infos[i].dedicatedBytes;
+        if (same) continue;
+        changed = true;
+        adapters[i].info = infos[i];
+        adapters[i].usage = GpuMemoryUsage();
+    }
+    adapterCount = count;
+    return changed;
+}
+
+PollResult GpuMonitor::Poll() {
+    bool changed = false;
+    if (!enumerated || backend.NeedsRefresh()) changed = Refresh();
+
+    for (int i = 0; i < adapterCount; i++) {
+        GpuMemoryUsage usage;
+        if (!backend.QueryMemory(i, usage)) {
+            // Adapter went away under us: rebuild the list next poll
+            enumerated = false;
+            return PollResult::Changed;
+        }
+        GpuAdapterState& a = adapters[i];
+        uint64_t total = a.info.dedicatedBytes ? a.info.dedicatedBytes : usage.budgetBytes;
+        uint64_t prev = a.usage.usedBytes;
+        uint64_t delta = usage.usedBytes > prev ? usage.usedBytes - prev : prev - usage.usedBytes;
+        if (total && delta * 100 >= total) changed = true;
+        a.usage = usage;
+    }
+    return changed ? PollResult::Changed : PollResult::Stable;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "PollScheduler.hpp"
+#include <cstdint>
+
+// ---------------------------------------------------------
+//  GPU MEMORY MONITOR
+//  Adapters are enumerated once and cached; each poll only asks the
+//  backend for the current usage. The backend is an interface so the
+//  caching and multi-adapter logic doesn't depend on DXGI.
+// ---------------------------------------------------------
+constexpr int MAX_GPUS = 4;
+
+struct GpuAdapterInfo {
+    wchar_t name[64] = {};
+    uint64_t dedicatedBytes = 0;
+};
+
+struct GpuMemoryUsage {
+    uint64_t usedBytes = 0;
+    uint64_t budgetBytes = 0;
+};
+
+class IGpuBackend {
+public:
+    virtual ~IGpuBackend() = default;
+    // Expensive: (re)builds the adapter list. Returns the number written.
+    virtual int EnumerateAdapters(GpuAdapterInfo* out, int max) = 0;
+    // True once the adapter list is stale (hot-plug, driver reset)
+    virtual bool NeedsRefresh() = 0;
+    // Cheap: current usage of a cached adapter
+    virtual bool QueryMemory(int adapter, GpuMemoryUsage& out) = 0;
+};
+
+struct GpuAdapterState {
+    GpuAdapterInfo info;
+    GpuMemoryUsage usage;
+};
+
+class GpuMonitor {
+public:
+    explicit GpuMonitor(IGpuBackend& backend) : backend(backend) {}
+
+    // Changed when an adapter appeared/disappeared or usage moved by >= 1%
+    PollResult Poll();
+
+    int AdapterCount() const { return adapterCount; }
+    const GpuAdapterState& Adapter(int i) const { return adapters[i]; }
+    int EnumerationCount() const { return enumerations; }
+
+private:
+    bool Refresh();
+
+    IGpuBackend& backend;
+    GpuAdapterState adapters[MAX_GPUS];
+    int adapterCount = 0;
+    int enumerations = 0;
+    bool enumerated = false;
+};
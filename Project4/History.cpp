@@ -0,0 +1,143 @@
+#include "History.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SensorHistory::SensorHistory(int sensorCapacity) : sensorCapacity(sensorCapacity) {
+    for (int t = 0; t < HISTORY_TIER_COUNT; t++) {
+        Tier& tier = tiers[t];
+        tier.periodSec = HISTORY_TIERS[t].periodSec;
+        tier.capacity = HISTORY_TIERS[t].capacity;
+        size_t cells = (size_t)sensorCapacity * tier.capacity;
+        tier.time.assign(tier.capacity, 0);
+        tier.min.assign(cells, NAN);
+        tier.max.assign(cells, NAN);
+        tier.avg.assign(cells, NAN);
+        tier.accMin.assign(sensorCapacity, 0.0f);
+        tier.accMax.assign(sensorCapacity, 0.0f);
+        tier.accSum.assign(sensorCapacity, 0.0f);
+        tier.accCount.assign(sensorCapacity, 0);
+    }
+}
+
+size_t SensorHistory::FootprintBytes() const {
+    size_t bytes = 0;
+    for (const Tier& t : tiers) {
+        bytes += t.time.size() * sizeof(int64_t);
+        bytes += (t.min.size() + t.max.size() + t.avg.size()) * sizeof(float);
+        bytes += (t.accMin.size() + t.accMax.size() + t.accSum.size()) * sizeof(float);
+        bytes += t.accCount.size() * sizeof(int);
+    }
+    return bytes;
+}
+
+void SensorHistory::Record(int64_t timeSec, const float* values, int count) {
+    std::lock_guard<std::mutex> l(mutex);
+    count = (std::min)(count, sensorCapacity);
+    int64_t start = timeSec - timeSec % tiers[0].periodSec;
+    Accumulate(0, start, values, values, values, count);
+}
+
+void SensorHistory::Accumulate(int t, int64_t bucketStart, const float* mins, const float* maxs, const float* avgs, int count) {
+    Tier& tier = tiers[t];
+    if (tier.openCount > 0 && bucketStart != tier.openStart) Close(t);
+
+    if (tier.openCount == 0) {
+        tier.openStart = bucketStart;
+        std::fill(tier.accMin.begin(), tier.accMin.end(), std::numeric_limits<float>::infinity());
+        std::fill(tier.accMax.begin(), tier.accMax.end(), -std::numeric_limits<float>::infinity());
+        std::fill(tier.accSum.begin(), tier.accSum.end(), 0.0f);
+        std::fill(tier.accCount.begin(), tier.accCount.end(), 0);
+    }
+    for (int s = 0; s < count; s++) {
+        // A sensor with no reading (or a bucket that had none) must not poison the sum
+        if (std::isnan(avgs[s])) continue;
+        tier.accCount[s]++;
+        tier.accMin[s] = (std::min)(tier.accMin[s], mins[s]);
+        tier.accMax[s] = (std::max)(tier.accMax[s], maxs[s]);
+        tier.accSum[s] += avgs[s];
+    }
+    tier.openCount++;
+}
+
+void SensorHistory::Close(int t) {
+    Tier& tier = tiers[t];
+    int i = tier.head;
+    tier.time[i] = tier.openStart;
+    // Turn the running sums into averages in place; the next tier consumes them from here
+    for (int s = 0; s < sensorCapacity; s++) {
+        bool fed = tier.accCount[s] > 0;
+        tier.accSum[s] = fed ? tier.accSum[s] / tier.accCount[s] : NAN;
+        size_t cell = (size_t)s * tier.capacity + i;
+        tier.min[cell] = fed ? tier.accMin[s] : NAN;
+        tier.max[cell] = fed ? tier.accMax[s] : NAN;
+        tier.avg[cell] = tier.accSum[s];
+    }
+    tier.head = (tier.head + 1) % tier.capacity;
+    tier.filled = (std::min)(tier.filled + 1, tier.capacity);
+
+    if (t + 1 < HISTORY_TIER_COUNT) {
+        int64_t period = tiers[t + 1].periodSec;
+        int64_t start = tier.openStart - tier.openStart % period;
+        Accumulate(t + 1, start, tier.accMin.data(), tier.accMax.data(), tier.accSum.data(), sensorCapacity);
+    }
+    tier.openCount = 0;
+}
+
+int SensorHistory::Query(int slot, int t, int64_t from, int64_t to, HistoryPoint* out, int maxOut) const {
+    std::lock_guard<std::mutex> l(mutex);
+    if (slot < 0 || slot >= sensorCapacity || t < 0 || t >= HISTORY_TIER_COUNT) return 0;
+    const Tier& tier = tiers[t];
+    int oldest = (tier.head - tier.filled + tier.capacity) % tier.capacity;
+    auto physical = [&](int logical) { return (oldest + logical) % tier.capacity; };
+
+    // Bucket times are monotonic in logical order: binary search the first one >= from
+    int lo = 0, hi = tier.filled;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (tier.time[physical(mid)] < from) lo = mid + 1; else hi = mid;
+    }
+
+    int n = 0;
+    const size_t base = (size_t)slot * tier.capacity;
+    for (int k = lo; k < tier.filled && n < maxOut; k++) {
+        int i = physical(k);
+        if (tier.time[i] > to) break;
+        out[n++] = { tier.time[i], tier.min[base + i], tier.max[base + i], tier.avg[base + i] };
+    }
+    return n;
+}
+
+int SensorHistory::BestTier(int64_t from, int64_t to, int maxPoints, int64_t now) const {
+    for (int t = 0; t < HISTORY_TIER_COUNT; t++) {
+        const HistoryTierSpec& spec = HISTORY_TIERS[t];
+        bool covers = from >= now - (int64_t)spec.periodSec * spec.capacity;
+        bool fits = (to - from) / spec.periodSec <= maxPoints;
+        if (covers && fits) return t;
+    }
+    return HISTORY_TIER_COUNT - 1;
+}
+
+void SensorHistory::WriteCsv(std::ostream& os, int t, int64_t from, int64_t to, const char* const* names, int count) const {
+    count = (std::min)(count, sensorCapacity);
+    os << "time";
+    for (int s = 0; s < count; s++) os << "," << names[s] << ".min," << names[s] << ".max," << names[s] << ".avg";
+    os << "\n";
+
+    if (count <= 0) return;
+    const int CHUNK = 1024;
+    std::vector<std::vector<HistoryPoint>> cols(count, std::vector<HistoryPoint>(CHUNK));
+    for (int64_t cursor = from;;) {
+        // A bucket may close between per-slot queries; only emit rows every slot has
+        int rows = CHUNK;
+        for (int s = 0; s < count; s++) rows = (std::min)(rows, Query(s, t, cursor, to, cols[s].data(), CHUNK));
+        if (rows == 0) break;
+        for (int r = 0; r < rows; r++) {
+            os << cols[0][r].time;
+            for (int s = 0; s < count; s++) os << "," << cols[s][r].min << "," << cols[s][r].max << "," << cols[s][r].avg;
+            os << "\n";
+        }
+        cursor = cols[0][rows - 1].time + 1;
+        if (rows < CHUNK) break;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// ---------------------------------------------------------
+//  SENSOR HISTORY
+//  Fixed-footprint ring buffers per sensor at several resolutions.
+//  Raw samples accumulate into the finest tier's open bucket; every
+//  closed bucket rolls its min/max/avg up into the next tier, so
+//  nothing is allocated after construction.
+//  Storage is SoA and sensor-major: one sensor's buckets for one tier
+//  are contiguous, which is what sparklines and exports scan.
+// ---------------------------------------------------------
+struct HistoryTierSpec {
+    int periodSec;
+    int capacity;
+};
+
+// 1 s for 10 min, 10 s for 24 h, 1 min for 30 days
+constexpr HistoryTierSpec HISTORY_TIERS[] = { { 1, 600 }, { 10, 8640 }, { 60, 43200 } };
+constexpr int HISTORY_TIER_COUNT = (int)(sizeof(HISTORY_TIERS) / sizeof(HISTORY_TIERS[0]));
+
+struct HistoryPoint {
+    int64_t time = 0;           // Bucket start, unix seconds
+    float min = 0.0f;
+    float max = 0.0f;
+    float avg = 0.0f;
+};
+
+class SensorHistory {
+public:
+    explicit SensorHistory(int sensorCapacity);
+
+    int Capacity() const { return sensorCapacity; }
+    size_t FootprintBytes() const;
+
+    // Feed one sample for the first 'count' slots; NaN means no reading. Call with non-decreasing time.
+    void Record(int64_t timeSec, const float* values, int count);
+
+    // Buckets of one slot that start inside [from, to], oldest first. Returns the count written.
+    int Query(int slot, int tier, int64_t from, int64_t to, HistoryPoint* out, int maxOut) const;
+    // Finest tier that still holds 'from' and needs no more than maxPoints buckets
+    int BestTier(int64_t from, int64_t to, int maxPoints, int64_t now) const;
+
+    void WriteCsv(std::ostream& os, int tier, int64_t from, int64_t to, const char* const* names, int count) const;
+
+private:
+    struct Tier {
+        int periodSec = 0;
+        int capacity = 0;
+        int head = 0;           // Next write position
+        int filled = 0;
+        std::vector<int64_t> time;          // [capacity]
+        std::vector<float> min, max, avg;   // [slot * capacity + i]
+
+        // Open bucket being accumulated for this tier
+        int64_t openStart = -1;
+        int openCount = 0;
+        std::vector<float> accMin, accMax, accSum;  // [slot]
+        std::vector<int> accCount;                  // [slot] samples summed; NaN ones are skipped
+    };
+
+    void Accumulate(int t, int64_t bucketStart, const float* mins, const float* maxs, const float* avgs, int count);
+    void Close(int t);
+
+    int sensorCapacity;
+    Tier tiers[HISTORY_TIER_COUNT];
+    std::vector<float> scratchMin, scratchMax, scratchAvg;
+    mutable std::mutex mutex;
+};
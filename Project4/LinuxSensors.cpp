@@ -0,0 +1,445 @@
+#ifdef __linux__
+#include "LinuxSensors.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+double MonotonicSeconds() {
+    timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+std::string LinuxCpuModel() {
+    FILE* f = fopen("/proc/cpuinfo", "r");
+    if (!f) return "unknown";
+    char line[512];
+    std::string model = "unknown";
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "model name", 10) != 0) continue;
+        const char* v = strchr(line, ':');
+        if (!v) continue;
+        for (v++; *v == ' ' || *v == '\t'; v++) {}
+        model.assign(v, strcspn(v, "\n"));
+        break;
+    }
+    fclose(f);
+    return model;
+}
+
+static unsigned long long ParseU64(const char*& p) {
+    while (*p == ' ' || *p == '\t') p++;
+    unsigned long long v = 0;
+    while (*p >= '0' && *p <= '9') v = v * 10 + (*p++ - '0');
+    return v;
+}
+
+static const char* NextLine(const char* p) {
+    while (*p && *p != '\n') p++;
+    return *p ? p + 1 : p;
+}
+
+// ---------------------------------------------------------
+//  PROCFILE
+// ---------------------------------------------------------
+ProcFile::~ProcFile() { if (fd >= 0) close(fd); }
+
+bool ProcFile::Open(const char* path, size_t capacity) {
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    buf.resize(capacity + 1);
+    return true;
+}
+
+const char* ProcFile::Read(int* length) {
+    ssize_t n = (fd >= 0) ? pread(fd, buf.data(), buf.size() - 1, 0) : -1;
+    if (n < 0) n = 0;
+    buf[n] = 0;
+    if (length) *length = (int)n;
+    return buf.data();
+}
+
+// ---------------------------------------------------------
+//  /proc/stat
+// ---------------------------------------------------------
+bool ProcStatProvider::Open() {
+    // "cpuN ..." lines are ~100 bytes; the huge "intr" line after them is cut off on purpose
+    if (!file.Open("/proc/stat", 128 * 1024)) return false;
+    const char* p = file.Read();
+    sensors.clear();
+    cpuIds.clear();
+    for (; strncmp(p, "cpu", 3) == 0; p = NextLine(p)) {
+        SensorDesc d; d.unit = SensorUnit::Percent;
+        int id = (p[3] == ' ') ? -1 : atoi(p + 3);
+        if (id < 0) SetSensorName(d, "cpu.load");
+        else { SetSensorName(d, "cpu%d.load", id); d.detail = true; }
+        sensors.push_back(d);
+        cpuIds.push_back(id);
+    }
+    prevBusy.assign(sensors.size(), 0);
+    prevTotal.assign(sensors.size(), 0);
+    return !sensors.empty();
+}
+
+bool ProcStatProvider::Poll(float* values) {
+    const char* p = file.Read();
+    size_t i = 0;
+    for (; i < sensors.size() && strncmp(p, "cpu", 3) == 0; i++, p = NextLine(p)) {
+        // An offline CPU has no line: match by id so the ones after it keep their slots
+        int id = (p[3] == ' ') ? -1 : atoi(p + 3);
+        while (i < sensors.size() && cpuIds[i] < id) values[i++] = 0.0f;
+        if (i == sensors.size()) break;
+        if (cpuIds[i] != id) { i--; continue; }     // Came online after Open: not one of ours
+        const char* f = p + 3;
+        while (*f != ' ' && *f) f++;
+        // user nice system idle iowait irq softirq steal
+        unsigned long long v[8];
+        for (auto& x : v) x = ParseU64(f);
+        unsigned long long idle = v[3] + v[4];
+        unsigned long long total = 0;
+        for (auto x : v) total += x;
+        unsigned long long busy = total - idle;
+
+        unsigned long long dTotal = total - prevTotal[i];
+        unsigned long long dBusy = busy - prevBusy[i];
+        values[i] = (prevTotal[i] && dTotal) ? (float)(100.0 * dBusy / dTotal) : 0.0f;
+        prevTotal[i] = total; prevBusy[i] = busy;
+    }
+    for (; i < sensors.size(); i++) values[i] = 0.0f; // CPU went offline
+    return true;
+}
+
+// ---------------------------------------------------------
+//  /proc/meminfo
+// ---------------------------------------------------------
+bool MemInfoProvider::Open() {
+    SetSensorName(sensors[0], "mem.load"); sensors[0].unit = SensorUnit::Percent;
+    SetSensorName(sensors[1], "mem.used"); sensors[1].unit = SensorUnit::MegaBytes;
+    SetSensorName(sensors[2], "mem.total"); sensors[2].unit = SensorUnit::MegaBytes;
+    return file.Open("/proc/meminfo", 8 * 1024);
+}
+
+bool MemInfoProvider::Poll(float* values) {
+    unsigned long long totalKb = 0, availKb = 0;
+    for (const char* p = file.Read(); *p; p = NextLine(p)) {
+        if (strncmp(p, "MemTotal:", 9) == 0) { const char* f = p + 9; totalKb = ParseU64(f); }
+        else if (strncmp(p, "MemAvailable:", 13) == 0) { const char* f = p + 13; availKb = ParseU64(f); break; }
+    }
+    if (totalKb == 0) return false;
+    values[0] = (float)(100.0 * (totalKb - availKb) / totalKb);
+    values[1] = (float)((totalKb - availKb) / 1024.0);
+    values[2] = (float)(totalKb / 1024.0);
+    return true;
+}
+
+// ---------------------------------------------------------
+//  /proc/diskstats
+// ---------------------------------------------------------
+static const char* ParseDiskName(const char* p, char* name, size_t cap) {
+    ParseU64(p); ParseU64(p); // major, minor
+    while (*p == ' ') p++;
+    size_t n = 0;
+    while (*p && *p != ' ' && n + 1 < cap) name[n++] = *p++;
+    name[n] = 0;
+    return p;
+}
+
+bool DiskStatsProvider::Open() {
+    SetSensorName(sensors[0], "disk.read"); sensors[0].unit = SensorUnit::MegaBytesPerSec;
+    SetSensorName(sensors[1], "disk.write"); sensors[1].unit = SensorUnit::MegaBytesPerSec;
+    if (!file.Open("/proc/diskstats", 64 * 1024)) return false;
+
+    // Whole disks only: partitions have no /sys/block entry. Skip loop and ram devices.
+    for (const char* p = file.Read(); *p; p = NextLine(p)) {
+        Disk d; ParseDiskName(p, d.name, sizeof(d.name));
+        if (!d.name[0] || strncmp(d.name, "loop", 4) == 0 || strncmp(d.name, "ram", 3) == 0) continue;
+        char path[96]; snprintf(path, sizeof(path), "/sys/block/%s", d.name);
+        struct stat st;
+        if (stat(path, &st) == 0) disks.push_back(d);
+    }
+    return true;
+}
+
+bool DiskStatsProvider::Poll(float* values) {
+    unsigned long long readSectors = 0, writeSectors = 0;
+    for (const char* p = file.Read(); *p; p = NextLine(p)) {
+        char name[32];
+        const char* f = ParseDiskName(p, name, sizeof(name));
+        bool match = false;
+        for (const Disk& d : disks) if (strcmp(d.name, name) == 0) { match = true; break; }
+        if (!match) continue;
+        // reads merged sectors ms writes merged sectors
+        unsigned long long v[7];
+        for (auto& x : v) x = ParseU64(f);
+        readSectors += v[2];
+        writeSectors += v[6];
+    }
+
+    double now = MonotonicSeconds();
+    double dt = now - prevTime;
+    if (prevTime > 0 && dt > 0) {
+        values[0] = (float)((readSectors - prevRead) * 512.0 / (1024.0 * 1024.0) / dt);
+        values[1] = (float)((writeSectors - prevWrite) * 512.0 / (1024.0 * 1024.0) / dt);
+    }
+    else {
+        values[0] = values[1] = 0.0f;
+    }
+    prevRead = readSectors; prevWrite = writeSectors; prevTime = now;
+    return true;
+}
+
+// ---------------------------------------------------------
+//  /sys/class/hwmon
+// ---------------------------------------------------------
+static bool ReadSmallFile(const char* path, char* out, size_t cap) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    ssize_t n = read(fd, out, cap - 1);
+    close(fd);
+    if (n <= 0) return false;
+    while (n > 0 && (out[n - 1] == '\n' || out[n - 1] == ' ')) n--;
+    out[n] = 0;
+    return true;
+}
+
+bool HwmonProvider::Open() {
+    const char* root = "/sys/class/hwmon";
+    DIR* dir = opendir(root);
+    if (!dir) return false;
+
+    while (dirent* e = readdir(dir)) {
+        if (strncmp(e->d_name, "hwmon", 5) != 0) continue;
+        char base[512]; snprintf(base, sizeof(base), "%s/%s", root, e->d_name);
+        char chip[32] = "hwmon";
+        char path[768];
+        snprintf(path, sizeof(path), "%s/name", base);
+        ReadSmallFile(path, chip, sizeof(chip));
+
+        DIR* sub = opendir(base);
+        if (!sub) continue;
+        while (dirent* f = readdir(sub)) {
+            // tempN_input (m°C), inN_input (mV), fanN_input (RPM)
+            const char* n = f->d_name;
+            size_t len = strlen(n);
+            if (len < 7 || strcmp(n + len - 6, "_input") != 0) continue;
+            SensorUnit unit; float scale;
+            if (strncmp(n, "temp", 4) == 0) { unit = SensorUnit::Celsius; scale = 0.001f; }
+            else if (strncmp(n, "in", 2) == 0) { unit = SensorUnit::Volt; scale = 0.001f; }
+            else if (strncmp(n, "fan", 3) == 0) { unit = SensorUnit::Rpm; scale = 1.0f; }
+            else continue;
+
+            char channel[32]; snprintf(channel, sizeof(channel), "%.*s", (int)(len - 6), n);
+            char label[32];
+            snprintf(path, sizeof(path), "%s/%s_label", base, channel);
+            if (!ReadSmallFile(path, label, sizeof(label))) snprintf(label, sizeof(label), "%s", channel);
+
+            ProcFile file;
+            snprintf(path, sizeof(path), "%s/%s", base, n);
+            if (!file.Open(path, 32)) continue;
+
+            SensorDesc d; d.unit = unit;
+            SetSensorName(d, "%s.%s", chip, label);
+            sensors.push_back(d);
+            files.push_back(std::move(file));
+            scales.push_back(scale);
+            if ((int)sensors.size() >= MAX_SENSORS / 2) break;
+        }
+        closedir(sub);
+    }
+    closedir(dir);
+    return true;
+}
+
+bool HwmonProvider::Poll(float* values) {
+    for (size_t i = 0; i < files.size(); i++) {
+        const char* p = files[i].Read();
+        values[i] = (float)atol(p) * scales[i];
+    }
+    return true;
+}
+
+// ---------------------------------------------------------
+//  CORE CLOCKS
+// ---------------------------------------------------------
+constexpr uint32_t MSR_TSC = 0x10, MSR_MPERF = 0xE7, MSR_APERF = 0xE8;
+// Below this a core has barely left its C-state: its clock means nothing and waking it costs more than it tells
+constexpr float CLOCK_SAMPLE_MIN_LOAD = 2.0f;
+constexpr auto CLOCK_SAMPLE_TIMEOUT = std::chrono::milliseconds(20);
+
+static bool ReadMsr(int fd, uint32_t reg, uint64_t& value) {
+    return pread(fd, &value, sizeof(value), reg) == (ssize_t)sizeof(value);
+}
+
+// Nominal clock without the TSC to time it: intel_pstate's base_frequency, else the "@ 3.60GHz" in the model name
+static float NominalCpuMhz() {
+    ProcFile f;
+    if (f.Open("/sys/devices/system/cpu/cpu0/cpufreq/base_frequency", 32)) {
+        long khz = atol(f.Read());
+        if (khz > 0) return khz / 1000.0f;
+    }
+    std::string model = LinuxCpuModel();
+    size_t at = model.rfind('@');
+    return (at != std::string::npos) ? (float)(atof(model.c_str() + at + 1) * 1000.0) : 0.0f;
+}
+
+CpuClockProvider::~CpuClockProvider() {
+    stop = true;
+    for (auto& c : cores) c->go.release();      // The stop token; a pending request may sit beside it
+    for (auto& t : threads) t.join();
+    for (auto& c : cores) if (c->msrFd >= 0) close(c->msrFd);
+}
+
+bool CpuClockProvider::Open() {
+    if (!load.Open()) return false;
+    loads.assign(load.SensorCount(), 0.0f);
+    int count = (std::min)(load.SensorCount() - 1, MAX_SENSORS / 4);    // Leaves room for procstat's per-core loads
+    char path[96];
+    msr = count > 0;
+    for (int i = 0; i < count; i++) {
+        auto c = std::make_unique<Core>();
+        c->cpu = load.CpuId(1 + i);     // Core i is procstat's slot 1 + i, whatever its number
+        snprintf(path, sizeof(path), "/dev/cpu/%d/msr", c->cpu);
+        c->msrFd = open(path, O_RDONLY | O_CLOEXEC);
+        uint64_t probe;
+        if (c->msrFd >= 0 && !ReadMsr(c->msrFd, MSR_APERF, probe)) { close(c->msrFd); c->msrFd = -1; }
+        msr = msr && c->msrFd >= 0;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", c->cpu);
+        c->curFreq.Open(path, 32);
+        cores.push_back(std::move(c));
+    }
+    if (!msr) {
+        for (auto& c : cores) if (c->msrFd >= 0) { close(c->msrFd); c->msrFd = -1; }
+        bool any = false;
+        for (auto& c : cores) any = any || c->curFreq.IsOpen();
+        if (!any) { cores.clear(); return false; }
+    }
+    baseMhz = NominalCpuMhz();
+
+    sensors.resize(3 + cores.size());
+    SetSensorName(sensors[0], "cpu.mhz");
+    SetSensorName(sensors[1], "cpu.mhz.base");
+    SetSensorName(sensors[2], "cpu.throttled");
+    for (size_t i = 0; i < cores.size(); i++) {
+        SetSensorName(sensors[3 + i], "cpu%d.mhz", cores[i]->cpu);
+        sensors[3 + i].detail = true;
+    }
+    for (size_t i = 0; i < 3 + cores.size(); i++) if (i != 2) sensors[i].unit = SensorUnit::MHz;
+
+    if (msr) {
+        for (auto& c : cores) threads.emplace_back(&CpuClockProvider::SampleLoop, this, std::ref(*c));
+    }
+    return true;
+}
+
+void CpuClockProvider::SampleLoop(Core& c) {
+    cpu_set_t set; CPU_ZERO(&set); CPU_SET(c.cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);    // Offline core: runs elsewhere, the reads still work (via IPI)
+    for (;;) {
+        c.go.acquire();
+        if (stop) return;
+        uint32_t gen = c.requested.load(std::memory_order_acquire);
+        CoreClockSample s;
+        s.seconds = MonotonicSeconds();
+        c.sampled = ReadMsr(c.msrFd, MSR_TSC, s.tsc) && ReadMsr(c.msrFd, MSR_MPERF, s.mperf) && ReadMsr(c.msrFd, MSR_APERF, s.aperf);
+        if (c.sampled) c.sample = s;
+        // Always completes, even on a failed read, so Poll can re-arm this core next tick
+        c.completed.store(gen, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> l(doneMutex);
+            if (gen == doneGeneration) doneCount++;
+        }
+        doneCv.notify_one();
+    }
+}
+
+bool CpuClockProvider::Poll(float* values) {
+    if (!load.Poll(loads.data())) return false;
+    int n = (int)cores.size();
+
+    if (msr) {
+        // Wake only the busy cores (and any never sampled); the rest keep their last clock.
+        // A core still on an older request (it missed a deadline) is left alone: re-arming it
+        // would queue a second request, and its late completion belongs to that older tick.
+        uint32_t gen = ++generation;
+        {
+            std::lock_guard<std::mutex> l(doneMutex);
+            doneGeneration = gen;
+            doneCount = 0;
+        }
+        int woken = 0;
+        for (int i = 0; i < n; i++) {
+            Core& c = *cores[i];
+            if (c.completed.load(std::memory_order_acquire) != c.requested.load(std::memory_order_relaxed)) continue;
+            if (loads[1 + i] < CLOCK_SAMPLE_MIN_LOAD && c.prev.tsc != 0) { c.busyPct = loads[1 + i]; continue; }
+            c.requested.store(gen, std::memory_order_release);
+            c.go.release();
+            woken++;
+        }
+        {
+            std::unique_lock<std::mutex> l(doneMutex);
+            doneCv.wait_until(l, std::chrono::steady_clock::now() + CLOCK_SAMPLE_TIMEOUT, [&] { return doneCount >= woken; });
+        }
+
+        for (int i = 0; i < n; i++) {
+            Core& c = *cores[i];
+            if (c.completed.load(std::memory_order_acquire) != gen || !c.sampled) continue;
+            CoreClock clk;
+            if (c.prev.tsc != 0 && ComputeCoreClock(c.prev, c.sample, clk)) {
+                c.mhz = clk.mhz;
+                c.busyPct = clk.busyPct;    // C0 residency over exactly the clock's window
+                baseMhz = clk.baseMhz;
+            }
+            c.prev = c.sample;
+        }
+    }
+    else {
+        for (int i = 0; i < n; i++) {
+            Core& c = *cores[i];
+            if (c.curFreq.IsOpen()) c.mhz = atol(c.curFreq.Read()) / 1000.0f;
+            c.busyPct = loads[1 + i];
+        }
+    }
+
+    float sum = 0.0f;
+    int counted = 0, throttled = 0;
+    for (int i = 0; i < n; i++) {
+        const Core& c = *cores[i];
+        values[3 + i] = c.mhz;
+        if (c.mhz > 0.0f) { sum += c.mhz; counted++; }
+        if (IsCoreThrottled(c.busyPct, c.mhz, baseMhz)) throttled++;
+    }
+    values[0] = counted ? sum / counted : 0.0f;
+    values[1] = baseMhz;
+    values[2] = (float)throttled;
+    return true;
+}
+
+// ---------------------------------------------------------
+//  /dev/port
+// ---------------------------------------------------------
+DevPortIo::~DevPortIo() {
+    if (fd >= 0) close(fd);
+}
+
+bool DevPortIo::Open() {
+    if (fd < 0) fd = open("/dev/port", O_RDWR | O_CLOEXEC);
+    return fd >= 0;
+}
+
+uint8_t DevPortIo::In8(uint16_t port) {
+    uint8_t value = 0xFF;
+    if (pread(fd, &value, 1, port) != 1) return 0xFF;      // Reads as a floating bus
+    return value;
+}
+
+void DevPortIo::Out8(uint16_t port, uint8_t value) {
+    // A lost write looks like an absent chip; detection copes with both
+    if (pwrite(fd, &value, 1, port) != 1) return;
+}
+#endif
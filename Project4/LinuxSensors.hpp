@@ -0,0 +1,169 @@
+#pragma once
+#ifdef __linux__
+#include "CpuClock.hpp"
+#include "PortIo.hpp"
+#include "SensorProvider.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------
+//  LINUX BACKEND (procfs / sysfs)
+//  Every file is opened once in Open() and re-read with pread()
+//  into a buffer sized up front, so Poll() never allocates.
+// ---------------------------------------------------------
+class ProcFile {
+public:
+    ProcFile() = default;
+    ~ProcFile();
+    ProcFile(const ProcFile&) = delete;
+    ProcFile& operator=(const ProcFile&) = delete;
+    ProcFile(ProcFile&& other) noexcept : fd(other.fd), buf(std::move(other.buf)) { other.fd = -1; }
+
+    bool Open(const char* path, size_t capacity);
+    // Re-reads from offset 0. Returns a NUL-terminated view valid until the next Read().
+    const char* Read(int* length = nullptr);
+    bool IsOpen() const { return fd >= 0; }
+
+private:
+    int fd = -1;
+    std::vector<char> buf;
+};
+
+// /proc/stat: total and per-core load from jiffies deltas
+class ProcStatProvider : public ISensorProvider {
+public:
+    const char* Name() const override { return "procstat"; }
+    bool Open() override;
+    int SensorCount() const override { return (int)sensors.size(); }
+    const SensorDesc& Sensor(int i) const override { return sensors[i]; }
+    int PollCostUs() const override { return 20 + 2 * (int)sensors.size(); }
+    bool Poll(float* values) override;
+    // Kernel CPU number behind a sensor, -1 for the "cpu" total. Ids can have gaps.
+    int CpuId(int sensor) const { return cpuIds[sensor]; }
+
+private:
+    ProcFile file;
+    std::vector<SensorDesc> sensors;
+    std::vector<int> cpuIds;
+    std::vector<unsigned long long> prevBusy, prevTotal;
+};
+
+// /proc/meminfo: load, used and total
+class MemInfoProvider : public ISensorProvider {
+public:
+    const char* Name() const override { return "meminfo"; }
+    bool Open() override;
+    int SensorCount() const override { return 3; }
+    const SensorDesc& Sensor(int i) const override { return sensors[i]; }
+    int PollCostUs() const override { return 15; }
+    bool Poll(float* values) override;
+
+private:
+    ProcFile file;
+    SensorDesc sensors[3];
+};
+
+// /proc/diskstats: aggregate read/write throughput of whole disks
+class DiskStatsProvider : public ISensorProvider {
+public:
+    const char* Name() const override { return "diskstats"; }
+    bool Open() override;
+    int SensorCount() const override { return 2; }
+    const SensorDesc& Sensor(int i) const override { return sensors[i]; }
+    int PollCostUs() const override { return 15; }
+    bool Poll(float* values) override;
+
+private:
+    struct Disk { char name[32]; };
+    ProcFile file;
+    SensorDesc sensors[2];
+    std::vector<Disk> disks;
+    unsigned long long prevRead = 0, prevWrite = 0;
+    double prevTime = 0.0;
+};
+
+// /sys/class/hwmon/*: every temp*/in*/fan*_input exposed by the kernel drivers
+class HwmonProvider : public ISensorProvider {
+public:
+    const char* Name() const override { return "hwmon"; }
+    bool Open() override;
+    int SensorCount() const override { return (int)sensors.size(); }
+    const SensorDesc& Sensor(int i) const override { return sensors[i]; }
+    int PollCostUs() const override { return 5 * (int)sensors.size(); }
+    bool Poll(float* values) override;
+
+private:
+    std::vector<SensorDesc> sensors;
+    std::vector<ProcFile> files;
+    std::vector<float> scales;
+};
+
+// Per-core clocks: cpu.mhz (mean), cpu.mhz.base, cpu.throttled (cores), cpuN.mhz.
+// With /dev/cpu/*/msr (msr module, root) APERF, MPERF and TSC are read by a
+// thread pinned to each core: one wake per core per tick instead of an IPI
+// per register, and cores /proc/stat shows idle are not woken at all.
+// Without it, cpufreq's scaling_cur_freq.
+class CpuClockProvider : public ISensorProvider {
+public:
+    ~CpuClockProvider();
+    const char* Name() const override { return msr ? "aperfmperf" : "cpufreq"; }
+    bool Open() override;
+    int SensorCount() const override { return (int)sensors.size(); }
+    const SensorDesc& Sensor(int i) const override { return sensors[i]; }
+    int PollCostUs() const override { return load.PollCostUs() + (msr ? 15 : 5) * (int)cores.size(); }
+    bool Poll(float* values) override;
+
+private:
+    struct Core {
+        int cpu = 0;                    // Kernel CPU number, from its /proc/stat line
+        int msrFd = -1;
+        ProcFile curFreq;
+        // At most one request in flight (Poll only re-arms a core that finished) plus the stop token
+        std::counting_semaphore<2> go{ 0 };
+        std::atomic<uint32_t> requested{ 0 }, completed{ 0 };
+        bool sampled = false;           // The MSR reads succeeded; published with 'completed'
+        CoreClockSample sample, prev;   // 'sample' belongs to the core's thread until 'completed' moves
+        float mhz = 0.0f;
+        float busyPct = 0.0f;
+    };
+    void SampleLoop(Core& c);
+
+    ProcStatProvider load;          // Picks which cores are worth waking; also the throttle load
+    std::vector<float> loads;
+    std::vector<std::unique_ptr<Core>> cores;
+    std::vector<std::thread> threads;
+    // Completions of the current generation only; a core finishing a stale request is not counted
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    uint32_t doneGeneration = 0;
+    int doneCount = 0;
+    std::atomic<bool> stop{ false };
+    uint32_t generation = 0;
+    bool msr = false;
+    float baseMhz = 0.0f;
+    std::vector<SensorDesc> sensors;
+};
+
+// /dev/port: one pread/pwrite per port op, so the Super I/O code can run on a
+// Linux box as root. Fails under kernel lockdown or without CONFIG_DEVPORT.
+class DevPortIo : public IPortIo {
+public:
+    ~DevPortIo();
+    bool Open();
+    uint8_t In8(uint16_t port) override;
+    void Out8(uint16_t port, uint8_t value) override;
+
+private:
+    int fd = -1;
+};
+
+double MonotonicSeconds();
+// "model name" from /proc/cpuinfo, or "unknown"
+std::string LinuxCpuModel();
+#endif
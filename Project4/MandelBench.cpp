@@ -0,0 +1,78 @@
+#include "MandelBench.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+uint64_t MandelTileScalar(const MandelTile& t) {
+    uint64_t total = 0;
+    for (int y = t.y0; y < t.y1; y++) {
+        double ci = MandelIm(y);
+        for (int x = t.x0; x < t.x1; x++) {
+            double cr = MandelRe(x);
+            double zr = 0.0, zi = 0.0;
+            int iter = 0;
+            while ((zr * zr + zi * zi) <= 4.0 && iter < MANDEL_MAX_ITER) {
+                double temp = zr * zr - zi * zi + cr;
+                zi = 2.0 * zr * zi + ci;
+                zr = temp;
+                iter++;
+            }
+            total += iter;
+        }
+    }
+    return total;
+}
+
+TiledBenchResult RunTiledBenchmark(int threads, MandelKernel kernel, std::atomic<int>* progress) {
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    const int tilesX = MANDEL_WIDTH / MANDEL_TILE, tilesY = MANDEL_HEIGHT / MANDEL_TILE;
+    const int tileCount = tilesX * tilesY;
+    threads = (std::max)(threads, 1);
+
+    TiledBenchResult r;
+    r.threads = threads;
+    r.tiles = tileCount;
+    r.perThread.resize(threads);
+    std::atomic<int> nextTile{ 0 }, doneTiles{ 0 };
+
+    auto worker = [&](int id) {
+        BenchThreadStats& s = r.perThread[id];     // One writer per slot; read after join
+        for (;;) {
+            int t = nextTile.fetch_add(1, std::memory_order_relaxed);
+            if (t >= tileCount) break;
+            MandelTile tile;
+            tile.x0 = (t % tilesX) * MANDEL_TILE; tile.x1 = tile.x0 + MANDEL_TILE;
+            tile.y0 = (t / tilesX) * MANDEL_TILE; tile.y1 = tile.y0 + MANDEL_TILE;
+            Clock::time_point start = Clock::now();
+            s.iterations += kernel(tile);
+            s.busyMs += ms(Clock::now() - start);
+            s.tiles++;
+
+            if (!progress) continue;
+            int pct = (doneTiles.fetch_add(1, std::memory_order_relaxed) + 1) * 100 / tileCount;
+            // Publish only forward moves, so a late writer can never drag the bar back
+            int seen = progress->load(std::memory_order_relaxed);
+            while (pct > seen && !progress->compare_exchange_weak(seen, pct, std::memory_order_relaxed)) {}
+        }
+    };
+
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++) pool.emplace_back(worker, i);
+    worker(0);  // The calling thread is worker 0
+    for (auto& t : pool) t.join();
+    r.elapsedMs = ms(Clock::now() - start);
+
+    double busySum = 0.0, busyMax = 0.0;
+    for (BenchThreadStats& s : r.perThread) {
+        s.idleMs = (std::max)(0.0, r.elapsedMs - s.busyMs);
+        r.iterations += s.iterations;
+        busySum += s.busyMs;
+        busyMax = (std::max)(busyMax, s.busyMs);
+    }
+    r.imbalance = busySum > 0.0 ? busyMax / (busySum / threads) : 0.0;
+    r.score = r.elapsedMs > 0.0 ? r.iterations / (r.elapsedMs / 1000.0) / 100000.0 : 0.0;
+    return r;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------
+//  MANDELBROT BENCHMARK
+//  The 4096x4096 domain is cut into 64x64 tiles handed out through one
+//  atomic counter, so a thread that drew cheap edge tiles keeps pulling
+//  work instead of idling while another grinds through the set's interior.
+//  Kernels only see a tile and return the iterations they ran.
+// ---------------------------------------------------------
+constexpr int MANDEL_WIDTH = 4096;
+constexpr int MANDEL_HEIGHT = 4096;
+constexpr int MANDEL_MAX_ITER = 1000;
+constexpr int MANDEL_TILE = 64;
+
+struct MandelTile {
+    int x0, y0, x1, y1;     // Half-open pixel range
+};
+
+// Domain coordinates of a pixel: re in [-2.5, 1.0), im in [-1.0, 1.0)
+inline double MandelRe(int x) { return x * (3.5 / MANDEL_WIDTH) - 2.5; }
+inline double MandelIm(int y) { return y * (2.0 / MANDEL_HEIGHT) - 1.0; }
+
+using MandelKernel = uint64_t(*)(const MandelTile& tile);
+
+uint64_t MandelTileScalar(const MandelTile& tile);
+
+struct BenchThreadStats {
+    int tiles = 0;
+    uint64_t iterations = 0;
+    double busyMs = 0.0;        // Inside the kernel
+    double idleMs = 0.0;        // Rest of the run: start-up, counter traffic, waiting for the last tile
+};
+
+struct TiledBenchResult {
+    std::string kernel;         // MandelKernelInfo name; filled by the caller
+    int threads = 0;
+    int tiles = 0;
+    uint64_t iterations = 0;
+    double elapsedMs = 0.0;
+    double score = 0.0;         // Iterations per second / 1e5 (Mit/s x 10), as the overlay has always shown
+    double imbalance = 0.0;     // Slowest thread's busy time over the mean; 1.0 is perfect
+    std::vector<BenchThreadStats> perThread;
+};
+
+// Runs the whole domain on 'threads' workers, the calling thread included.
+// 'progress' is raised (never lowered) to the percentage of finished tiles.
+TiledBenchResult RunTiledBenchmark(int threads, MandelKernel kernel, std::atomic<int>* progress = nullptr);
@@ -0,0 +1,345 @@
+#include "MandelKernels.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MANDEL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define MANDEL_TARGET(isa)
+#else
+#include <cpuid.h>
+#define MANDEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MANDEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Every kernel counts exactly like MandelTileScalar: a lane earns one
+// iteration for each pass it starts with |z|^2 <= 4, up to MANDEL_MAX_ITER.
+
+#ifdef MANDEL_X86
+// ---------------------------------------------------------
+//  SSE2 (baseline on x64)
+// ---------------------------------------------------------
+static uint64_t TileSse2F32(const MandelTile& t) {
+    uint64_t total = 0;
+    const __m128 four = _mm_set1_ps(4.0f), two = _mm_set1_ps(2.0f);
+    for (int y = t.y0; y < t.y1; y++) {
+        __m128 ci = _mm_set1_ps((float)MandelIm(y));
+        for (int x = t.x0; x < t.x1; x += 4) {
+            __m128 cr = _mm_setr_ps((float)MandelRe(x), (float)MandelRe(x + 1), (float)MandelRe(x + 2), (float)MandelRe(x + 3));
+            __m128 zr = _mm_setzero_ps(), zi = _mm_setzero_ps();
+            __m128i count = _mm_setzero_si128();
+            __m128 active = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int i = 0; i < MANDEL_MAX_ITER; i++) {
+                __m128 zr2 = _mm_mul_ps(zr, zr), zi2 = _mm_mul_ps(zi, zi);
+                active = _mm_and_ps(active, _mm_cmple_ps(_mm_add_ps(zr2, zi2), four));
+                if (_mm_movemask_ps(active) == 0) break;
+                count = _mm_sub_epi32(count, _mm_castps_si128(active));
+                zi = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(zr, zi), two), ci);
+                zr = _mm_add_ps(_mm_sub_ps(zr2, zi2), cr);
+            }
+            alignas(16) uint32_t c[4]; _mm_store_si128((__m128i*)c, count);
+            total += (uint64_t)c[0] + c[1] + c[2] + c[3];
+        }
+    }
+    return total;
+}
+
+static uint64_t TileSse2F64(const MandelTile& t) {
+    uint64_t total = 0;
+    const __m128d four = _mm_set1_pd(4.0), two = _mm_set1_pd(2.0);
+    for (int y = t.y0; y < t.y1; y++) {
+        __m128d ci = _mm_set1_pd(MandelIm(y));
+        for (int x = t.x0; x < t.x1; x += 2) {
+            __m128d cr = _mm_setr_pd(MandelRe(x), MandelRe(x + 1));
+            __m128d zr = _mm_setzero_pd(), zi = _mm_setzero_pd();
+            __m128i count = _mm_setzero_si128();
+            __m128d active = _mm_castsi128_pd(_mm_set1_epi32(-1));
+            for (int i = 0; i < MANDEL_MAX_ITER; i++) {
+                __m128d zr2 = _mm_mul_pd(zr, zr), zi2 = _mm_mul_pd(zi, zi);
+                active = _mm_and_pd(active, _mm_cmple_pd(_mm_add_pd(zr2, zi2), four));
+                if (_mm_movemask_pd(active) == 0) break;
+                count = _mm_sub_epi64(count, _mm_castpd_si128(active));
+                zi = _mm_add_pd(_mm_mul_pd(_mm_mul_pd(zr, zi), two), ci);
+                zr = _mm_add_pd(_mm_sub_pd(zr2, zi2), cr);
+            }
+            alignas(16) uint64_t c[2]; _mm_store_si128((__m128i*)c, count);
+            total += c[0] + c[1];
+        }
+    }
+    return total;
+}
+
+// ---------------------------------------------------------
+//  AVX2 + FMA3
+// ---------------------------------------------------------
+MANDEL_TARGET("avx2,fma")
+static uint64_t TileAvx2F32(const MandelTile& t) {
+    uint64_t total = 0;
+    const __m256 four = _mm256_set1_ps(4.0f);
+    for (int y = t.y0; y < t.y1; y++) {
+        __m256 ci = _mm256_set1_ps((float)MandelIm(y));
+        for (int x = t.x0; x < t.x1; x += 8) {
+            alignas(32) float re[8];
+            for (int k = 0; k < 8; k++) re[k] = (float)MandelRe(x + k);
+            __m256 cr = _mm256_load_ps(re);
+            __m256 zr = _mm256_setzero_ps(), zi = _mm256_setzero_ps();
+            __m256i count = _mm256_setzero_si256();
+            __m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (int i = 0; i < MANDEL_MAX_ITER; i++) {
+                __m256 zi2 = _mm256_mul_ps(zi, zi);
+                __m256 mag = _mm256_fmadd_ps(zr, zr, zi2);
+                active = _mm256_and_ps(active, _mm256_cmp_ps(mag, four, _CMP_LE_OQ));
+                if (_mm256_movemask_ps(active) == 0) break;
+                count = _mm256_sub_epi32(count, _mm256_castps_si256(active));
+                __m256 zrzi = _mm256_mul_ps(zr, zi);
+                zr = _mm256_fmadd_ps(zr, zr, _mm256_sub_ps(cr, zi2));  // zr^2 - zi^2 + cr
+                zi = _mm256_fmadd_ps(zrzi, _mm256_set1_ps(2.0f), ci);
+            }
+            alignas(32) uint32_t c[8]; _mm256_store_si256((__m256i*)c, count);
+            for (int k = 0; k < 8; k++) total += c[k];
+        }
+    }
+    return total;
+}
+
+MANDEL_TARGET("avx2,fma")
+static uint64_t TileAvx2F64(const MandelTile& t) {
+    uint64_t total = 0;
+    const __m256d four = _mm256_set1_pd(4.0);
+    for (int y = t.y0; y < t.y1; y++) {
+        __m256d ci = _mm256_set1_pd(MandelIm(y));
+        for (int x = t.x0; x < t.x1; x += 4) {
+            __m256d cr = _mm256_setr_pd(MandelRe(x), MandelRe(x + 1), MandelRe(x + 2), MandelRe(x + 3));
+            __m256d zr = _mm256_setzero_pd(), zi = _mm256_setzero_pd();
+            __m256i count = _mm256_setzero_si256();
+            __m256d active = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+            for (int i = 0; i < MANDEL_MAX_ITER; i++) {
+                __m256d zi2 = _mm256_mul_pd(zi, zi);
+                __m256d mag = _mm256_fmadd_pd(zr, zr, zi2);
+                active = _mm256_and_pd(active, _mm256_cmp_pd(mag, four, _CMP_LE_OQ));
+                if (_mm256_movemask_pd(active) == 0) break;
+                count = _mm256_sub_epi64(count, _mm256_castpd_si256(active));
+                __m256d zrzi = _mm256_mul_pd(zr, zi);
+                zr = _mm256_fmadd_pd(zr, zr, _mm256_sub_pd(cr, zi2));
+                zi = _mm256_fmadd_pd(zrzi, _mm256_set1_pd(2.0), ci);
+            }
+            alignas(32) uint64_t c[4]; _mm256_store_si256((__m256i*)c, count);
+            total += c[0] + c[1] + c[2] + c[3];
+        }
+    }
+    return total;
+}
+
+// ---------------------------------------------------------
+//  AVX-512F: comparisons land in mask registers, and the masked
+//  add bumps only the lanes still inside the set
+// ---------------------------------------------------------
+MANDEL_TARGET("avx512f")
+static uint64_t TileAvx512F32(const MandelTile& t) {
+    uint64_t total = 0;
+    const __m512 four = _mm512_set1_ps(4.0f), two = _mm512_set1_ps(2.0f);
+    const __m512i one = _mm512_set1_epi32(1);
+    for (int y = t.y0; y < t.y1; y++) {
+        __m512 ci = _mm512_set1_ps((float)MandelIm(y));
+        for (int x = t.x0; x < t.x1; x += 16) {
+            alignas(64) float re[16];
+            for (int k = 0; k < 16; k++) re[k] = (float)MandelRe(x + k);
+            __m512 cr = _mm512_load_ps(re);
+            __m512 zr = _mm512_setzero_ps(), zi = _mm512_setzero_ps();
+            __m512i count = _mm512_setzero_si512();
+            __mmask16 active = 0xFFFF;
+            for (int i = 0; i < MANDEL_MAX_ITER; i++) {
+                __m512 zi2 = _mm512_mul_ps(zi, zi);
+                active = _mm512_mask_cmp_ps_mask(active, _mm512_fmadd_ps(zr, zr, zi2), four, _CMP_LE_OQ);
+                if (!active) break;
+                count = _mm512_mask_add_epi32(count, active, count, one);
+                __m512 zrzi = _mm512_mul_ps(zr, zi);
+                zr = _mm512_fmadd_ps(zr, zr, _mm512_sub_ps(cr, zi2));
+                zi = _mm512_fmadd_ps(zrzi, two, ci);
+            }
+            alignas(64) uint32_t c[16]; _mm512_store_si512(c, count);
+            for (int k = 0; k < 16; k++) total += c[k];
+        }
+    }
+    return total;
+}
+
+MANDEL_TARGET("avx512f")
+static uint64_t TileAvx512F64(const MandelTile& t) {
+    uint64_t total = 0;
+    const __m512d four = _mm512_set1_pd(4.0), two = _mm512_set1_pd(2.0);
+    const __m512i one = _mm512_set1_epi64(1);
+    for (int y = t.y0; y < t.y1; y++) {
+        __m512d ci = _mm512_set1_pd(MandelIm(y));
+        for (int x = t.x0; x < t.x1; x += 8) {
+            alignas(64) double re[8];
+            for (int k = 0; k < 8; k++) re[k] = MandelRe(x + k);
+            __m512d cr = _mm512_load_pd(re);
+            __m512d zr = _mm512_setzero_pd(), zi = _mm512_setzero_pd();
+            __m512i count = _mm512_setzero_si512();
+            __mmask8 active = 0xFF;
+            for (int i = 0; i < MANDEL_MAX_ITER; i++) {
+                __m512d zi2 = _mm512_mul_pd(zi, zi);
+                active = _mm512_mask_cmp_pd_mask(active, _mm512_fmadd_pd(zr, zr, zi2), four, _CMP_LE_OQ);
+                if (!active) break;
+                count = _mm512_mask_add_epi64(count, active, count, one);
+                __m512d zrzi = _mm512_mul_pd(zr, zi);
+                zr = _mm512_fmadd_pd(zr, zr, _mm512_sub_pd(cr, zi2));
+                zi = _mm512_fmadd_pd(zrzi, two, ci);
+            }
+            alignas(64) uint64_t c[8]; _mm512_store_si512(c, count);
+            for (int k = 0; k < 8; k++) total += c[k];
+        }
+    }
+    return total;
+}
+#endif
+
+#ifdef MANDEL_NEON
+// ---------------------------------------------------------
+//  NEON (AArch64)
+// ---------------------------------------------------------
+static uint64_t TileNeonF32(const MandelTile& t) {
+    uint64_t total = 0;
+    const float32x4_t four = vdupq_n_f32(4.0f);
+    for (int y = t.y0; y < t.y1; y++) {
+        float32x4_t ci = vdupq_n_f32((float)MandelIm(y));
+        for (int x = t.x0; x < t.x1; x += 4) {
+            float re[4] = { (float)MandelRe(x), (float)MandelRe(x + 1), (float)MandelRe(x + 2), (float)MandelRe(x + 3) };
+            float32x4_t cr = vld1q_f32(re);
+            float32x4_t zr = vdupq_n_f32(0.0f), zi = vdupq_n_f32(0.0f);
+            uint32x4_t count = vdupq_n_u32(0), active = vdupq_n_u32(0xFFFFFFFFu);
+            for (int i = 0; i < MANDEL_MAX_ITER; i++) {
+                float32x4_t zi2 = vmulq_f32(zi, zi);
+                active = vandq_u32(active, vcleq_f32(vfmaq_f32(zi2, zr, zr), four));
+                if (vmaxvq_u32(active) == 0) break;
+                count = vsubq_u32(count, active);
+                float32x4_t zrzi = vmulq_f32(zr, zi);
+                zr = vfmaq_f32(vsubq_f32(cr, zi2), zr, zr);
+                zi = vfmaq_f32(ci, zrzi, vdupq_n_f32(2.0f));
+            }
+            total += vaddvq_u32(count);
+        }
+    }
+    return total;
+}
+
+static uint64_t TileNeonF64(const MandelTile& t) {
+    uint64_t total = 0;
+    const float64x2_t four = vdupq_n_f64(4.0);
+    for (int y = t.y0; y < t.y1; y++) {
+        float64x2_t ci = vdupq_n_f64(MandelIm(y));
+        for (int x = t.x0; x < t.x1; x += 2) {
+            double re[2] = { MandelRe(x), MandelRe(x + 1) };
+            float64x2_t cr = vld1q_f64(re);
+            float64x2_t zr = vdupq_n_f64(0.0), zi = vdupq_n_f64(0.0);
+            uint64x2_t count = vdupq_n_u64(0), active = vdupq_n_u64(~0ull);
+            for (int i = 0; i < MANDEL_MAX_ITER; i++) {
+                float64x2_t zi2 = vmulq_f64(zi, zi);
+                active = vandq_u64(active, vcleq_f64(vfmaq_f64(zi2, zr, zr), four));
+                if (vmaxvq_u32(vreinterpretq_u32_u64(active)) == 0) break;
+                count = vsubq_u64(count, active);
+                float64x2_t zrzi = vmulq_f64(zr, zi);
+                zr = vfmaq_f64(vsubq_f64(cr, zi2), zr, zr);
+                zi = vfmaq_f64(ci, zrzi, vdupq_n_f64(2.0));
+            }
+            total += vgetq_lane_u64(count, 0) + vgetq_lane_u64(count, 1);
+        }
+    }
+    return total;
+}
+#endif
+
+// ---------------------------------------------------------
+//  DETECTION AND DISPATCH
+// ---------------------------------------------------------
+static CpuFeatures Probe() {
+    CpuFeatures f;
+#ifdef MANDEL_X86
+    unsigned r[4] = {};
+    auto cpuid = [&r](unsigned leaf, unsigned sub) {
+#ifdef _MSC_VER
+        int v[4]; __cpuidex(v, (int)leaf, (int)sub);
+        for (int i = 0; i < 4; i++) r[i] = (unsigned)v[i];
+#else
+        __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+    };
+    cpuid(0, 0);
+    unsigned maxLeaf = r[0];
+    cpuid(1, 0);
+    f.sse2 = (r[3] >> 26) & 1;
+    bool osxsave = (r[2] >> 27) & 1, avx = (r[2] >> 28) & 1, fma = (r[2] >> 12) & 1;
+    uint64_t xcr0 = 0;
+    if (osxsave) {
+#ifdef _MSC_VER
+        xcr0 = _xgetbv(0);
+#else
+        unsigned lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        xcr0 = ((uint64_t)hi << 32) | lo;
+#endif
+    }
+    bool osYmm = (xcr0 & 0x6) == 0x6;       // XMM and YMM state
+    bool osZmm = (xcr0 & 0xE6) == 0xE6;     // Plus opmask, ZMM_Hi256 and Hi16_ZMM
+    if (maxLeaf >= 7) {
+        cpuid(7, 0);
+        f.avx2 = avx && osYmm && ((r[1] >> 5) & 1);
+        f.avx512f = osZmm && ((r[1] >> 16) & 1);
+    }
+    f.fma = fma && osYmm;
+#endif
+#ifdef MANDEL_NEON
+    f.neon = true;  // Mandatory on AArch64
+#endif
+    return f;
+}
+
+const CpuFeatures& DetectCpuFeatures() {
+    static const CpuFeatures features = Probe();
+    return features;
+}
+
+// Widest first within each precision; SelectMandelKernel takes the first supported entry
+static const MandelKernelInfo g_Kernels[] = {
+#ifdef MANDEL_X86
+    { "avx512.f32", TileAvx512F32, 16, false, [](const CpuFeatures& f) { return f.avx512f; } },
+    { "avx2fma.f32", TileAvx2F32, 8, false, [](const CpuFeatures& f) { return f.avx2 && f.fma; } },
+    { "sse2.f32", TileSse2F32, 4, false, [](const CpuFeatures& f) { return f.sse2; } },
+    { "avx512.f64", TileAvx512F64, 8, true, [](const CpuFeatures& f) { return f.avx512f; } },
+    { "avx2fma.f64", TileAvx2F64, 4, true, [](const CpuFeatures& f) { return f.avx2 && f.fma; } },
+    { "sse2.f64", TileSse2F64, 2, true, [](const CpuFeatures& f) { return f.sse2; } },
+#endif
+#ifdef MANDEL_NEON
+    { "neon.f32", TileNeonF32, 4, false, [](const CpuFeatures& f) { return f.neon; } },
+    { "neon.f64", TileNeonF64, 2, true, [](const CpuFeatures& f) { return f.neon; } },
+#endif
+    { "scalar.f64", MandelTileScalar, 1, true, [](const CpuFeatures&) { return true; } },
+};
+
+int MandelKernelCount() { return (int)(sizeof(g_Kernels) / sizeof(g_Kernels[0])); }
+
+const MandelKernelInfo& MandelKernelAt(int index) { return g_Kernels[index]; }
+
+const MandelKernelInfo* FindMandelKernel(const char* name) {
+    for (const MandelKernelInfo& k : g_Kernels) {
+        if (strcmp(k.name, name) == 0) return k.supported(DetectCpuFeatures()) ? &k : nullptr;
+    }
+    return nullptr;
+}
+
+const MandelKernelInfo& SelectMandelKernel(bool doublePrecision) {
+    const char* pinned = getenv("BENCH_KERNEL");
+    if (pinned && *pinned) {
+        if (const MandelKernelInfo* k = FindMandelKernel(pinned)) return *k;
+    }
+    for (const MandelKernelInfo& k : g_Kernels) {
+        if (k.doublePrecision == doublePrecision && k.supported(DetectCpuFeatures())) return k;
+    }
+    return g_Kernels[MandelKernelCount() - 1];
+}
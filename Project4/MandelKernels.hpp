@@ -0,0 +1,36 @@
+#pragma once
+#include "MandelBench.hpp"
+
+// ---------------------------------------------------------
+//  MANDELBROT KERNELS
+//  One entry per ISA and precision. Detection uses CPUID plus XGETBV,
+//  so a kernel is only offered when the OS also saves its registers.
+//  f64 variants run the same double-precision math as the scalar
+//  kernel, so their scores compare like for like; f32 is the
+//  historical overlay score.
+// ---------------------------------------------------------
+struct CpuFeatures {
+    bool sse2 = false;
+    bool avx2 = false;      // AVX2 with OS YMM support
+    bool fma = false;
+    bool avx512f = false;   // AVX-512F with OS ZMM/opmask support
+    bool neon = false;
+};
+
+struct MandelKernelInfo {
+    const char* name;       // e.g. "avx512.f32"; also the override key
+    MandelKernel fn;
+    int lanes;
+    bool doublePrecision;
+    bool (*supported)(const CpuFeatures& f);
+};
+
+const CpuFeatures& DetectCpuFeatures();     // Probed once
+
+int MandelKernelCount();
+const MandelKernelInfo& MandelKernelAt(int index);
+// A kernel by name, or null if unknown or not supported on this CPU
+const MandelKernelInfo* FindMandelKernel(const char* name);
+// The widest supported kernel of the given precision. A BENCH_KERNEL
+// environment variable naming a supported kernel pins it instead.
+const MandelKernelInfo& SelectMandelKernel(bool doublePrecision = false);
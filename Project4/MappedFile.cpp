@@ -0,0 +1,60 @@
+#include "MappedFile.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+    HANDLE f = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER len;
+    if (!GetFileSizeEx(f, &len) || len.QuadPart == 0) { CloseHandle(f); return false; }
+    HANDLE m = CreateFileMappingW(f, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = m ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!view) {
+        if (m) CloseHandle(m);
+        CloseHandle(f);
+        return false;
+    }
+    fileHandle = f;
+    mapping = m;
+    data = (const uint8_t*)view;
+    size = (size_t)len.QuadPart;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) UnmapViewOfFile(data);
+    if (mapping) CloseHandle(mapping);
+    if (fileHandle) CloseHandle(fileHandle);
+    data = nullptr;
+    mapping = fileHandle = nullptr;
+    size = 0;
+}
+#else
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return false; }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps its own reference
+    if (view == MAP_FAILED) return false;
+    data = (const uint8_t*)view;
+    size = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) munmap((void*)data, size);
+    data = nullptr;
+    size = 0;
+}
+#endif
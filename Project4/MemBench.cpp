@@ -0,0 +1,385 @@
+#include "MemBench.hpp"
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <random>
+#include <thread>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#define MEM_NT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+const char* StreamKernelName(StreamKernel k) {
+    static const char* names[] = { "copy", "scale", "add", "triad" };
+    return names[(int)k];
+}
+
+// ---------------------------------------------------------
+//  TOPOLOGY AND PINNING
+// ---------------------------------------------------------
+std::vector<NumaNode> NumaTopology() {
+    std::vector<NumaNode> nodes;
+#ifdef _WIN32
+    ULONG highest = 0;
+    if (GetNumaHighestNodeNumber(&highest)) {
+        for (USHORT n = 0; n <= highest; n++) {
+            GROUP_AFFINITY ga = {};
+            if (!GetNumaNodeProcessorMaskEx(n, &ga) || !ga.Mask) continue;
+            NumaNode node; node.id = n;
+            for (int bit = 0; bit < 64; bit++) {
+                if (ga.Mask & (KAFFINITY(1) << bit)) node.cpus.push_back(ga.Group * 64 + bit);
+            }
+            nodes.push_back(std::move(node));
+        }
+    }
+#elif defined(__linux__)
+    for (int n = 0; n < 1024; n++) {
+        char path[96];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", n);
+        FILE* f = fopen(path, "r");
+        if (!f) { if (n > 0 && nodes.empty()) break; continue; }
+        char list[4096] = {};
+        size_t len = fread(list, 1, sizeof(list) - 1, f);
+        fclose(f);
+        list[len] = 0;
+        NumaNode node; node.id = n;
+        // "0-3,8-11"
+        for (char* p = list; *p && *p != '\n';) {
+            char* end;
+            long lo = strtol(p, &end, 10), hi = lo;
+            if (end == p) break;
+            if (*end == '-') hi = strtol(end + 1, &end, 10);
+            for (long c = lo; c <= hi; c++) node.cpus.push_back((int)c);
+            p = (*end == ',') ? end + 1 : end;
+        }
+        if (!node.cpus.empty()) nodes.push_back(std::move(node));
+    }
+#endif
+    if (nodes.empty()) {
+        NumaNode all;
+        int n = (std::max)(1, (int)std::thread::hardware_concurrency());
+        for (int i = 0; i < n; i++) all.cpus.push_back(i);
+        nodes.push_back(std::move(all));
+    }
+    return nodes;
+}
+
+bool PinCurrentThread(int cpu) {
+    if (cpu < 0) return false;
+#ifdef _WIN32
+    GROUP_AFFINITY ga = {};
+    ga.Group = (WORD)(cpu / 64);
+    ga.Mask = KAFFINITY(1) << (cpu % 64);
+    return SetThreadGroupAffinity(GetCurrentThread(), &ga, NULL) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// ---------------------------------------------------------
+//  WORKER TEAM
+//  Pinned threads parked on a barrier, so a timed pass pays for two
+//  barrier crossings instead of thread creation.
+// ---------------------------------------------------------
+class MemTeam {
+public:
+    explicit MemTeam(const std::vector<int>& cpus) : start((std::ptrdiff_t)cpus.size() + 1), done((std::ptrdiff_t)cpus.size() + 1) {
+        for (size_t i = 0; i < cpus.size(); i++) {
+            workers.emplace_back([this, i, cpu = cpus[i]]() {
+                PinCurrentThread(cpu);
+                for (;;) {
+                    start.arrive_and_wait();
+                    if (stop) return;
+                    (*job)((int)i);
+                    done.arrive_and_wait();
+                }
+            });
+        }
+    }
+
+    ~MemTeam() {
+        stop = true;
+        start.arrive_and_wait();
+        for (auto& t : workers) t.join();
+    }
+
+    int Size() const { return (int)workers.size(); }
+
+    // Seconds from release until the slowest worker finished
+    double Run(const std::function<void(int)>& fn) {
+        job = &fn;
+        start.arrive_and_wait();
+        auto t0 = std::chrono::steady_clock::now();
+        done.arrive_and_wait();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::barrier<> start, done;
+    const std::function<void(int)>* job = nullptr;
+    bool stop = false;      // Published by the start barrier
+};
+
+// ---------------------------------------------------------
+//  STREAM KERNELS
+//  Slices are whole cache lines, so every streaming store is aligned.
+// ---------------------------------------------------------
+static const double STREAM_SCALAR = 3.0;
+
+static void StreamPass(StreamKernel k, double* a, double* b, double* c, size_t begin, size_t end) {
+#ifdef MEM_NT_SSE2
+    const __m128d s = _mm_set1_pd(STREAM_SCALAR);
+    switch (k) {
+    case StreamKernel::Copy:
+        for (size_t i = begin; i < end; i += 2) _mm_stream_pd(c + i, _mm_load_pd(a + i));
+        break;
+    case StreamKernel::Scale:
+        for (size_t i = begin; i < end; i += 2) _mm_stream_pd(b + i, _mm_mul_pd(s, _mm_load_pd(c + i)));
+        break;
+    case StreamKernel::Add:
+        for (size_t i = begin; i < end; i += 2) _mm_stream_pd(c + i, _mm_add_pd(_mm_load_pd(a + i), _mm_load_pd(b + i)));
+        break;
+    default:
+        for (size_t i = begin; i < end; i += 2) _mm_stream_pd(a + i, _mm_add_pd(_mm_load_pd(b + i), _mm_mul_pd(s, _mm_load_pd(c + i))));
+        break;
+    }
+    _mm_sfence();   // Streaming stores are weakly ordered; drain before the barrier
+#else
+    switch (k) {
+    case StreamKernel::Copy: for (size_t i = begin; i < end; i++) c[i] = a[i]; break;
+    case StreamKernel::Scale: for (size_t i = begin; i < end; i++) b[i] = STREAM_SCALAR * c[i]; break;
+    case StreamKernel::Add: for (size_t i = begin; i < end; i++) c[i] = a[i] + b[i]; break;
+    default: for (size_t i = begin; i < end; i++) a[i] = b[i] + STREAM_SCALAR * c[i]; break;
+    }
+#endif
+}
+
+static double StreamBytes(StreamKernel k, size_t n) {
+    return (k == StreamKernel::Copy || k == StreamKernel::Scale ? 2.0 : 3.0) * sizeof(double) * n;
+}
+
+struct StreamArrays {
+    size_t n = 0;
+    double* a = nullptr;
+    double* b = nullptr;
+    double* c = nullptr;
+
+    StreamArrays(size_t count) : n(count) {
+        a = (double*)::operator new(n * sizeof(double), std::align_val_t(64));
+        b = (double*)::operator new(n * sizeof(double), std::align_val_t(64));
+        c = (double*)::operator new(n * sizeof(double), std::align_val_t(64));
+    }
+    ~StreamArrays() {
+        ::operator delete(a, std::align_val_t(64));
+        ::operator delete(b, std::align_val_t(64));
+        ::operator delete(c, std::align_val_t(64));
+    }
+    StreamArrays(const StreamArrays&) = delete;
+    StreamArrays& operator=(const StreamArrays&) = delete;
+
+    // Worker i's cache-line-aligned slice
+    void Slice(int i, int workers, size_t& begin, size_t& end) const {
+        size_t lines = n / 8;
+        begin = lines * i / workers * 8;
+        end = lines * (i + 1) / workers * 8;
+    }
+};
+
+// Initialises the arrays from the workers that will stream them (first touch)
+static void StreamInit(MemTeam& team, StreamArrays& arr) {
+    team.Run([&](int id) {
+        size_t begin, end;
+        arr.Slice(id, team.Size(), begin, end);
+        for (size_t i = begin; i < end; i++) { arr.a[i] = 1.0; arr.b[i] = 2.0; arr.c[i] = 0.0; }
+    });
+}
+
+static double StreamRun(MemTeam& team, StreamArrays& arr, StreamKernel k) {
+    double seconds = team.Run([&](int id) {
+        size_t begin, end;
+        arr.Slice(id, team.Size(), begin, end);
+        StreamPass(k, arr.a, arr.b, arr.c, begin, end);
+    });
+    return seconds > 0.0 ? StreamBytes(k, arr.n) / seconds / 1e9 : 0.0;
+}
+
+// STREAM's checkSTREAMresults: replay the passes on scalars and compare a sample of elements
+static bool StreamCheck(const StreamArrays& arr, int passes) {
+    double aj = 1.0, bj = 2.0, cj = 0.0;
+    for (int i = 0; i < passes; i++) {
+        cj = aj;
+        bj = STREAM_SCALAR * cj;
+        cj = aj + bj;
+        aj = bj + STREAM_SCALAR * cj;
+    }
+    size_t step = (std::max)(arr.n / 4099, size_t(1));
+    for (size_t i = 0; i < arr.n; i += step) {
+        if (std::fabs(arr.a[i] - aj) > 1e-13 * aj || std::fabs(arr.b[i] - bj) > 1e-13 * bj || std::fabs(arr.c[i] - cj) > 1e-13 * cj) return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------
+//  LATENCY
+//  One pointer per cache line, linked in a single random cycle
+//  (Sattolo), so neither the prefetchers nor the out-of-order core can
+//  run ahead. Pages are ordinary 4 KiB ones, so the DRAM end of the
+//  curve includes TLB misses, as application loads would.
+// ---------------------------------------------------------
+static void* volatile s_ChaseSink;
+
+static double ChaseNs(void** buffer, size_t bytes, std::mt19937_64& rng) {
+    const size_t stride = 64 / sizeof(void*);
+    size_t lines = bytes / 64;
+    std::vector<uint32_t> order(lines);
+    for (size_t i = 0; i < lines; i++) order[i] = (uint32_t)i;
+    for (size_t i = lines - 1; i > 0; i--) std::swap(order[i], order[std::uniform_int_distribution<size_t>(0, i - 1)(rng)]);
+    for (size_t i = 0; i < lines; i++) buffer[order[i] * stride] = &buffer[order[(i + 1) % lines] * stride];
+
+    void** p = buffer;
+    for (size_t i = 0; i < lines; i++) p = (void**)*p;     // Warm the caches and TLB for this size
+
+    size_t loads = (std::max)(size_t(1) << 21, lines) / 8 * 8;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < loads; i += 8) {
+        p = (void**)*p; p = (void**)*p; p = (void**)*p; p = (void**)*p;
+        p = (void**)*p; p = (void**)*p; p = (void**)*p; p = (void**)*p;
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    s_ChaseSink = p;    // Keeps the chain live
+    return ns / loads;
+}
+
+// ---------------------------------------------------------
+//  DRIVER
+// ---------------------------------------------------------
+// 'count' CPUs taken round-robin across nodes
+static std::vector<int> SpreadCpus(const std::vector<NumaNode>& nodes, int count) {
+    std::vector<int> cpus;
+    for (size_t i = 0; (int)cpus.size() < count; i++) {
+        bool any = false;
+        for (const NumaNode& n : nodes) {
+            if (i < n.cpus.size()) { cpus.push_back(n.cpus[i]); any = true; }
+            if ((int)cpus.size() == count) break;
+        }
+        if (!any) break;
+    }
+    return cpus;
+}
+
+MemBenchResult RunMemBenchmark(const MemBenchConfig& cfg, const std::function<void(int, int)>& progress) {
+    MemBenchResult r;
+    std::vector<NumaNode> nodes = NumaTopology();
+    int totalCpus = 0;
+    for (const NumaNode& n : nodes) totalCpus += (int)n.cpus.size();
+    r.nodes = (int)nodes.size();
+#ifdef MEM_NT_SSE2
+    r.nonTemporal = true;
+#endif
+
+    int warmup = (std::max)(cfg.harness.warmup, 0), reps = (std::max)(cfg.harness.repetitions, 1);
+    int latencySteps = 0;
+    for (size_t b = cfg.latencyMinBytes; b <= cfg.latencyMaxBytes; b *= 2) latencySteps++;
+    std::vector<std::pair<int, int>> scalingRuns;   // (node index, threads)
+    if (cfg.scaling) {
+        for (size_t n = 0; n < nodes.size(); n++) {
+            int cpus = (int)nodes[n].cpus.size();
+            for (int t = 1; t < cpus; t *= 2) scalingRuns.push_back({ (int)n, t });
+            scalingRuns.push_back({ (int)n, cpus });
+        }
+    }
+    int total = (warmup + reps) + latencySteps + (int)scalingRuns.size(), done = 0;
+    auto step = [&]() { if (progress) progress(++done, total); };
+
+    // STREAM on the full team. Each pass runs the four kernels in order, as STREAM does.
+    {
+        r.threads = cfg.threads > 0 ? (std::min)(cfg.threads, totalCpus) : totalCpus;
+        MemTeam team(SpreadCpus(nodes, r.threads));
+        StreamArrays arr(cfg.streamBytes / sizeof(double) / 8 * 8);
+        StreamInit(team, arr);
+        std::vector<double> samples[(int)StreamKernel::Count];
+        for (int pass = 0; pass < warmup + reps; pass++) {
+            for (int k = 0; k < (int)StreamKernel::Count; k++) {
+                double gbs = StreamRun(team, arr, (StreamKernel)k);
+                if (pass >= warmup) samples[k].push_back(gbs);
+            }
+            step();
+        }
+        for (int k = 0; k < (int)StreamKernel::Count; k++) r.stream[k] = SummarizeSamples(samples[k], cfg.harness.outlierCutoff);
+        r.valid = StreamCheck(arr, warmup + reps);
+    }
+
+    // Latency from one thread; a fixed seed keeps the chain identical run to run
+    {
+        PinCurrentThread(nodes[0].cpus[0]);
+        size_t bytes = cfg.latencyMaxBytes;
+        void** buffer = (void**)::operator new(bytes, std::align_val_t(4096));
+        std::mt19937_64 rng(0x5EED);
+        for (size_t b = cfg.latencyMinBytes; b <= cfg.latencyMaxBytes; b *= 2) {
+            r.latency.push_back({ b, ChaseNs(buffer, b, rng) });
+            step();
+        }
+        ::operator delete(buffer, std::align_val_t(4096));
+    }
+
+    // Triad scaling inside each node, on arrays first-touched by that node's threads
+    for (const auto& run : scalingRuns) {
+        const NumaNode& node = nodes[run.first];
+        MemTeam team(std::vector<int>(node.cpus.begin(), node.cpus.begin() + run.second));
+        StreamArrays arr(cfg.streamBytes / sizeof(double) / 8 * 8);
+        StreamInit(team, arr);
+        std::vector<double> samples;
+        for (int pass = 0; pass < warmup + reps; pass++) {
+            double gbs = StreamRun(team, arr, StreamKernel::Triad);
+            if (pass >= warmup) samples.push_back(gbs);
+        }
+        r.scaling.push_back({ node.id, run.second, SummarizeSamples(samples, cfg.harness.outlierCutoff).median });
+        step();
+    }
+    return r;
+}
+
+void MemBenchToRecord(const MemBenchConfig& cfg, const MemBenchResult& r, BenchRecord& out) {
+    out.benchmark = "mem.stream";
+    out.build = BenchBuildString();
+    out.kernel = r.nonTemporal ? "stream.nt-sse2" : "stream.scalar";
+    out.threads = r.threads;
+    out.config = cfg.harness;
+    out.workPerRun = (uint64_t)StreamBytes(StreamKernel::Triad, cfg.streamBytes / sizeof(double) / 8 * 8);
+    out.workConsistent = r.valid;
+    out.summary = r.stream[(int)StreamKernel::Triad];
+    out.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    char name[64];
+    for (int k = 0; k < (int)StreamKernel::Count; k++) {
+        snprintf(name, sizeof(name), "%s_gbs", StreamKernelName((StreamKernel)k));
+        out.metrics.push_back({ name, r.stream[k].median });
+    }
+    out.metrics.push_back({ "array_mib", (double)(cfg.streamBytes >> 20) });
+    out.metrics.push_back({ "numa_nodes", (double)r.nodes });
+    for (const LatencyPoint& p : r.latency) {
+        snprintf(name, sizeof(name), "latency_%zuk_ns", p.bytes >> 10);
+        out.metrics.push_back({ name, p.ns });
+    }
+    for (const ScalingPoint& p : r.scaling) {
+        snprintf(name, sizeof(name), "node%d_t%d_triad_gbs", p.node, p.threads);
+        out.metrics.push_back({ name, p.gbs });
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "BenchHarness.hpp"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// ---------------------------------------------------------
+//  MEMORY BENCHMARK
+//  STREAM copy/scale/add/triad over arrays far larger than the caches,
+//  written with non-temporal stores so no read-for-ownership traffic is
+//  hidden in the figures; a pointer chase through a random cycle for
+//  load-to-use latency at each working-set size; and triad bandwidth
+//  per NUMA node as the thread count doubles. Worker threads are pinned
+//  and first-touch their own slice, so pages land on the node that uses them.
+// ---------------------------------------------------------
+enum class StreamKernel : uint8_t { Copy, Scale, Add, Triad, Count };
+
+const char* StreamKernelName(StreamKernel k);
+
+struct NumaNode {
+    int id = 0;
+    std::vector<int> cpus;      // Logical processor numbers (group * 64 + bit on Windows)
+};
+
+// One node holding every CPU when the OS reports no topology
+std::vector<NumaNode> NumaTopology();
+bool PinCurrentThread(int cpu);
+
+struct MemBenchConfig {
+    size_t streamBytes = size_t(64) << 20;          // Per array; STREAM asks for 4x the last-level cache
+    int threads = 0;                                // 0 = every CPU, spread across nodes
+    BenchHarnessConfig harness = { 1, 5, 3.5 };
+    size_t latencyMinBytes = size_t(4) << 10;
+    size_t latencyMaxBytes = size_t(256) << 20;
+    bool scaling = true;
+};
+
+struct LatencyPoint {
+    size_t bytes;
+    double ns;                  // Per dependent load
+};
+
+struct ScalingPoint {
+    int node;
+    int threads;
+    double gbs;                 // Triad median
+};
+
+struct MemBenchResult {
+    int threads = 0;
+    bool nonTemporal = false;   // False where the ISA has no streaming store path
+    bool valid = true;          // STREAM's own check of the final array contents
+    BenchSummary stream[(int)StreamKernel::Count];     // GB/s, 1e9 bytes
+    std::vector<LatencyPoint> latency;
+    std::vector<ScalingPoint> scaling;
+    int nodes = 1;
+};
+
+MemBenchResult RunMemBenchmark(const MemBenchConfig& cfg, const std::function<void(int done, int total)>& progress = nullptr);
+
+// Fills a "mem.stream" record: triad is the headline median, everything else goes to metrics
+void MemBenchToRecord(const MemBenchConfig& cfg, const MemBenchResult& r, BenchRecord& out);
@@ -0,0 +1,258 @@
+#include "MemTest.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define MEMTEST_STREAM 1
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+uint64_t AvailablePhysicalMemory() {
+#ifdef _WIN32
+    MEMORYSTATUSEX m; m.dwLength = sizeof(m);
+    return GlobalMemoryStatusEx(&m) ? m.ullAvailPhys : 0;
+#elif defined(__linux__)
+    FILE* f = fopen("/proc/meminfo", "r");
+    if (!f) return 0;
+    char line[128];
+    unsigned long long kb = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "MemAvailable: %llu kB", &kb) == 1) break;
+    }
+    fclose(f);
+    return kb * 1024;
+#else
+    return 0;
+#endif
+}
+
+std::string FormatMemTestError(const MemTestError& e) {
+    uint64_t bits = e.FlippedBits();
+    int lowest = 0, count = 0;
+    for (int b = 63; b >= 0; b--) {
+        if (bits & (uint64_t(1) << b)) { lowest = b; count++; }
+    }
+    char buf[160];
+    snprintf(buf, sizeof(buf), "0x%016llx bit %d%s (expected %016llx, read %016llx, %s, pass %d)",
+        (unsigned long long)e.address, lowest, count > 1 ? " and others" : "", (unsigned long long)e.expected,
+        (unsigned long long)e.actual, e.pattern, e.pass);
+    std::string s = buf;
+    if (count > 1) s += ", " + std::to_string(count) + " bits";
+    return s;
+}
+
+// ---------------------------------------------------------
+//  ACCESS PRIMITIVES
+//  Reads go through volatile so the compiler cannot forward the value
+//  it just stored; streaming stores drain with a fence before verifying.
+// ---------------------------------------------------------
+static inline void Put(uint64_t* p, uint64_t v) {
+#ifdef MEMTEST_STREAM
+    _mm_stream_si64((long long*)p, (long long)v);
+#else
+    *(volatile uint64_t*)p = v;
+#endif
+}
+
+static inline void Drain() {
+#ifdef MEMTEST_STREAM
+    _mm_sfence();
+#endif
+}
+
+static inline uint64_t Get(const uint64_t* p) { return *(const volatile uint64_t*)p; }
+
+static inline uint64_t Rotl(uint64_t v, int s) { s &= 63; return s ? (v << s) | (v >> (64 - s)) : v; }
+
+static inline uint64_t SplitMix(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Words per stop check and progress update (1 MiB)
+static const size_t BLOCK_WORDS = (size_t(1) << 20) / sizeof(uint64_t);
+
+void MemTester::Report(const uint64_t* at, uint64_t expected, uint64_t actual, const char* pattern, int pass) {
+    errorCount.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(errorMutex);
+    if (errors.size() < MAX_KEPT_ERRORS) errors.push_back({ (uintptr_t)at, expected, actual, pattern, pass });
+}
+
+inline bool MemTester::Check(const uint64_t* at, uint64_t expected, const char* pattern, int pass) {
+    uint64_t v = Get(at);
+    if (v == expected) return true;
+    Report(at, expected, v, pattern, pass);
+    return false;
+}
+
+void MemTester::Worker(int index, uint64_t* base, size_t words) {
+    for (int pass = 0; !stop && (config.passes <= 0 || pass < config.passes); pass++) {
+        // Walking ones, then zeros: word i holds a single bit that rotates with the address and
+        // the pass, so over 64 passes every bit of every word sees both states on each data line
+        for (int invert = 0; invert < 2 && !stop; invert++) {
+            const char* name = invert ? "walking-zeros" : "walking-ones";
+            uint64_t mask = invert ? ~uint64_t(0) : 0;
+            for (size_t b = 0; b < words && !stop; b += BLOCK_WORDS) {
+                size_t e = (std::min)(words, b + BLOCK_WORDS);
+                for (size_t i = b; i < e; i++) Put(base + i, Rotl(1, (int)(i + pass)) ^ mask);
+            }
+            Drain();
+            for (size_t b = 0; b < words && !stop; b += BLOCK_WORDS) {
+                size_t e = (std::min)(words, b + BLOCK_WORDS);
+                for (size_t i = b; i < e; i++) Check(base + i, Rotl(1, (int)(i + pass)) ^ mask, name, pass);
+                verified.fetch_add((e - b) * sizeof(uint64_t), std::memory_order_relaxed);
+            }
+        }
+
+        // Moving inversions: fill p; ascending verify p / write ~p; descending verify ~p / write p.
+        // The descending sweep catches coupling faults the ascending one cannot.
+        uint64_t seedState = config.seed + (uint64_t)pass;
+        uint64_t p = (pass % 3 == 0) ? 0 : (pass % 3 == 1) ? 0x5555555555555555ull : SplitMix(seedState);
+        for (size_t b = 0; b < words && !stop; b += BLOCK_WORDS) {
+            size_t e = (std::min)(words, b + BLOCK_WORDS);
+            for (size_t i = b; i < e; i++) Put(base + i, p);
+        }
+        Drain();
+        for (size_t b = 0; b < words && !stop; b += BLOCK_WORDS) {
+            size_t e = (std::min)(words, b + BLOCK_WORDS);
+            for (size_t i = b; i < e; i++) { Check(base + i, p, "moving-inversions", pass); base[i] = ~p; }
+        }
+        for (size_t b = words; b > 0 && !stop;) {
+            size_t s = b > BLOCK_WORDS ? b - BLOCK_WORDS : 0;
+            for (size_t i = b; i-- > s;) { Check(base + i, ~p, "moving-inversions", pass); base[i] = p; }
+            verified.fetch_add((b - s) * sizeof(uint64_t), std::memory_order_relaxed);
+            b = s;
+        }
+
+        // Random with seed: the sequence depends on seed, pass and slice, so a rerun
+        // with the same seed writes the same data to the same offsets
+        uint64_t start = config.seed ^ ((uint64_t)pass << 32) ^ (uint64_t)index * 0x9E3779B97F4A7C15ull;
+        uint64_t state = start;
+        for (size_t b = 0; b < words && !stop; b += BLOCK_WORDS) {
+            size_t e = (std::min)(words, b + BLOCK_WORDS);
+            for (size_t i = b; i < e; i++) Put(base + i, SplitMix(state));
+        }
+        Drain();
+        state = start;
+        for (size_t b = 0; b < words && !stop; b += BLOCK_WORDS) {
+            size_t e = (std::min)(words, b + BLOCK_WORDS);
+            for (size_t i = b; i < e; i++) Check(base + i, SplitMix(state), "random", pass);
+            verified.fetch_add((e - b) * sizeof(uint64_t), std::memory_order_relaxed);
+        }
+
+        if (!stop) passes[index].store(pass + 1, std::memory_order_relaxed);
+    }
+    finishedWorkers.fetch_add(1);
+}
+
+// ---------------------------------------------------------
+//  ALLOCATION
+// ---------------------------------------------------------
+static uint64_t* AllocateRegion(size_t bytes) {
+#ifdef _WIN32
+    return (uint64_t*)VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif defined(__linux__)
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? nullptr : (uint64_t*)p;
+#else
+    return (uint64_t*)::operator new(bytes, std::nothrow);
+#endif
+}
+
+static void FreeRegion(uint64_t* p, size_t bytes, bool locked) {
+#ifdef _WIN32
+    if (locked) VirtualUnlock(p, bytes);
+    VirtualFree(p, 0, MEM_RELEASE);
+#elif defined(__linux__)
+    if (locked) munlock(p, bytes);
+    munmap(p, bytes);
+#else
+    (void)bytes; (void)locked;
+    ::operator delete(p);
+#endif
+}
+
+// Pinning keeps the tested pages resident, so a pass cannot page out and back in under the test
+static bool LockRegion(void* p, size_t bytes) {
+#ifdef _WIN32
+    SIZE_T minWs = 0, maxWs = 0;
+    HANDLE self = GetCurrentProcess();
+    if (!GetProcessWorkingSetSize(self, &minWs, &maxWs)) return false;
+    if (!SetProcessWorkingSetSize(self, minWs + bytes, maxWs + bytes)) return false;
+    if (VirtualLock(p, bytes)) return true;
+    SetProcessWorkingSetSize(self, minWs, maxWs);
+    return false;
+#elif defined(__linux__)
+    return mlock(p, bytes) == 0;    // Needs CAP_IPC_LOCK or a large enough RLIMIT_MEMLOCK
+#else
+    (void)p; (void)bytes;
+    return false;
+#endif
+}
+
+bool MemTester::Start(const MemTestConfig& cfg) {
+    Stop();
+    config = cfg;
+    int threads = cfg.threads > 0 ? cfg.threads : (std::max)(1, (int)std::thread::hardware_concurrency());
+    double fraction = (std::min)((std::max)(cfg.freeFraction, 0.0), 0.9);
+    uint64_t bytes = (uint64_t)(AvailablePhysicalMemory() * fraction);
+    if (cfg.maxBytes) bytes = (std::min)(bytes, cfg.maxBytes);
+    const uint64_t slice = uint64_t(1) << 20;
+    bytes = bytes / (slice * threads) * (slice * threads);
+    if (bytes == 0) return false;
+
+    regionBytes = (size_t)bytes;
+    region = AllocateRegion(regionBytes);
+    if (!region) { regionBytes = 0; return false; }
+    locked = cfg.lockPages && LockRegion(region, regionBytes);
+
+    stop = false;
+    finishedWorkers = 0;
+    verified = 0;
+    errorCount = 0;
+    errors.clear();
+    passes.reset(new std::atomic<int>[threads]);
+    size_t words = regionBytes / sizeof(uint64_t) / threads;
+    for (int i = 0; i < threads; i++) {
+        passes[i] = 0;
+        workers.emplace_back(&MemTester::Worker, this, i, region + words * i, words);
+    }
+    return true;
+}
+
+void MemTester::Stop() {
+    stop = true;
+    for (auto& t : workers) t.join();
+    workers.clear();
+    if (region) FreeRegion(region, regionBytes, locked);
+    region = nullptr;
+    regionBytes = 0;
+    locked = false;
+}
+
+MemTestStatus MemTester::Status() const {
+    MemTestStatus s;
+    s.running = !workers.empty() && !Finished();
+    s.locked = locked;
+    s.threads = (int)workers.size();
+    s.bytes = regionBytes;
+    s.bytesVerified = verified.load(std::memory_order_relaxed);
+    s.errors = errorCount.load(std::memory_order_relaxed);
+    s.passesDone = workers.empty() ? 0 : INT32_MAX;
+    for (size_t i = 0; i < workers.size(); i++) s.passesDone = (std::min)(s.passesDone, passes[i].load(std::memory_order_relaxed));
+    return s;
+}
+
+std::vector<MemTestError> MemTester::Errors() const {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    return errors;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------
+//  MEMORY TEST
+//  Takes a bounded share of free physical memory, locks it where the OS
+//  allows, and has one thread per slice cycle through pattern passes:
+//  walking ones/zeros, moving inversions and a seeded random fill. Fills
+//  use streaming stores so the verify reads come back from DRAM, not
+//  the caches. Any mismatch is kept with its (virtual) address and the
+//  bits that flipped.
+// ---------------------------------------------------------
+struct MemTestConfig {
+    double freeFraction = 0.5;      // Of currently available memory; clamped to 0.9
+    uint64_t maxBytes = 0;          // Hard cap; 0 = none
+    int threads = 0;                // 0 = one per logical processor
+    bool lockPages = true;
+    uint64_t seed = 0x5EED5EED;
+    int passes = 0;                 // 0 = until Stop()
+};
+
+struct MemTestError {
+    uintptr_t address;
+    uint64_t expected;
+    uint64_t actual;
+    const char* pattern;
+    int pass;
+    uint64_t FlippedBits() const { return expected ^ actual; }
+};
+
+struct MemTestStatus {
+    bool running = false;
+    bool locked = false;            // False when the lock was refused; the test still runs
+    int threads = 0;
+    uint64_t bytes = 0;
+    uint64_t bytesVerified = 0;     // Cumulative, across passes and patterns
+    int passesDone = 0;             // Completed by every thread
+    uint64_t errors = 0;
+};
+
+// MemAvailable / ullAvailPhys
+uint64_t AvailablePhysicalMemory();
+// "0x00007f12345678a8 bit 17" (lowest flipped bit), plus the count if more flipped
+std::string FormatMemTestError(const MemTestError& e);
+
+class MemTester {
+public:
+    MemTester() = default;
+    ~MemTester() { Stop(); }
+    MemTester(const MemTester&) = delete;
+    MemTester& operator=(const MemTester&) = delete;
+
+    // Allocates, locks and starts the workers. False if nothing could be allocated.
+    bool Start(const MemTestConfig& cfg);
+    // Stops the workers at the next block boundary and releases the memory
+    void Stop();
+    // True once every worker finished its configured passes
+    bool Finished() const { return finishedWorkers.load() == (int)workers.size() && !workers.empty(); }
+
+    MemTestStatus Status() const;
+    // The first MAX_KEPT_ERRORS mismatches; Status().errors has the full count
+    std::vector<MemTestError> Errors() const;
+
+    static constexpr size_t MAX_KEPT_ERRORS = 256;
+
+private:
+    void Worker(int index, uint64_t* begin, size_t words);
+    void Report(const uint64_t* at, uint64_t expected, uint64_t actual, const char* pattern, int pass);
+    bool Check(const uint64_t* at, uint64_t expected, const char* pattern, int pass);
+
+    MemTestConfig config;
+    uint64_t* region = nullptr;
+    size_t regionBytes = 0;
+    bool locked = false;
+    std::vector<std::thread> workers;
+    std::unique_ptr<std::atomic<int>[]> passes;     // Per worker
+    std::atomic<bool> stop{ false };
+    std::atomic<int> finishedWorkers{ 0 };
+    std::atomic<uint64_t> verified{ 0 };
+    std::atomic<uint64_t> errorCount{ 0 };
+    mutable std::mutex errorMutex;
+    std::vector<MemTestError> errors;
+};
@@ -0,0 +1,164 @@
+#include "Nct6687.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NCT_X86 1
+#endif
+
+// One back-off step between polls of the page port
+static void SpinBackoff() {
+#ifdef NCT_X86
+    for (int i = 0; i < 100; i++) _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+static void WaitPageIdle(IPortIo& io, int pagePort) {
+    // Spin wait for access
+    int timeout = 1000;
+    while (io.In8(pagePort) != 0xFF && timeout > 0) {
+        SpinBackoff();
+        timeout--;
+    }
+    if (timeout <= 0) io.Out8(pagePort, 0xFF); // Force
+}
+
+int ReadNct6687_EC(IPortIo& io, int baseAddr, int logicalAddress) {
+    if (baseAddr == 0) return 0;
+    int pagePort = baseAddr + 0x04;
+    int indexPort = baseAddr + 0x05;
+    int dataPort = baseAddr + 0x06;
+
+    WaitPageIdle(io, pagePort);
+    io.Out8(pagePort, (logicalAddress >> 8) & 0xFF);
+    io.Out8(indexPort, logicalAddress & 0xFF);
+    int result = io.In8(dataPort);
+    io.Out8(pagePort, 0xFF);
+    return result;
+}
+
+void WriteNct6687_EC(IPortIo& io, int baseAddr, int logicalAddress, int value) {
+    if (baseAddr == 0) return;
+    int pagePort = baseAddr + 0x04;
+    int indexPort = baseAddr + 0x05;
+    int dataPort = baseAddr + 0x06;
+
+    WaitPageIdle(io, pagePort);
+    io.Out8(pagePort, (logicalAddress >> 8) & 0xFF);
+    io.Out8(indexPort, logicalAddress & 0xFF);
+    io.Out8(dataPort, value & 0xFF);
+    io.Out8(pagePort, 0xFF);
+}
+
+int ReadNct6687_Block(IPortIo& io, int baseAddr, int startReg, int count, uint8_t out[]) {
+    if (baseAddr == 0 || count <= 0) return 0;
+    int pagePort = baseAddr + 0x04;
+    int indexPort = baseAddr + 0x05;
+    int dataPort = baseAddr + 0x06;
+
+    // Clamp to the page we selected
+    int page = (startReg >> 8) & 0xFF;
+    count = (std::min)(count, 0x100 - (startReg & 0xFF));
+
+    WaitPageIdle(io, pagePort);
+    io.Out8(pagePort, page);
+    for (int i = 0; i < count; i++) {
+        io.Out8(indexPort, (startReg + i) & 0xFF);
+        out[i] = io.In8(dataPort);
+    }
+    io.Out8(pagePort, 0xFF);
+    return count;
+}
+
+bool PlanNct6687_Sweep(const uint16_t* regs, int count, NctSweepPlan& plan) {
+    plan = NctSweepPlan();
+    if (count > NCT_MAX_SENSORS) return false;
+
+    uint16_t sorted[NCT_MAX_SENSORS];
+    std::copy(regs, regs + count, sorted);
+    std::sort(sorted, sorted + count);
+
+    // Merge [reg, reg + 1] spans that touch or overlap and share a page
+    for (int i = 0; i < count; i++) {
+        uint16_t reg = sorted[i];
+        uint16_t end = reg + 2;
+        if ((reg & 0xFF) == 0xFF) return false; // 16-bit value would straddle pages
+        NctRun* last = plan.runCount ? &plan.runs[plan.runCount - 1] : nullptr;
+        if (last && (last->startReg >> 8) == (reg >> 8) && reg <= last->startReg + last->count) {
+            last->count = (std::max)((int)last->count, end - last->startReg);
+            continue;
+        }
+        if (plan.runCount == NCT_MAX_RUNS) return false;
+        plan.runs[plan.runCount++] = { reg, 2, 0 };
+    }
+
+    for (int r = 0; r < plan.runCount; r++) {
+        plan.runs[r].bufOffset = (uint16_t)plan.byteCount;
+        plan.byteCount += plan.runs[r].count;
+    }
+    if (plan.byteCount > NCT_MAX_SWEEP_BYTES) return false;
+
+    // Resolve each caller sensor to its offset in the packed buffer
+    for (int i = 0; i < count; i++) {
+        for (int r = 0; r < plan.runCount; r++) {
+            const NctRun& run = plan.runs[r];
+            if (regs[i] >= run.startReg && regs[i] + 2 <= run.startReg + run.count) {
+                plan.offsets[i] = run.bufOffset + (regs[i] - run.startReg);
+                break;
+            }
+        }
+    }
+    plan.sensorCount = count;
+    return true;
+}
+
+void ReadNct6687_Sweep(IPortIo& io, int baseAddr, const NctSweepPlan& plan, uint8_t out[]) {
+    if (baseAddr == 0 || plan.runCount == 0) return;
+    int pagePort = baseAddr + 0x04;
+    int indexPort = baseAddr + 0x05;
+    int dataPort = baseAddr + 0x06;
+
+    WaitPageIdle(io, pagePort);
+    int curPage = -1;
+    for (int r = 0; r < plan.runCount; r++) {
+        const NctRun& run = plan.runs[r];
+        int page = run.startReg >> 8;
+        if (page != curPage) { io.Out8(pagePort, page); curPage = page; }
+        for (int i = 0; i < run.count; i++) {
+            io.Out8(indexPort, (run.startReg + i) & 0xFF);
+            out[run.bufOffset + i] = io.In8(dataPort);
+        }
+    }
+    io.Out8(pagePort, 0xFF);
+}
+
+// ---------------------------------------------------------
+//  FAN OUTPUT
+// ---------------------------------------------------------
+constexpr int NCT_FAN_MODE = 0xA00;
+constexpr int NCT_FAN_REQUEST = 0xA01;
+constexpr int NCT_FAN_PWM = 0xA28;
+
+bool Nct6687FanWriter::WritePwm(uint32_t mask, const uint8_t* pwm) {
+    mask &= (1u << NCT_FAN_CHANNELS) - 1;
+    if (!io || baseAddr == 0 || !mask) return false;
+    auto settle = [this]() { if (settleMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(settleMs)); };
+
+    { std::lock_guard<std::mutex> lock(ioMutex); WriteNct6687_EC(*io, baseAddr, NCT_FAN_REQUEST, 0x80); }
+    settle();
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        int mode = ReadNct6687_EC(*io, baseAddr, NCT_FAN_MODE);
+        if ((mode & mask) != mask) WriteNct6687_EC(*io, baseAddr, NCT_FAN_MODE, mode | mask);
+        for (int i = 0; i < NCT_FAN_CHANNELS; i++) {
+            if (mask & (1u << i)) WriteNct6687_EC(*io, baseAddr, NCT_FAN_PWM + i, pwm[i]);
+        }
+        WriteNct6687_EC(*io, baseAddr, NCT_FAN_REQUEST, 0x40);
+    }
+    settle();
+    return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "FanControl.hpp"
+#include "PortIo.hpp"
+#include <mutex>
+
+// ---------------------------------------------------------
+//  NCT6687D EC PROTOCOL
+//  Page/index/data access at base + 4/5/6. The page port reads 0xFF
+//  while the EC is idle and must be handed back as 0xFF when done.
+//  These helpers do no locking; callers hold g_IoMutex.
+// ---------------------------------------------------------
+constexpr int NCT_MAX_RUNS = 16;
+constexpr int NCT_MAX_SENSORS = 32;
+constexpr int NCT_MAX_SWEEP_BYTES = 256;
+
+struct NctRun {
+    uint16_t startReg = 0;
+    uint16_t count = 0;
+    uint16_t bufOffset = 0;     // Where this run lands in the sweep buffer
+};
+
+// Contiguous runs covering a set of 16-bit sensor registers.
+// offsets[i] is the sweep-buffer offset of the high byte of sensor i.
+struct NctSweepPlan {
+    NctRun runs[NCT_MAX_RUNS];
+    int runCount = 0;
+    int byteCount = 0;
+    uint16_t offsets[NCT_MAX_SENSORS] = {};
+    int sensorCount = 0;
+};
+
+int ReadNct6687_EC(IPortIo& io, int baseAddr, int logicalAddress);
+void WriteNct6687_EC(IPortIo& io, int baseAddr, int logicalAddress, int value);
+
+// One page select, then index/data pairs for each byte. Returns bytes read.
+int ReadNct6687_Block(IPortIo& io, int baseAddr, int startReg, int count, uint8_t out[]);
+
+// Group 16-bit sensor registers (reg, reg + 1) into runs. Runs never cross a page.
+bool PlanNct6687_Sweep(const uint16_t* regs, int count, NctSweepPlan& plan);
+
+// Execute a plan: one idle-wait, one page select per page touched, page released once.
+void ReadNct6687_Sweep(IPortIo& io, int baseAddr, const NctSweepPlan& plan, uint8_t out[]);
+
+// Decoders for the raw high/low byte pairs
+inline float DecodeNct6687_Temp(uint8_t val, uint8_t frac) { return (float)val + ((frac & 0x80) ? 0.5f : 0.0f); }
+inline float DecodeNct6687_Voltage(uint8_t high, uint8_t low, float multiplier) { return 0.001f * ((high << 4) | (low >> 4)) * multiplier; }
+inline int DecodeNct6687_Fan(uint8_t high, uint8_t low) { return (high << 8) | low; }
+
+// ---------------------------------------------------------
+//  NCT6687D FAN OUTPUT
+//  0xA00 is the manual-mode bitmask, 0xA28 + n the duty of fan n, and
+//  0xA01 takes 0x80 (request) / 0x40 (commit) around an update. The EC
+//  needs ~20 ms after each; those waits happen without the I/O lock,
+//  so the sensor sweep keeps running while a batch settles.
+// ---------------------------------------------------------
+constexpr int NCT_FAN_CHANNELS = 6;
+constexpr int NCT_FAN_SETTLE_MS = 20;
+
+class Nct6687FanWriter : public IFanWriter {
+public:
+    Nct6687FanWriter(IPortIo*& io, std::mutex& ioMutex, const int& baseAddr, int settleMs = NCT_FAN_SETTLE_MS)
+        : io(io), ioMutex(ioMutex), baseAddr(baseAddr), settleMs(settleMs) {}
+    int ChannelCount() const override { return NCT_FAN_CHANNELS; }
+    // One request/commit for every channel in 'mask', instead of one per fan
+    bool WritePwm(uint32_t mask, const uint8_t* pwm) override;
+
+private:
+    IPortIo*& io;
+    std::mutex& ioMutex;
+    const int& baseAddr;
+    int settleMs;
+};
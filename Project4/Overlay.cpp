@@ -0,0 +1,49 @@
+#include "Overlay.hpp"
+#include <algorithm>
+
+std::unique_ptr<GlyphAtlas> BuildGdiplusAtlas() {
+    Gdiplus::Font header(L"Segoe UI", 11.0f, Gdiplus::FontStyleBold);
+    Gdiplus::Font body(L"Segoe UI", 9.0f, Gdiplus::FontStyleRegular);
+    Gdiplus::Font small(L"Segoe UI", 8.0f, Gdiplus::FontStyleRegular);
+    Gdiplus::Font* fonts[(int)UiFont::Count] = { &header, &body, &small };
+
+    const int CELL = 48, PAD = 8;   // Room for the largest glyph plus overhang on either side
+    Gdiplus::Bitmap cell(CELL, CELL, PixelFormat32bppARGB);
+    Gdiplus::Graphics g(&cell);
+    g.SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAliasGridFit);
+    Gdiplus::SolidBrush white(Gdiplus::Color(255, 255, 255, 255));
+    Gdiplus::StringFormat format(Gdiplus::StringFormat::GenericTypographic());
+    format.SetFormatFlags(format.GetFormatFlags() | Gdiplus::StringFormatFlagsMeasureTrailingSpaces);
+
+    return std::make_unique<GlyphAtlas>([&](UiFont font, wchar_t ch, GlyphBitmap& out) {
+        Gdiplus::Font* f = fonts[(int)font];
+        Gdiplus::RectF box;
+        g.MeasureString(&ch, 1, f, Gdiplus::PointF(0, 0), &format, &box);
+        out.advance = (int)(box.Width + 0.5f);
+
+        g.Clear(Gdiplus::Color(0, 0, 0, 0));
+        g.DrawString(&ch, 1, f, Gdiplus::PointF((float)PAD, 0), &format, &white);
+        g.Flush(Gdiplus::FlushIntentionSync);
+
+        Gdiplus::Rect all(0, 0, CELL, CELL);
+        Gdiplus::BitmapData data;
+        if (cell.LockBits(&all, Gdiplus::ImageLockModeRead, PixelFormat32bppARGB, &data) != Gdiplus::Ok) return;
+        auto alpha = [&](int x, int y) { return ((const uint8_t*)data.Scan0)[y * data.Stride + x * 4 + 3]; };
+        int x0 = CELL, y0 = CELL, x1 = 0, y1 = 0;
+        for (int y = 0; y < CELL; y++) {
+            for (int x = 0; x < CELL; x++) {
+                if (!alpha(x, y)) continue;
+                x0 = (std::min)(x0, x); x1 = (std::max)(x1, x + 1);
+                y0 = (std::min)(y0, y); y1 = (std::max)(y1, y + 1);
+            }
+        }
+        if (x1 > x0) {  // Blank glyphs (space) keep an empty bitmap
+            out.w = x1 - x0; out.h = y1 - y0;
+            out.left = x0 - PAD; out.top = y0;
+            out.coverage.resize((size_t)out.w * out.h);
+            for (int y = 0; y < out.h; y++)
+                for (int x = 0; x < out.w; x++) out.coverage[(size_t)y * out.w + x] = alpha(x0 + x, y0 + y);
+        }
+        cell.UnlockBits(&data);
+    });
+}
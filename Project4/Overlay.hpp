@@ -0,0 +1,15 @@
+#pragma once
+#include <windows.h>
+#include <gdiplus.h>
+#include <memory>
+#include "GlyphAtlas.hpp"
+
+// ---------------------------------------------------------
+//  GDI+ GLYPH SOURCE
+//  Rasterizes the overlay's Segoe UI faces once at startup into a
+//  GlyphAtlas. Every frame is then drawn by the software canvas, so
+//  GDI+ never shapes or rasterizes text on the render path.
+//  Greyscale anti-aliasing: ClearType needs an opaque background,
+//  and a per-pixel-alpha layered window does not have one.
+// ---------------------------------------------------------
+std::unique_ptr<GlyphAtlas> BuildGdiplusAtlas();    // Call after GdiplusStartup
@@ -0,0 +1,194 @@
+#include "OverlayLayout.hpp"
+#include "CpuClock.hpp"
+#include <cwchar>
+
+static void Bar(UiFrame& f, int x, int y, int w, int h, float pct, UiColor fill) {
+    UiWidget& b = f.Add(UiKind::Bar, { x, y, w, h });
+    b.value = pct;
+    b.color = fill;
+    b.track = UiColor::Track;
+    b.radius = h;
+}
+
+static void Button(UiFrame& f, UiHit hit, const wchar_t* text, int x, int y, int w, bool active, UiFont font) {
+    UiRect r = { x, y, w, OVERLAY_BTN_HEIGHT };
+    UiWidget& b = f.Add(UiKind::Button, r);
+    b.active = active;
+    b.font = font;
+    b.radius = 10;
+    for (int i = 0; i < UI_TEXT_MAX - 1 && text[i]; i++) b.text[i] = text[i];
+    f.hits[(int)hit] = r;
+}
+
+void BuildOverlay(const OverlayState& st, const StatsSnapshot& s, int w, int h, UiFrame& f) {
+    f.Clear(w, h);
+    UiWidget& panel = f.Add(UiKind::Panel, { 0, 0, w, h });
+    panel.alpha = (uint8_t)st.opacity;
+    panel.color = UiColor::Background;
+    panel.track = UiColor::Border;
+    panel.radius = OVERLAY_CORNER_RADIUS;
+
+    f.Add(UiKind::Dot, { 20, 15, 14, 14 }).color = UiColor::Red;
+    f.widgets.back().radius = 7;
+    f.Add(UiKind::Dot, { 40, 15, 14, 14 }).color = UiColor::Yellow;
+    f.widgets.back().radius = 7;
+
+    wchar_t buf[UI_TEXT_MAX];
+    if (st.miniMode) {
+        swprintf(buf, UI_TEXT_MAX, L"CPU %d%%", s.cpu.usage);
+        f.Text(UiFont::Header, UiColor::White, 90, 12, buf);
+        swprintf(buf, UI_TEXT_MAX, L"%d\u00B0C", s.board.cpuTemp);
+        f.Text(UiFont::Body, UiColor::Gray, 160, 14, buf);
+        return;
+    }
+
+    int y = 40, x = 25, contentW = w - 50;
+
+    if (st.showCpu) {
+        f.Text(UiFont::Body, UiColor::White, x, y, st.cpuName); y += 18;
+        Bar(f, x, y, contentW, 8, s.cpu.usage / 100.0f, (s.board.cpuTemp > 85) ? UiColor::Red : UiColor::Blue); y += 12;
+        swprintf(buf, UI_TEXT_MAX, L"%d%% Load  \u2022  %d\u00B0C Temp  \u2022  %d Thr", s.cpu.usage, s.board.cpuTemp, s.board.globalThreads);
+        f.Text(UiFont::Small, UiColor::Gray, x, y, buf); y += 20;
+    }
+
+    if (st.showCores && s.cpu.coreCount > 0) {
+        const int maxCols = 4;
+        float colW = contentW / (float)maxCols;
+        // With a clock source each cell gets its GHz; a throttled core turns yellow
+        bool clocks = s.cpu.avgMhz > 0;
+        int rowH = clocks ? 14 : 8, barW = (int)colW - (clocks ? 42 : 10);
+        int col = 0;
+        for (int i = 0; i < s.cpu.coreCount; i++) {
+            float pct = s.cpu.coreLoad[i] / 100.0f;
+            int cx = x + (int)(col * colW);
+            bool throttled = IsCoreThrottled((float)s.cpu.coreLoad[i], (float)s.cpu.coreMhz[i], (float)s.cpu.baseMhz);
+            Bar(f, cx, y + rowH / 2, barW, 4, pct, throttled ? UiColor::Yellow : (pct > 0.8f) ? UiColor::Red : UiColor::Blue);
+            if (clocks && s.cpu.coreMhz[i] > 0) {
+                swprintf(buf, UI_TEXT_MAX, L"%.2f", s.cpu.coreMhz[i] / 1000.0f);
+                f.Text(UiFont::Small, throttled ? UiColor::Yellow : UiColor::Gray, cx + barW + 4, y, buf);
+            }
+            if (++col >= maxCols) { col = 0; y += rowH; }
+        }
+        if (col != 0) y += rowH;
+        if (clocks) {
+            y += 4;
+            int n = swprintf(buf, UI_TEXT_MAX, L"Clock %.2f GHz avg  \u2022  %.2f GHz base", s.cpu.avgMhz / 1000.0f, s.cpu.baseMhz / 1000.0f);
+            if (s.cpu.throttledCores > 0 && n > 0) swprintf(buf + n, UI_TEXT_MAX - n, L"  \u2022  %d THROTTLING", s.cpu.throttledCores);
+            f.Text(UiFont::Small, s.cpu.throttledCores > 0 ? UiColor::Yellow : UiColor::Gray, x, y, buf); y += 14;
+        }
+        y += 10;
+    }
+
+    // --- MOTHERBOARD DETAILS ---
+    if (st.fanReady) {
+        swprintf(buf, UI_TEXT_MAX, L"Motherboard (%ls)", st.chipName);
+        f.Text(UiFont::Body, UiColor::White, x, y, buf); y += 18;
+        if (st.chipId != 0 && !st.chipMapped) {
+            swprintf(buf, UI_TEXT_MAX, L"ID: %04X (no sensor map for this chip)", st.chipId);
+            f.Text(UiFont::Small, UiColor::Gray, x, y, buf); y += 20;
+        }
+        else if (st.chipId != 0) {
+            swprintf(buf, UI_TEXT_MAX, L"ID: %04X (Found)", st.chipId);
+            f.Text(UiFont::Small, UiColor::Green, x, y, buf); y += 14;
+            swprintf(buf, UI_TEXT_MAX, L"CPU: %.3fV  SoC: %.3fV  DRAM: %.3fV", s.board.voltVCore, s.board.voltSoC, s.board.voltDram);
+            f.Text(UiFont::Small, UiColor::Gray, x, y, buf); y += 14;
+            swprintf(buf, UI_TEXT_MAX, L"+12V: %.2fV  +5V: %.2fV", s.board.volt12V, s.board.volt5V);
+            f.Text(UiFont::Small, UiColor::Gray, x, y, buf); y += 14;
+            swprintf(buf, UI_TEXT_MAX, L"VRM: %d\u00B0C  Sys: %d\u00B0C  PCH: %d\u00B0C", s.board.tempVRM, s.board.tempSystem, s.board.tempPCH);
+            f.Text(UiFont::Small, UiColor::Gray, x, y, buf); y += 20;
+        }
+        else {
+            swprintf(buf, UI_TEXT_MAX, L"Scanning... Last: %04X", st.debugId);
+            f.Text(UiFont::Small, UiColor::Red, x, y, buf); y += 20;
+        }
+    }
+
+    if (st.showGpu) {
+        f.Text(UiFont::Body, UiColor::White, x, y, st.gpuName); y += 18;
+        if (s.gpu.vramTotal > 0) {
+            Bar(f, x, y, contentW, 6, (float)s.gpu.vramUsed / (float)s.gpu.vramTotal, UiColor::Blue);
+            swprintf(buf, UI_TEXT_MAX, L"VRAM: %llu / %llu MB", s.gpu.vramUsed / (1024 * 1024), s.gpu.vramTotal / (1024 * 1024));
+            y += 12; f.Text(UiFont::Small, UiColor::Gray, x, y, buf);
+        }
+        // Secondary adapters (iGPU + dGPU laptops, multi-GPU rigs)
+        for (int i = 1; i < s.gpu.adapterCount; i++) {
+            const GpuAdapterStats& a = s.gpu.adapters[i];
+            swprintf(buf, UI_TEXT_MAX, L"%ls: %llu / %llu MB", a.name, a.vramUsed / (1024 * 1024), a.vramTotal / (1024 * 1024));
+            y += 14; f.Text(UiFont::Small, UiColor::Gray, x, y, buf);
+        }
+        y += 20;
+    }
+
+    if (st.showDrives) {
+        f.Text(UiFont::Body, UiColor::White, x, y, L"Storage"); y += 18;
+        for (int i = 0; i < s.storage.driveCount; i++) {
+            f.Text(UiFont::Small, UiColor::Gray, x, y, s.storage.drives[i]); y += 12;
+        }
+        y += 8;
+    }
+
+    if (st.showBattery && s.battery.present) {
+        f.Text(UiFont::Body, UiColor::White, x, y, L"Battery"); y += 18;
+        Bar(f, x, y, contentW, 8, s.battery.pct / 100.0f, s.battery.pct < 20 ? UiColor::Red : UiColor::Green);
+        if (s.battery.lifeSeconds >= 0) swprintf(buf, UI_TEXT_MAX, L"%d%% (%dh %02dm)", s.battery.pct, s.battery.lifeSeconds / 3600, (s.battery.lifeSeconds % 3600) / 60);
+        else swprintf(buf, UI_TEXT_MAX, L"%d%% (%ls)", s.battery.pct, s.battery.charging ? L"Charging" : L"...");
+        y += 12; f.Text(UiFont::Small, UiColor::Gray, x, y, buf); y += 20;
+    }
+
+    // --- FAN CONTROL SLIDER ---
+    f.Text(UiFont::Body, st.fanReady ? UiColor::Green : UiColor::Red, x, y, L"Fan Control"); y += 18;
+    if (st.fanReady) {
+        if (st.fanAuto) swprintf(buf, UI_TEXT_MAX, L"%d RPM  \u2022  Auto %d%%  \u2022  Right-click for manual", s.board.fanRPM, st.fanTargetPct);
+        else swprintf(buf, UI_TEXT_MAX, L"%d RPM  \u2022  Target %d%%", s.board.fanRPM, st.fanTargetPct);
+        f.Text(UiFont::Small, UiColor::Gray, x, y, buf); y += 14;
+        Bar(f, x, y, contentW, 8, st.fanTargetPct / 100.0f, st.draggingFan ? UiColor::White : st.fanAuto ? UiColor::Green : UiColor::Yellow);
+        f.hits[(int)UiHit::FanSlider] = { x, y, contentW, 8 };
+        y += 20;
+    }
+    else {
+        f.Text(UiFont::Small, UiColor::Gray, x, y, L"Driver Missing (Run as Admin)"); y += 20;
+    }
+
+    y += 10;
+    f.Text(UiFont::Body, UiColor::White, x, y, L"Benchmarks"); y += 20;
+    if (st.benchRunning || st.gpuBenchRunning) {
+        swprintf(buf, UI_TEXT_MAX, L"Running %ls Test (%d%%)", st.benchRunning ? (st.memBench ? L"Memory" : L"CPU") : L"GPU", st.benchProgress);
+        f.Text(UiFont::Small, UiColor::Yellow, x, y, buf);
+        Bar(f, x, y + 15, contentW, 6, st.benchProgress / 100.0f, UiColor::Yellow);
+    }
+    else {
+        if (st.benchScore > 0) { swprintf(buf, UI_TEXT_MAX, L"CPU Score: %d pts", st.benchScore); f.Text(UiFont::Header, UiColor::Green, x, y, buf); }
+        if (st.gpuScore > 0) { swprintf(buf, UI_TEXT_MAX, L"GPU Score: %d pts", st.gpuScore); f.Text(UiFont::Header, UiColor::Blue, x + 150, y, buf); }
+        if (st.benchScore == 0 && st.gpuScore == 0 && st.memBandwidth <= 0.0f) f.Text(UiFont::Small, UiColor::Gray, x, y, L"Ready to Test");
+    }
+    y += 30;
+    if (st.memBandwidth > 0.0f && !st.benchRunning) {
+        swprintf(buf, UI_TEXT_MAX, L"Memory: %.1f GB/s triad  \u2022  %.0f ns latency", st.memBandwidth, st.memLatency);
+        f.Text(UiFont::Small, UiColor::Gray, x, y, buf);
+        y += 18;
+    }
+
+    int btnW = (contentW - 15) / 4;
+    Button(f, UiHit::MultiCore, L"Multi Core", x, y, btnW, st.benchRunning && st.benchMulti, UiFont::Body);
+    Button(f, UiHit::SingleCore, L"Single Core", x + btnW + 5, y, btnW, st.benchRunning && st.benchSingle, UiFont::Body);
+    Button(f, UiHit::GpuTest, L"GPU Test", x + btnW * 2 + 10, y, btnW, st.gpuBenchRunning, UiFont::Body);
+    Button(f, UiHit::MemTest, L"Memory", x + btnW * 3 + 15, y, btnW, st.benchRunning && st.memBench, UiFont::Body);
+
+    y += 45;
+    int stressW = (contentW - 20) / 3;
+    // The burn button names its workload, and the duty cycle when it is throttled
+    static const wchar_t* profiles[] = { L"FMA", L"INT", L"CACHE", L"MIXED" };
+    const wchar_t* profile = (st.stressProfile >= 0 && st.stressProfile < 4) ? profiles[st.stressProfile] : L"?";
+    if (st.stressDuty < 100) swprintf(buf, UI_TEXT_MAX, L"CPU BURN %ls %d%%", profile, st.stressDuty);
+    else swprintf(buf, UI_TEXT_MAX, L"CPU BURN %ls", profile);
+    Button(f, UiHit::CpuBurn, buf, x, y, stressW, st.cpuStress, UiFont::Small);
+    Button(f, UiHit::RamBurn, L"RAM BURN", x + stressW + 10, y, stressW, st.ramStress, UiFont::Small);
+    Button(f, UiHit::GpuBurn, L"GPU BURN", x + stressW * 2 + 20, y, stressW, st.gpuStress, UiFont::Small);
+
+    if (st.ramVerifiedGB > 0.0) {
+        y += OVERLAY_BTN_HEIGHT + 8;
+        if (st.ramErrors == 0) swprintf(buf, UI_TEXT_MAX, L"RAM: %.1f GB verified  \u2022  %d passes  \u2022  no errors", st.ramVerifiedGB, st.ramPasses);
+        else swprintf(buf, UI_TEXT_MAX, L"RAM: %llu errors, first at 0x%llx bit %d", (unsigned long long)st.ramErrors, (unsigned long long)st.ramFirstError, st.ramFirstBit);
+        f.Text(UiFont::Small, st.ramErrors ? UiColor::Red : UiColor::Gray, x, y, buf);
+    }
+}
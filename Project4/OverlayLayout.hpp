@@ -0,0 +1,56 @@
+#pragma once
+#include "Stats.hpp"
+#include "UiTree.hpp"
+
+// Everything the overlay layout reads besides the stats snapshot.
+// Filled by the UI thread each frame, so the layout itself touches no globals.
+struct OverlayState {
+    bool showCpu = true;
+    bool showCores = true;
+    bool showGpu = true;
+    bool showDrives = true;
+    bool showBattery = true;
+    bool miniMode = false;
+    int opacity = 230;
+
+    const wchar_t* cpuName = L"";
+    const wchar_t* gpuName = L"";
+
+    bool fanReady = false;
+    int chipId = 0;
+    const wchar_t* chipName = L"Super I/O";
+    bool chipMapped = true;     // False for a detect-only chip: no readings to show
+    int debugId = 0;
+    int fanTargetPct = 0;           // Slider value, or channel 0's output in Auto
+    bool fanAuto = false;
+    bool draggingFan = false;
+
+    bool benchRunning = false;
+    bool benchMulti = false;
+    bool benchSingle = false;
+    bool memBench = false;          // The running CPU-side benchmark is the memory one
+    bool gpuBenchRunning = false;
+    int benchProgress = 0;
+    int benchScore = 0;
+    int gpuScore = 0;
+    float memBandwidth = 0.0f;      // GB/s; 0 = never run
+    float memLatency = 0.0f;        // ns
+
+    bool cpuStress = false;
+    int stressProfile = 0;          // StressProfile
+    int stressDuty = 100;
+    bool ramStress = false;
+    bool gpuStress = false;
+    double ramVerifiedGB = 0.0;     // RAM BURN progress; shown once it has run
+    int ramPasses = 0;
+    uint64_t ramErrors = 0;
+    uint64_t ramFirstError = 0;
+    int ramFirstBit = -1;
+};
+
+constexpr int UI_WIDTH_NORMAL = 550;
+constexpr int UI_WIDTH_MINI = 220;
+constexpr int OVERLAY_CORNER_RADIUS = 18;
+constexpr int OVERLAY_BTN_HEIGHT = 30;
+
+void BuildOverlay(const OverlayState& st, const StatsSnapshot& s, int w, int h, UiFrame& out);
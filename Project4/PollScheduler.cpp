@@ -0,0 +1,166 @@
+#include "PollScheduler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+PollScheduler::PollScheduler(int tickMs) : tickMs(tickMs) {
+    std::fill(std::begin(wheel), std::end(wheel), -1);
+}
+
+PollScheduler::~PollScheduler() { Stop(); }
+
+int PollScheduler::Add(const PollTaskConfig& cfg, std::function<PollResult()> fn) {
+    if (running || taskCount >= MAX_POLL_TASKS) return -1;
+    int id = taskCount++;
+    Task& t = tasks[id];
+    t.cfg = cfg;
+    t.fn = std::move(fn);
+    t.intervalMs = std::clamp(cfg.startMs, cfg.minMs, cfg.maxMs);
+    snprintf(t.local.name, sizeof(t.local.name), "%s", cfg.name);
+    t.local.intervalMs = t.intervalMs;
+    t.stats.Store(t.local);
+    return id;
+}
+
+void PollScheduler::Start() {
+    if (running.exchange(true)) return;
+    // Everything polls once immediately so the first frame has data
+    for (int i = 0; i < taskCount; i++) tasks[i].wake = true;
+    wakePending = true;
+    worker = std::thread(&PollScheduler::Run, this);
+}
+
+void PollScheduler::Stop() {
+    if (!running.exchange(false)) return;
+    { std::lock_guard<std::mutex> l(waitMutex); }
+    waitCv.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void PollScheduler::Wake(int task) {
+    if (task < 0 || task >= taskCount) return;
+    tasks[task].wake = true;
+    {
+        std::lock_guard<std::mutex> l(waitMutex);
+        wakePending = true;
+    }
+    waitCv.notify_one();
+}
+
+// ---------------------------------------------------------
+//  WHEEL
+// ---------------------------------------------------------
+void PollScheduler::Unlink(int id) {
+    Task& t = tasks[id];
+    if (t.slot < 0) return;
+    if (t.prev >= 0) tasks[t.prev].next = t.next; else wheel[t.slot] = t.next;
+    if (t.next >= 0) tasks[t.next].prev = t.prev;
+    t.slot = t.prev = t.next = -1;
+}
+
+void PollScheduler::Schedule(int id, int delayMs) {
+    Unlink(id);
+    Task& t = tasks[id];
+    uint64_t ticks = (std::max)(1, (delayMs + tickMs - 1) / tickMs);
+    t.slot = (int)((currentTick + ticks) % WHEEL_SLOTS);
+    t.rounds = (uint32_t)((ticks - 1) / WHEEL_SLOTS);
+    t.prev = -1;
+    t.next = wheel[t.slot];
+    if (t.next >= 0) tasks[t.next].prev = id;
+    wheel[t.slot] = id;
+}
+
+// Jump straight to 'tick': each slot passed on the way counts against its tasks' rounds,
+// and the ones that run out are due. They run in due order once the wheel is at 'tick'.
+void PollScheduler::AdvanceTo(uint64_t tick) {
+    if (tick <= currentTick) return;
+    uint64_t delta = tick - currentTick;
+    int due[MAX_POLL_TASKS];
+    uint64_t dueTick[MAX_POLL_TASKS];
+    int dueCount = 0;
+    for (uint64_t d = 1; d <= (std::min)(delta, (uint64_t)WHEEL_SLOTS); d++) {
+        uint64_t passes = 1 + (delta - d) / WHEEL_SLOTS;
+        for (int id = wheel[(currentTick + d) % WHEEL_SLOTS]; id >= 0; id = tasks[id].next) {
+            Task& t = tasks[id];
+            if (passes <= t.rounds) { t.rounds -= (uint32_t)passes; continue; }
+            uint64_t at = currentTick + d + (uint64_t)t.rounds * WHEEL_SLOTS;
+            int i = dueCount++;
+            for (; i > 0 && dueTick[i - 1] > at; i--) { due[i] = due[i - 1]; dueTick[i] = dueTick[i - 1]; }
+            due[i] = id;
+            dueTick[i] = at;
+        }
+    }
+    currentTick = tick;
+    for (int i = 0; i < dueCount; i++) RunTask(due[i]);     // Re-links itself into a later slot
+}
+
+// The first occupied slot holding a task on its last round; a task with rounds left can
+// only win while no such slot comes before its own due tick
+uint64_t PollScheduler::NextDueTick() const {
+    uint64_t best = UINT64_MAX;
+    for (uint64_t d = 1; d <= WHEEL_SLOTS && d < best - currentTick; d++) {
+        for (int id = wheel[(currentTick + d) % WHEEL_SLOTS]; id >= 0; id = tasks[id].next)
+            best = (std::min)(best, currentTick + d + (uint64_t)tasks[id].rounds * WHEEL_SLOTS);
+    }
+    return best;
+}
+
+void PollScheduler::RunTask(int id) {
+    Task& t = tasks[id];
+    t.wake = false;             // Covers a pending Wake(); one arriving during fn() still counts
+    auto start = std::chrono::steady_clock::now();
+    PollResult result = t.fn();
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    // Adapt the interval to how fast the values move
+    int interval = t.intervalMs;
+    switch (result) {
+    case PollResult::Urgent: interval = t.cfg.minMs; break;
+    case PollResult::Changed: interval /= 2; break;
+    case PollResult::Stable: interval += interval / 2; break;
+    }
+
+    PollTaskStats& s = t.local;
+    s.runs++;
+    s.lastUs = us;
+    s.avgUs = (s.runs == 1) ? us : s.avgUs * 0.9 + us * 0.1;
+    s.maxUs = (std::max)(s.maxUs, us);
+    s.totalMs += us / 1000.0;
+
+    // Over budget: stretch the interval so the average cost per second stays put
+    if (t.cfg.budgetUs > 0 && s.avgUs > t.cfg.budgetUs) interval = (int)(interval * (s.avgUs / t.cfg.budgetUs));
+
+    t.intervalMs = std::clamp(interval, t.cfg.minMs, t.cfg.maxMs);
+    s.intervalMs = t.intervalMs;
+    t.stats.Store(s);
+    Schedule(id, t.intervalMs);
+    if (observer) observer(id, result);
+}
+
+int64_t PollScheduler::RunDue(int64_t nowMs) {
+    // The wheel first, so a woken task reschedules from the current tick and not a stale one
+    AdvanceTo((uint64_t)(std::max)(nowMs, (int64_t)0) / tickMs);
+    for (int i = 0; i < taskCount; i++) {
+        if (tasks[i].wake.load()) RunTask(i);
+    }
+    uint64_t next = NextDueTick();
+    return next == UINT64_MAX ? NO_DEADLINE : (int64_t)(next * tickMs);
+}
+
+// Sleeps until the next task is due or a Wake(), however long that is: an idle system with
+// slow tasks wakes this thread once per poll, not once per tick
+void PollScheduler::Run() {
+    auto epoch = std::chrono::steady_clock::now();
+    int64_t nextMs = 0;
+
+    while (running) {
+        {
+            std::unique_lock<std::mutex> l(waitMutex);
+            auto pred = [&] { return !running || wakePending; };
+            if (nextMs == NO_DEADLINE) waitCv.wait(l, pred);
+            else waitCv.wait_until(l, epoch + std::chrono::milliseconds(nextMs), pred);
+            wakePending = false;
+        }
+        if (!running) break;
+        nextMs = RunDue(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "SeqLock.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ---------------------------------------------------------
+//  POLL SCHEDULER
+//  One thread drives every sensor poll from a hashed timer wheel.
+//  Each task reports whether its values moved; stable tasks back off
+//  towards maxMs, changing ones speed up towards minMs, and a threshold
+//  crossing snaps straight back to minMs.
+// ---------------------------------------------------------
+enum class PollResult {
+    Stable,     // Nothing worth reporting changed
+    Changed,    // Values moved noticeably
+    Urgent,     // Crossed an alarm threshold
+};
+
+struct PollTaskConfig {
+    const char* name = "";
+    int minMs = 250;
+    int maxMs = 5000;
+    int startMs = 500;
+    int budgetUs = 0;           // Average cost allowed per run; 0 = unlimited
+};
+
+struct PollTaskStats {
+    char name[32] = {};
+    int intervalMs = 0;
+    uint64_t runs = 0;
+    double lastUs = 0.0;
+    double avgUs = 0.0;         // EWMA
+    double maxUs = 0.0;
+    double totalMs = 0.0;
+};
+
+constexpr int MAX_POLL_TASKS = 32;
+
+class PollScheduler {
+public:
+    explicit PollScheduler(int tickMs = 10);
+    ~PollScheduler();
+
+    // Register before Start(). Returns the task id or -1.
+    int Add(const PollTaskConfig& cfg, std::function<PollResult()> fn);
+    void Start();
+    void Stop();
+    // Run a task on the next scheduler pass regardless of its interval
+    void Wake(int task);
+    // Called on the scheduler thread after every task run. Set before Start().
+    void SetObserver(std::function<void(int task, PollResult result)> fn) { observer = std::move(fn); }
+
+    // One scheduler pass at 'nowMs' (ms since Start, on the scheduler's own clock): runs
+    // whatever fell due since the last pass, then woken tasks. Returns when the next task
+    // is due, NO_DEADLINE if none is scheduled. Run() sleeps until then or a Wake(); tests
+    // call it directly with a fake clock, without Start().
+    static constexpr int64_t NO_DEADLINE = INT64_MAX;
+    int64_t RunDue(int64_t nowMs);
+
+    int TaskCount() const { return taskCount; }
+    PollTaskStats Stats(int task) const { return tasks[task].stats.Load(); }
+
+private:
+    static constexpr int WHEEL_SLOTS = 256;
+
+    struct Task {
+        PollTaskConfig cfg;
+        std::function<PollResult()> fn;
+        int intervalMs = 0;
+        uint32_t rounds = 0;
+        int slot = -1;
+        int prev = -1, next = -1;
+        std::atomic<bool> wake{ false };
+        PollTaskStats local;
+        SeqLock<PollTaskStats> stats;
+    };
+
+    void Run();
+    void RunTask(int id);
+    void Schedule(int id, int delayMs);
+    void Unlink(int id);
+    void AdvanceTo(uint64_t tick);
+    uint64_t NextDueTick() const;
+
+    int tickMs;
+    uint64_t currentTick = 0;
+    int wheel[WHEEL_SLOTS];
+    Task tasks[MAX_POLL_TASKS];
+    int taskCount = 0;
+    std::function<void(int, PollResult)> observer;
+
+    std::thread worker;
+    std::mutex waitMutex;
+    std::condition_variable waitCv;
+    std::atomic<bool> running{ false };
+    std::atomic<bool> wakePending{ false };
+};
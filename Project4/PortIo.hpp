@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+// ---------------------------------------------------------
+//  PORT I/O BACKEND
+//  Everything that touches Super I/O / EC ports goes through this,
+//  so the inpout driver can be swapped for a simulated chip.
+// ---------------------------------------------------------
+class IPortIo {
+public:
+    virtual ~IPortIo() = default;
+    virtual uint8_t In8(uint16_t port) = 0;
+    virtual void Out8(uint16_t port, uint8_t value) = 0;
+};
@@ -0,0 +1,136 @@
+#include "PortTrace.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+constexpr size_t PTRACE_FLUSH_BYTES = 64 * 1024;
+
+static int64_t SteadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ---------------------------------------------------------
+//  CAPTURE
+// ---------------------------------------------------------
+bool TracingPortIo::Open(const std::filesystem::path& path, uint16_t chipId, uint16_t baseAddr) {
+    Close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    int64_t wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    PortTraceHeader header = { PTRACE_MAGIC, PTRACE_VERSION, wallMs, chipId, baseAddr, 0 };
+    file.write((const char*)&header, sizeof(header));
+    bytesWritten = sizeof(header);
+    buffer.clear();
+    buffer.reserve(PTRACE_FLUSH_BYTES + 16);
+    portCount = 0;
+    ops = 0;
+    lastNs = SteadyNs();
+    return true;
+}
+
+void TracingPortIo::Close() {
+    if (!file.is_open()) return;
+    Flush();
+    file.close();
+}
+
+void TracingPortIo::Flush() {
+    if (buffer.empty()) return;
+    file.write((const char*)buffer.data(), (std::streamsize)buffer.size());
+    bytesWritten += buffer.size();
+    buffer.clear();
+}
+
+uint8_t TracingPortIo::In8(uint16_t port) {
+    uint8_t value = inner.In8(port);
+    if (file.is_open()) Record(port, value, false);
+    return value;
+}
+
+void TracingPortIo::Out8(uint16_t port, uint8_t value) {
+    inner.Out8(port, value);
+    if (file.is_open()) Record(port, value, true);
+}
+
+void TracingPortIo::Record(uint16_t port, uint8_t value, bool write) {
+    int slot = 0;
+    while (slot < portCount && ports[slot] != port) slot++;
+    bool fresh = slot == portCount;
+    if (fresh && portCount == PTRACE_PORT_SLOTS) {
+        // Out of slots: recycle the last one (never happens with real chips)
+        slot = PTRACE_PORT_SLOTS - 1;
+    }
+    else if (fresh) portCount++;
+    ports[slot] = port;
+
+    buffer.push_back((uint8_t)((slot << 2) | (fresh ? 2 : 0) | (write ? 1 : 0)));
+    if (fresh) { buffer.push_back((uint8_t)port); buffer.push_back((uint8_t)(port >> 8)); }
+    int64_t now = SteadyNs();
+    uint64_t delta = (uint64_t)(now - lastNs);
+    lastNs = now;
+    while (delta >= 0x80) { buffer.push_back((uint8_t)(delta | 0x80)); delta >>= 7; }
+    buffer.push_back((uint8_t)delta);
+    buffer.push_back(value);
+    ops++;
+    if (buffer.size() >= PTRACE_FLUSH_BYTES) Flush();
+}
+
+bool ReadPortTrace(const std::filesystem::path& path, PortTraceHeader& header, std::vector<PortTraceOp>& ops) {
+    ops.clear();
+    MappedFile map;
+    if (!map.Open(path) || map.Size() < sizeof(PortTraceHeader)) return false;
+    memcpy(&header, map.Data(), sizeof(header));
+    if (header.magic != PTRACE_MAGIC || header.version != PTRACE_VERSION) return false;
+
+    uint16_t ports[PTRACE_PORT_SLOTS] = {};
+    int portCount = 0;
+    int64_t time = 0;
+    const uint8_t* p = map.Data() + sizeof(header);
+    const uint8_t* end = map.Data() + map.Size();
+    while (p < end) {
+        // A capture cut short (crash, power loss) ends mid-record; keep what is whole
+        uint8_t tag = *p++;
+        int slot = tag >> 2;
+        if (tag & 2) {
+            if (end - p < 2) break;
+            if (slot == portCount && portCount < PTRACE_PORT_SLOTS) portCount++;
+            ports[slot] = (uint16_t)(p[0] | (p[1] << 8));
+            p += 2;
+        }
+        else if (slot >= portCount) return false;
+        uint64_t delta = 0;
+        int shift = 0;
+        while (p < end && (*p & 0x80) && shift < 63) { delta |= (uint64_t)(*p++ & 0x7F) << shift; shift += 7; }
+        if (end - p < 2) break;
+        delta |= (uint64_t)(*p++) << shift;
+        time += (int64_t)delta;
+        ops.push_back({ time, ports[slot], *p++, (tag & 1) != 0 });
+    }
+    return true;
+}
+
+// ---------------------------------------------------------
+//  REPLAY
+// ---------------------------------------------------------
+const PortTraceOp* ReplayPortIo::Match(uint16_t port, uint8_t value, bool write) {
+    size_t limit = (std::min)(ops.size(), position + (size_t)lookahead);
+    for (size_t i = position; i < limit; i++) {
+        const PortTraceOp& op = ops[i];
+        if (op.port != port || op.write != write || (write && op.value != value)) continue;
+        skipped += i - position;
+        position = i + 1;
+        return &op;
+    }
+    unmatched++;
+    return nullptr;
+}
+
+uint8_t ReplayPortIo::In8(uint16_t port) {
+    const PortTraceOp* op = Match(port, 0, false);
+    return op ? op->value : 0xFF;
+}
+
+void ReplayPortIo::Out8(uint16_t port, uint8_t value) {
+    Match(port, value, true);
+}
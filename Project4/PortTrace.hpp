@@ -0,0 +1,114 @@
+#pragma once
+#include "PortIo.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// ---------------------------------------------------------
+//  PORT I/O TRACE
+//  Every In8/Out8 that reaches the chip, timestamped, so a field
+//  issue can be reproduced bit for bit and the decode path can be
+//  benchmarked without the board. One file per capture:
+//    PortTraceHeader, then one record per op:
+//      uint8   tag: bit 0 write, bit 1 new port, bits 2-7 port slot
+//      uint16  port, only with "new port" (takes the next slot)
+//      varint  nanoseconds since the previous op
+//      uint8   value read or written
+//  Only a handful of ports are ever touched (config index/data, the
+//  EC's page/index/data), so a typical op costs 3-4 bytes.
+// ---------------------------------------------------------
+constexpr uint32_t PTRACE_MAGIC = 0x31525450;       // "PTR1"
+constexpr uint32_t PTRACE_VERSION = 1;
+constexpr int PTRACE_PORT_SLOTS = 64;
+
+struct PortTraceHeader {
+    uint32_t magic;
+    uint32_t version;
+    int64_t startMs;            // Wall clock at Open
+    uint16_t chipId;            // Chip already detected when the capture began, else 0
+    uint16_t baseAddr;
+    uint32_t reserved;
+};
+static_assert(sizeof(PortTraceHeader) == 24, "PortTrace layout");
+
+struct PortTraceOp {
+    int64_t timeNs;             // Since Open
+    uint16_t port;
+    uint8_t value;
+    bool write;
+};
+
+// ---------------------------------------------------------
+//  CAPTURE
+//  Wraps the real backend. Not thread-safe: like every IPortIo user it
+//  runs under the I/O lock, which also covers the occasional 64 KiB
+//  flush to disk.
+// ---------------------------------------------------------
+class TracingPortIo : public IPortIo {
+public:
+    explicit TracingPortIo(IPortIo& inner) : inner(inner) {}
+    ~TracingPortIo() { Close(); }
+    TracingPortIo(const TracingPortIo&) = delete;
+    TracingPortIo& operator=(const TracingPortIo&) = delete;
+
+    // Creates (truncates) the file. 'chipId'/'baseAddr' record what was already found.
+    bool Open(const std::filesystem::path& path, uint16_t chipId = 0, uint16_t baseAddr = 0);
+    // Flushes and closes; ops keep passing through to the backend untraced
+    void Close();
+    bool IsOpen() const { return file.is_open(); }
+
+    uint8_t In8(uint16_t port) override;
+    void Out8(uint16_t port, uint8_t value) override;
+
+    uint64_t Ops() const { return ops; }
+    uint64_t BytesWritten() const { return bytesWritten; }
+
+private:
+    void Record(uint16_t port, uint8_t value, bool write);
+    void Flush();
+
+    IPortIo& inner;
+    std::ofstream file;
+    std::vector<uint8_t> buffer;
+    uint16_t ports[PTRACE_PORT_SLOTS] = {};
+    int portCount = 0;
+    int64_t lastNs = 0;
+    uint64_t ops = 0;
+    uint64_t bytesWritten = 0;
+};
+
+bool ReadPortTrace(const std::filesystem::path& path, PortTraceHeader& header, std::vector<PortTraceOp>& ops);
+
+// ---------------------------------------------------------
+//  REPLAY
+//  Answers each op from the trace. Other traffic interleaved in the
+//  capture (fan writes between sweeps) is skipped: an op matches the
+//  next record on the same port in the same direction, and for writes
+//  with the same value. An op with no match within 'lookahead'
+//  records reads 0xFF and leaves the position alone.
+// ---------------------------------------------------------
+class ReplayPortIo : public IPortIo {
+public:
+    explicit ReplayPortIo(const std::vector<PortTraceOp>& ops, int lookahead = 4096) : ops(ops), lookahead(lookahead) {}
+
+    uint8_t In8(uint16_t port) override;
+    void Out8(uint16_t port, uint8_t value) override;
+
+    void Rewind() { position = 0; skipped = unmatched = 0; }
+    bool AtEnd() const { return position >= ops.size(); }
+    size_t Position() const { return position; }
+    // Capture time of the last matched op
+    int64_t TimeNs() const { return position ? ops[position - 1].timeNs : 0; }
+    uint64_t Skipped() const { return skipped; }
+    uint64_t Unmatched() const { return unmatched; }
+
+private:
+    const PortTraceOp* Match(uint16_t port, uint8_t value, bool write);
+
+    const std::vector<PortTraceOp>& ops;
+    int lookahead;
+    size_t position = 0;
+    uint64_t skipped = 0;
+    uint64_t unmatched = 0;
+};
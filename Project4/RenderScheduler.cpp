@@ -0,0 +1,102 @@
+#include "RenderScheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+void RenderPacer::SetRefresh(int64_t period, int64_t phase) {
+    if (period <= 0) return;
+    periodUs = period;
+    phaseUs = phase;
+    UpdateInterval();
+}
+
+void RenderPacer::SetMaxFps(int fps) {
+    maxFps = (std::max)(fps, 0);
+    UpdateInterval();
+}
+
+// Whole refresh periods per frame, so the cap never beats against vsync
+void RenderPacer::UpdateInterval() {
+    int64_t periods = 1;
+    if (maxFps > 0) {
+        int64_t wanted = 1000000 / maxFps;
+        periods = (std::max)(int64_t(1), (wanted + periodUs / 2) / periodUs);
+    }
+    intervalUs = periods * periodUs;
+}
+
+void RenderPacer::Post(uint32_t reasons, int64_t nowUs) {
+    if (!reasons) return;
+    if (!pending) pendingSinceUs = nowUs;
+    pending |= reasons;
+}
+
+void RenderPacer::WakeAt(int64_t timeUs) {
+    timerUs = (std::min)(timerUs, timeUs);
+}
+
+int64_t RenderPacer::NextVblank(int64_t t) const {
+    int64_t d = t - phaseUs;
+    // Integer division truncates towards zero: already the ceiling for negative offsets
+    int64_t k = d > 0 ? (d + periodUs - 1) / periodUs : d / periodUs;
+    return phaseUs + k * periodUs;
+}
+
+// The first vblank after the work arrived that also respects the frame cap.
+// Events that land within one period are coalesced into a single present.
+int64_t RenderPacer::DueUs() const {
+    int64_t since = pending ? pendingSinceUs : INT64_MIN / 2;
+    // Half a period of slack so timing jitter cannot push a present into the next slot
+    return NextVblank((std::max)(since, lastPresentUs + intervalUs - periodUs / 2));
+}
+
+int64_t RenderPacer::WaitUs(int64_t nowUs) const {
+    int64_t wait = WAIT_FOREVER;
+    if (pending || animating) wait = (std::max)(int64_t(0), DueUs() - nowUs);
+    if (timerUs != INT64_MAX) {
+        int64_t t = (std::max)(int64_t(0), timerUs - nowUs);
+        wait = (wait < 0) ? t : (std::min)(wait, t);
+    }
+    return wait;
+}
+
+uint32_t RenderPacer::BeginFrame(int64_t nowUs) {
+    if (timerUs <= nowUs) { Post(RENDER_WAKE_TIMER, timerUs); timerUs = INT64_MAX; }
+    if (animating) Post(RENDER_WAKE_ANIMATION, lastPresentUs);
+    // Waking a little early (timer granularity) still presents in this slot; waking late never skips it
+    if (!pending || DueUs() > nowUs + periodUs / 4) return 0;
+    uint32_t reasons = pending;
+    pending = 0;
+    lastPresentUs = nowUs;
+    return reasons;
+}
+
+RenderSignal::RenderSignal() {
+#ifdef _WIN32
+    event = CreateEventW(NULL, FALSE, FALSE, NULL);
+#endif
+}
+
+RenderSignal::~RenderSignal() {
+#ifdef _WIN32
+    if (event) CloseHandle(event);
+#endif
+}
+
+void RenderSignal::Post(uint32_t reasons) {
+    posted.fetch_or(reasons);
+#ifdef _WIN32
+    if (event) SetEvent(event);
+#endif
+    std::lock_guard<std::mutex> lock(mutex);
+    cv.notify_all();
+}
+
+void RenderSignal::Wait(int64_t timeoutUs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto ready = [this] { return posted.load() != 0; };
+    if (timeoutUs < 0) cv.wait(lock, ready);
+    else cv.wait_for(lock, std::chrono::microseconds(timeoutUs), ready);
+}
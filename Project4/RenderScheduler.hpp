@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// ---------------------------------------------------------
+//  RENDER SCHEDULER
+//  The overlay renders only when something happened: a poll task
+//  published data, an input message arrived, a timer the UI asked
+//  for expired, or an animation is running. Presents are then capped
+//  to a multiple of the display refresh and snapped to its vblank grid.
+//  RenderPacer is pure bookkeeping on caller-supplied microsecond
+//  timestamps, so it runs unchanged under a fake clock; RenderSignal
+//  carries wake-ups across threads.
+// ---------------------------------------------------------
+enum RenderWake : uint32_t {
+    RENDER_WAKE_DATA = 1u << 0,
+    RENDER_WAKE_INPUT = 1u << 1,
+    RENDER_WAKE_ANIMATION = 1u << 2,
+    RENDER_WAKE_TIMER = 1u << 3,
+};
+
+class RenderPacer {
+public:
+    static constexpr int64_t WAIT_FOREVER = -1;
+
+    // Vblank grid: one vblank at phaseUs, then every periodUs
+    void SetRefresh(int64_t periodUs, int64_t phaseUs);
+    // 0 = present on every vblank that has work
+    void SetMaxFps(int fps);
+    void Post(uint32_t reasons, int64_t nowUs);
+    // While on, every slot presents (with RENDER_WAKE_ANIMATION)
+    void SetAnimating(bool on) { animating = on; }
+    // One-shot wake-up; the earliest outstanding request wins
+    void WakeAt(int64_t timeUs);
+
+    // Time until the next present is due, 0 if now, WAIT_FOREVER if nothing is pending
+    int64_t WaitUs(int64_t nowUs) const;
+    // The reasons to render if a present is due at nowUs (consumed), else 0
+    uint32_t BeginFrame(int64_t nowUs);
+
+    int64_t FrameIntervalUs() const { return intervalUs; }
+
+private:
+    int64_t DueUs() const;
+    int64_t NextVblank(int64_t atOrAfterUs) const;
+    void UpdateInterval();
+
+    int64_t periodUs = 16667;
+    int64_t phaseUs = 0;
+    int maxFps = 0;
+    int64_t intervalUs = 16667;
+    int64_t lastPresentUs = INT64_MIN / 2;
+    int64_t timerUs = INT64_MAX;
+    int64_t pendingSinceUs = 0;
+    uint32_t pending = 0;
+    bool animating = false;
+};
+
+class RenderSignal {
+public:
+    RenderSignal();
+    ~RenderSignal();
+    RenderSignal(const RenderSignal&) = delete;
+    RenderSignal& operator=(const RenderSignal&) = delete;
+
+    // Any thread
+    void Post(uint32_t reasons);
+    // Render thread: the reasons posted since the last Take
+    uint32_t Take() { return posted.exchange(0); }
+    // Blocks until a Post or the timeout (microseconds, -1 = forever)
+    void Wait(int64_t timeoutUs);
+    // Auto-reset event set by Post on Windows, so the UI thread can wait on it
+    // together with its message queue; null elsewhere
+    void* NativeHandle() const { return event; }
+
+private:
+    std::atomic<uint32_t> posted{ 0 };
+    std::mutex mutex;
+    std::condition_variable cv;
+    void* event = nullptr;
+};
@@ -0,0 +1,57 @@
+#include "SensorProvider.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
+const char* SensorUnitSuffix(SensorUnit unit) {
+    switch (unit) {
+    case SensorUnit::Percent: return "%";
+    case SensorUnit::Celsius: return "C";
+    case SensorUnit::Volt: return "V";
+    case SensorUnit::Rpm: return "RPM";
+    case SensorUnit::MegaBytes: return "MB";
+    case SensorUnit::MegaBytesPerSec: return "MB/s";
+    case SensorUnit::MHz: return "MHz";
+    default: return "";
+    }
+}
+
+void SetSensorName(SensorDesc& desc, const char* fmt, ...) {
+    va_list args; va_start(args, fmt);
+    vsnprintf(desc.name, sizeof(desc.name), fmt, args);
+    va_end(args);
+}
+
+int SensorHub::Add(ISensorProvider* provider) {
+    if (!provider || !provider->Open()) return -1;
+    std::lock_guard<std::mutex> lock(addMutex);
+
+    int index = providerCount.load(std::memory_order_relaxed);
+    int first = sensorCount.load(std::memory_order_relaxed);
+    int count = provider->SensorCount();
+    if (index >= MAX_PROVIDERS || first + count > MAX_SENSORS) return -1;
+
+    for (int i = 0; i < count; i++) {
+        descs[first + i] = &provider->Sensor(i);
+        values[first + i].store(0.0f, std::memory_order_relaxed);
+    }
+    providers[index] = { provider, first, count };
+    sensorCount.store(first + count, std::memory_order_release);
+    providerCount.store(index + 1, std::memory_order_release);
+    return index;
+}
+
+bool SensorHub::Poll(int provider, float* out, float* maxDelta) {
+    const Entry& e = providers[provider];
+    float scratch[MAX_SENSORS];
+    if (!e.provider->Poll(scratch)) return false;
+    float delta = 0.0f;
+    for (int i = 0; i < e.count; i++) {
+        float prev = values[e.first + i].exchange(scratch[i], std::memory_order_relaxed);
+        delta = (std::max)(delta, std::fabs(scratch[i] - prev));
+    }
+    if (maxDelta) *maxDelta = delta;
+    if (out) for (int i = 0; i < e.count; i++) out[i] = scratch[i];
+    return true;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// ---------------------------------------------------------
+//  SENSOR PROVIDERS
+//  A provider owns one telemetry source (PDH, the SIO chip, procfs...).
+//  Open() does all allocation and handle setup; Poll() must not allocate.
+// ---------------------------------------------------------
+enum class SensorUnit : uint8_t {
+    Percent,
+    Celsius,
+    Volt,
+    Rpm,
+    MegaBytes,
+    MegaBytesPerSec,
+    Count,
+    MHz,
+};
+
+struct SensorDesc {
+    char name[48] = {};
+    SensorUnit unit = SensorUnit::Count;
+    bool detail = false;        // High-cardinality (per-core etc.); history keeps these last
+};
+
+class ISensorProvider {
+public:
+    virtual ~ISensorProvider() = default;
+    virtual const char* Name() const = 0;
+    virtual bool Open() = 0;
+    virtual int SensorCount() const = 0;
+    virtual const SensorDesc& Sensor(int index) const = 0;
+    // Rough cost of one Poll() in microseconds, used for scheduling
+    virtual int PollCostUs() const = 0;
+    // Writes SensorCount() values. Returns false if the source is unavailable.
+    virtual bool Poll(float* values) = 0;
+};
+
+const char* SensorUnitSuffix(SensorUnit unit);
+void SetSensorName(SensorDesc& desc, const char* fmt, ...);
+
+// ---------------------------------------------------------
+//  SENSOR HUB
+//  Flat table of every registered sensor. Each provider is polled by
+//  one thread; values are published as relaxed atomics so any thread
+//  can read the latest value without locking.
+// ---------------------------------------------------------
+constexpr int MAX_SENSORS = 512;
+constexpr int MAX_PROVIDERS = 32;
+
+class SensorHub {
+public:
+    // Opens the provider and assigns it a contiguous sensor id range. Returns -1 on failure.
+    int Add(ISensorProvider* provider);
+    // Polls one provider into the table (and into 'out' if given).
+    // maxDelta receives the largest absolute change of any of its sensors.
+    bool Poll(int provider, float* out = nullptr, float* maxDelta = nullptr);
+
+    int ProviderCount() const { return providerCount.load(std::memory_order_acquire); }
+    ISensorProvider* Provider(int provider) const { return providers[provider].provider; }
+    int FirstSensor(int provider) const { return providers[provider].first; }
+    int SensorCount() const { return sensorCount.load(std::memory_order_acquire); }
+    const SensorDesc& Sensor(int id) const { return *descs[id]; }
+    float Value(int id) const { return values[id].load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        ISensorProvider* provider = nullptr;
+        int first = 0;
+        int count = 0;
+    };
+
+    std::mutex addMutex;
+    Entry providers[MAX_PROVIDERS];
+    const SensorDesc* descs[MAX_SENSORS] = {};
+    std::atomic<float> values[MAX_SENSORS];
+    std::atomic<int> providerCount{ 0 };
+    std::atomic<int> sensorCount{ 0 };
+};
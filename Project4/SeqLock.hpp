@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer / multi-reader sequence lock.
+// The writer never blocks; readers retry if they raced with a write.
+// Payload is stored as relaxed atomic words so the copy itself is race-free.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock payload must be trivially copyable");
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    SeqLock() { T zero{}; Store(zero); }
+
+    // Writer side (one thread per instance)
+    void Store(const T& value) {
+        uint64_t words[WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed); // Odd = write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++) data[i].store(words[i], std::memory_order_relaxed);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader side (any thread). Spins only while a write is in flight.
+    void Load(T& out) const {
+        uint64_t words[WORDS];
+        uint32_t before, after;
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            while (before & 1) before = sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; i++) words[i] = data[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while (before != after);
+        std::memcpy(&out, words, sizeof(T));
+    }
+
+    T Load() const { T v; Load(v); return v; }
+
+    // Bumped by every Store; lets readers skip work when nothing changed
+    uint32_t Version() const { return sequence.load(std::memory_order_acquire) >> 1; }
+
+private:
+    std::atomic<uint32_t> sequence{ 0 };
+    std::atomic<uint64_t> data[WORDS];
+};
@@ -11,6 +11,22 @@
 #include <sstream>
 #include <wbemidl.h>
 #include <comdef.h>
+#include "SeqLock.hpp"
+#include "SensorProvider.hpp"
+#include "PollScheduler.hpp"
+#include "GpuMemory.hpp"
+#include "Stats.hpp"
+#include "WmiSource.hpp"
+#include "WmiReader.hpp"
+#include "History.hpp"
+#include "TelemetryExport.hpp"
+#include "TelemetryLog.hpp"
+#include "BenchHarness.hpp"
+#include "MemBench.hpp"
+#include "MemTest.hpp"
+#include "CpuStress.hpp"
+#include "FanControl.hpp"
+#include "RenderScheduler.hpp"
 
 #pragma comment(lib, "gdiplus.lib")
 #pragma comment(lib, "dwmapi.lib")
@@ -23,96 +39,131 @@
 extern std::atomic<bool> g_AppRunning;
 extern std::mutex g_StatsMutex;
 extern std::mutex g_IoMutex;
+extern RenderSignal g_RenderSignal;
 
 // Stress & Bench
 extern std::atomic<bool> g_CpuStress;
 extern std::atomic<bool> g_GpuStress;
 extern std::atomic<bool> g_RamStress;
+extern std::atomic<int> g_StressProfile;    // StressProfile used by CPU BURN
+extern std::atomic<int> g_StressDuty;       // Percent busy
 extern std::atomic<int> g_BenchScore;
 extern std::atomic<bool> g_BenchRunning;
 extern std::atomic<int> g_BenchProgress;
 extern std::wstring g_BenchMode;
+// Stamps the CPU name and writes bench-<benchmark>-<stamp>.json, the same record headless --bench emits
+void SaveBenchRecord(BenchRecord& record);
+extern std::atomic<float> g_MemBandwidth;  // Triad GB/s, 0 until a run finishes
+extern std::atomic<float> g_MemLatency;    // ns at the largest working set
+extern std::atomic<uint64_t> g_RamTestVerified;  // RAM BURN: bytes verified so far
+extern std::atomic<uint64_t> g_RamTestErrors;
+extern std::atomic<int> g_RamTestPasses;
+extern std::atomic<uint64_t> g_RamTestFirstError;   // Address of the first mismatch
+extern std::atomic<int> g_RamTestFirstBit;          // Its lowest flipped bit, -1 if none
 extern std::atomic<int> g_GpuScore;
 extern std::atomic<bool> g_GpuBenchRunning;
 
-// Hardware Stats
-extern int g_CpuUsage;
-extern std::vector<int> g_CoreLoad;
-extern int g_CpuTemp;
+// Hardware Identity (written once at startup, guarded by g_StatsMutex)
 extern std::wstring g_CpuName;
-
-extern int g_RamLoad;
-extern std::wstring g_RamText;
-
 extern std::wstring g_GpuName;
-extern unsigned long long g_GpuVramUsed;
-extern unsigned long long g_GpuVramTotal;
-
 extern std::wstring g_MoboName;
+extern WmiRamInfo g_RamInfo;
 extern std::wstring g_BiosWmi;
 extern std::wstring g_UpgradePath;
 extern std::wstring g_BiosAnalysis;
 extern std::wstring g_AgesaVersion;
 
-extern int g_GlobalThreads;
-extern int g_ContextSwitches;
-
-extern std::vector<std::wstring> g_DriveInfo;
-
-// Motherboard Sensors
+// Motherboard Detection
 extern int g_DetectedChipID;
 extern int g_DebugID;
-extern float g_Volt12V;
-extern float g_Volt5V;
-extern float g_VoltVCore;
-extern float g_VoltDram;
-extern float g_VoltSoC;
-extern int g_TempVRM;
-extern int g_TempPCH;
-extern int g_TempSocket;
-extern int g_TempSystem;
 
-// Fan
+extern SeqLock<CpuStats> g_CpuStats;
+extern SeqLock<BoardStats> g_BoardStats;
+extern SeqLock<MemStats> g_MemStats;
+extern SeqLock<GpuStats> g_GpuStats;
+extern SeqLock<StorageStats> g_StorageStats;
+extern SeqLock<BatteryStats> g_BatteryStats;
+
+void ReadStats(StatsSnapshot& out);
+
+// Every provider's sensors, flat (see SensorProvider.hpp)
+extern SensorHub g_Sensors;
+extern PollScheduler g_Poller;
+
+// Tiered min/max/avg history of the hub sensors (see History.hpp)
+extern SensorHistory g_History;
+int FindHistorySlot(const char* sensorName);
+// Last 'seconds' of every recorded sensor to history-<stamp>.csv, at the finest tier that
+// covers them in at most HISTORY_EXPORT_POINTS rows. Blocks on the file; F9 runs it on a thread.
+constexpr int HISTORY_EXPORT_POINTS = 8640;
+bool ExportHistory(int64_t seconds = 24 * 3600);
+
+// Fan: g_FanSpeedPct is the slider; in Auto every header follows its curve instead
 extern int g_FanSpeedPct;
-extern int g_FanRPM;
 extern bool g_FanControlActive;
-
-// Battery
-extern bool g_HasBattery;
-extern int g_BatteryPct;
-extern std::wstring g_BatteryTime;
+extern std::atomic<bool> g_FanAuto;
+extern FanController g_FanController;
 
 // Config
 extern bool g_LoggingEnabled;
 extern std::wstring g_LogPath;
+extern TelemetryLogWriter g_TelemetryLog;
+void StartLogging();
+void StopLogging();
+extern TelemetryExporter g_TelemetryExport;
+constexpr int EXPORT_INTERVAL_MS = 250;
+bool StartExport();     // False if another collector already publishes
+void StopExport();
 
 // Functions
 void StartBenchmark(bool multiCore);
 void StartGpuBenchmark();
+void StartMemBenchmark();
 void StartCpuStress();
+void StopCpuStress();
+void CycleStressProfile();
+void AdjustStressDuty(int deltaPct);
 void StartGpuStress();
 void StartRamStress();
-void MonitorCpu();
-void MonitorSystem();
+void InitCpuMonitor();
+void InitSystemInfo();
 void InitGpuInfo();
-void UpdateGpuVram();
 void GetDetailedRamInfo();
 void InitDiskPdh();
-void UpdateDiskIo();
-void CheckStorage();
-void UpdateBattery();
+
+// Poll tasks (run on g_Poller's thread)
+PollResult PollCpu();
+PollResult PollBoard();
+PollResult PollSystemCounters();
+PollResult PollHistory();
+PollResult PollLog();
+PollResult PollExport();
+PollResult PollStorage();
+PollResult UpdateGpuVram();
+PollResult UpdateDiskIo();
+PollResult UpdateBattery();
+PollResult UpdateMemory();
 
 // SIO
+class IPortIo;
+struct SioChip;
+extern IPortIo* g_PortIo;
+extern const SioChip* g_SioChip;
+extern int g_SioPort;
+extern int g_SioBaseAddr;
+// Loads the driver and detects the chip, once; later calls (from any thread) wait for that
+// and return whether it succeeded. FanControlReady never waits, so the UI and pollers use it.
 bool InitFanControl();
+bool FanControlReady();
+// Port I/O capture to g_SioTracePath + timestamp + ".ptrace" (see PortTrace.hpp). Set
+// g_SioTraceEnabled before InitFanControl to capture detection; afterwards (or from another
+// thread) use StartSioTrace, which takes the I/O lock and only arms it if init has not run yet.
+extern bool g_SioTraceEnabled;
+extern std::wstring g_SioTracePath;
+void StartSioTrace();
+void StopSioTrace();
 void SetFanSpeed(int pct);
-
-class WmiQuery {
-public:
-    WmiQuery();
-    ~WmiQuery();
-    bool Init(const std::wstring& namesSpace = L"ROOT\\CIMV2");
-    IEnumWbemClassObject* Exec(const std::wstring& query);
-private:
-    IWbemLocator* pLoc = nullptr;
-    IWbemServices* pSvc = nullptr;
-};
\ No newline at end of file
+void SetFanAuto(bool on);
+int ReadNct6687_EC(int baseAddr, int logicalAddress);
+void WriteNct6687_EC(int baseAddr, int logicalAddress, int value);
+int ReadNct6687_Block(int baseAddr, int startReg, int count, uint8_t out[]);
@@ -0,0 +1,298 @@
+#include "SimSuperIo.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// ---------------------------------------------------------
+//  REGISTER FILE
+//  The device side, written from the datasheets independently of
+//  SuperIo.cpp's maps, so a wrong map shows up as a wrong reading.
+// ---------------------------------------------------------
+constexpr uint8_t SIM_NCT_LOCK_BIT = 0x10;      // Global 0x28 on the EC parts
+constexpr uint16_t EC_TEMP = 0x100, EC_VOLT = 0x120, EC_FAN = 0x140;
+constexpr uint16_t EC_FAN_MODE = 0xA00, EC_FAN_REQUEST = 0xA01, EC_FAN_PWM = 0xA28;
+constexpr uint16_t NCT_TEMP = 0x73, NCT_VOLT = 0x480, NCT_FAN = 0x4C0;
+constexpr uint16_t NCT_PWM[SIM_FANS] = { 0x109, 0x209, 0x309, 0x809, 0x909, 0xA09, 0xB09, 0xC09 };
+constexpr uint8_t NCT_BANK_SELECT = 0x4E;
+constexpr uint8_t ITE_TEMP = 0x29, ITE_VOLT = 0x20;
+constexpr uint8_t ITE_FAN_LOW[6] = { 0x0D, 0x0E, 0x0F, 0x80, 0x82, 0x93 };
+constexpr uint8_t ITE_FAN_HIGH[6] = { 0x18, 0x19, 0x1A, 0x81, 0x83, 0x94 };
+constexpr uint8_t ITE_PWM[6] = { 0x63, 0x6B, 0x73, 0x7B, 0xA3, 0xAB };
+constexpr uint8_t FINTEK_TEMP = 0x72, FINTEK_VOLT = 0x20, FINTEK_FAN = 0xA0, FINTEK_PWM = 0xA3;
+
+static int TempChannels(SioFamily f) { return f == SioFamily::Fintek ? 3 : f == SioFamily::Ite ? 6 : SIM_TEMPS; }
+static int VoltChannels(SioFamily f) { return f == SioFamily::Nuvoton || f == SioFamily::NuvotonEc ? SIM_VOLTS : 9; }
+static int FanChannels(SioFamily f) { return f == SioFamily::Fintek ? 4 : f == SioFamily::Ite ? 6 : SIM_FANS; }
+static uint8_t MonitorLdn(SioFamily f) { return (f == SioFamily::Ite || f == SioFamily::Fintek) ? 0x04 : 0x0B; }
+
+float SimWaveform::Eval(double t, uint32_t seed) const {
+    double phase = periodSec > 0.0f ? t / periodSec - std::floor(t / periodSec) : 0.0;
+    switch (shape) {
+    case Sine: return base + amplitude * (float)std::sin(2.0 * 3.14159265358979 * phase);
+    case Square: return base + (phase < 0.5 ? amplitude : -amplitude);
+    case Ramp: return base + amplitude * (float)(2.0 * phase - 1.0);
+    case Noise: {
+        uint64_t z = (uint64_t)std::floor(t * 10.0) * 0x9E3779B97F4A7C15ull + seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        return base + amplitude * (float)((z >> 11) * (2.0 / 9007199254740992.0) - 1.0);
+    }
+    default: return base;
+    }
+}
+
+// ---------------------------------------------------------
+//  CHIP
+// ---------------------------------------------------------
+SimSuperIo::SimSuperIo(const SioChip& chip, uint16_t configPort, uint16_t baseAddr) : chip(chip), configPort(configPort), baseAddr(baseAddr) {
+    globalRegs[0x20] = (uint8_t)(chip.id >> 8);
+    globalRegs[0x21] = (uint8_t)chip.id;
+    if (chip.family == SioFamily::Fintek) { globalRegs[0x23] = 0x19; globalRegs[0x24] = 0x34; }  // Vendor ID
+    hwmRegs[0x60] = (uint8_t)(baseAddr >> 8);
+    hwmRegs[0x61] = (uint8_t)baseAddr;
+    if (chip.family == SioFamily::NuvotonEc) globalRegs[0x28] = SIM_NCT_LOCK_BIT;   // MSI boards ship it locked and inactive
+    else hwmRegs[0x30] = 0x01;
+
+    // A plausible idle desktop until scripted otherwise
+    static const float temps[SIM_TEMPS] = { 40.0f, 31.0f, 45.0f, 43.0f, 36.0f, 30.0f, 30.0f, 30.0f };
+    static const float volts[SIM_VOLTS] = { 1.0f, 1.0f, 1.25f, 1.0f, 0.675f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    for (int i = 0; i < SIM_TEMPS; i++) waves[(int)SimSensorKind::Temp][i] = { SimWaveform::Const, temps[i] };
+    for (int i = 0; i < SIM_VOLTS; i++) waves[(int)SimSensorKind::Volt][i] = { SimWaveform::Const, volts[i] };
+    for (int i = 0; i < SIM_FANS; i++) waves[(int)SimSensorKind::Fan][i] = { SimWaveform::Const, i < 3 ? 1200.0f - 150.0f * i : 0.0f };
+
+    // Firmware left every fan at 40%
+    for (int i = 0; i < PwmChannels(); i++) {
+        switch (chip.family) {
+        case SioFamily::NuvotonEc: regs[EC_FAN_PWM + i] = ecApplied[i] = 102; break;
+        case SioFamily::Nuvoton: regs[NCT_PWM[i]] = 102; break;
+        case SioFamily::Ite: regs[ITE_PWM[i]] = 102; break;
+        case SioFamily::Fintek: regs[FINTEK_PWM + 0x10 * i] = 102; break;
+        }
+    }
+    SetTime(0.0);
+}
+
+void SimSuperIo::Load(const SioDump& dump) {
+    globalRegs[0x20] = (uint8_t)(dump.chipId >> 8);
+    globalRegs[0x21] = (uint8_t)dump.chipId;
+    for (const auto& r : dump.regs) {
+        regs[r.first] = r.second;
+        for (int i = 0; chip.family == SioFamily::NuvotonEc && i < SIM_FANS; i++) if (r.first == EC_FAN_PWM + i) ecApplied[i] = r.second;
+    }
+}
+
+void SimSuperIo::Script(SimSensorKind kind, int channel, const SimWaveform& wave) {
+    if (channel < 0 || channel >= SIM_VOLTS) return;
+    waves[(int)kind][channel] = wave;
+    Encode(kind, channel, wave.Eval(now, (uint32_t)((int)kind * 64 + channel)));
+}
+
+void SimSuperIo::SetSensor(SimSensorKind kind, int channel, float value) {
+    SimWaveform w;
+    w.base = value;
+    Script(kind, channel, w);
+}
+
+float SimSuperIo::Value(SimSensorKind kind, int channel) const {
+    if (channel < 0 || channel >= SIM_VOLTS) return 0.0f;
+    return waves[(int)kind][channel].Eval(now, (uint32_t)((int)kind * 64 + channel));
+}
+
+void SimSuperIo::SetTime(double seconds) {
+    now = seconds;
+    for (int i = 0; i < TempChannels(chip.family); i++) Encode(SimSensorKind::Temp, i, waves[0][i].Eval(now, i));
+    for (int i = 0; i < VoltChannels(chip.family); i++) Encode(SimSensorKind::Volt, i, waves[1][i].Eval(now, 64 + i));
+    for (int i = 0; i < FanChannels(chip.family); i++) Encode(SimSensorKind::Fan, i, waves[2][i].Eval(now, 128 + i));
+}
+
+void SimSuperIo::Encode(SimSensorKind kind, int ch, float v) {
+    SioFamily f = chip.family;
+    if (kind == SimSensorKind::Temp) {
+        if (ch >= TempChannels(f)) return;
+        if (f == SioFamily::NuvotonEc || f == SioFamily::Nuvoton) {
+            // Whole degrees plus a half-degree flag in bit 7 of the low byte
+            int half = (int)std::floor(std::clamp(v, -128.0f, 127.5f) * 2.0f);
+            uint16_t reg = (f == SioFamily::NuvotonEc ? EC_TEMP : NCT_TEMP) + 2 * ch;
+            regs[reg] = (uint8_t)(int8_t)(half >> 1); regs[reg + 1] = (half & 1) ? 0x80 : 0x00;
+        }
+        else regs[(f == SioFamily::Ite ? ITE_TEMP + ch : FINTEK_TEMP + 2 * ch)] = (uint8_t)(int8_t)std::lround(std::clamp(v, -128.0f, 127.0f));
+    }
+    else if (kind == SimSensorKind::Volt) {
+        if (ch >= VoltChannels(f)) return;
+        if (f == SioFamily::NuvotonEc) {
+            // 12-bit millivolts split 8:4
+            int raw = std::clamp((int)std::lround(v * 1000.0f), 0, 4095);
+            regs[EC_VOLT + 2 * ch] = (uint8_t)(raw >> 4); regs[EC_VOLT + 2 * ch + 1] = (uint8_t)((raw & 0xF) << 4);
+        }
+        else {
+            uint8_t raw = (uint8_t)std::clamp((int)std::lround(v * 1000.0f / chip.voltLsbMv), 0, 255);
+            regs[f == SioFamily::Nuvoton ? NCT_VOLT + ch : f == SioFamily::Ite ? ITE_VOLT + ch : FINTEK_VOLT + ch] = raw;
+        }
+    }
+    else {
+        if (ch >= FanChannels(f)) return;
+        int rpm = (std::max)(0, (int)std::lround(v));
+        if (f == SioFamily::NuvotonEc || f == SioFamily::Nuvoton) {
+            uint16_t reg = (f == SioFamily::NuvotonEc ? EC_FAN : NCT_FAN) + 2 * ch;
+            regs[reg] = (uint8_t)(rpm >> 8); regs[reg + 1] = (uint8_t)rpm;
+        }
+        else {
+            // Tach period counts: a stopped fan reads all ones
+            int count = rpm ? (std::min)(0xFFFF, (f == SioFamily::Ite ? 1350000 / (2 * rpm) : 1500000 / rpm)) : 0xFFFF;
+            if (f == SioFamily::Ite) { regs[ITE_FAN_LOW[ch]] = (uint8_t)count; regs[ITE_FAN_HIGH[ch]] = (uint8_t)(count >> 8); }
+            else { regs[FINTEK_FAN + 0x10 * ch] = (uint8_t)(count >> 8); regs[FINTEK_FAN + 0x10 * ch + 1] = (uint8_t)count; }
+        }
+    }
+}
+
+int SimSuperIo::PwmChannels() const {
+    return chip.family == SioFamily::NuvotonEc ? 6 : FanChannels(chip.family);
+}
+
+uint8_t SimSuperIo::Pwm(int fan) const {
+    if (fan < 0 || fan >= PwmChannels()) return 0;
+    switch (chip.family) {
+    case SioFamily::NuvotonEc: return ecApplied[fan];
+    case SioFamily::Nuvoton: return regs[NCT_PWM[fan]];
+    case SioFamily::Ite: return regs[ITE_PWM[fan]];
+    default: return regs[FINTEK_PWM + 0x10 * fan];
+    }
+}
+
+void SimSuperIo::Spin() const {
+    if (latencyNs <= 0) return;
+    auto end = std::chrono::steady_clock::now() + std::chrono::nanoseconds(latencyNs);
+    while (std::chrono::steady_clock::now() < end) {}
+}
+
+bool SimSuperIo::Decoded() const {
+    if (!(hwmRegs[0x30] & 1)) return false;
+    return chip.family != SioFamily::NuvotonEc || !(globalRegs[0x28] & SIM_NCT_LOCK_BIT);
+}
+
+// Entry keys: Nuvoton and Fintek take 87 87; ITE takes 87 01 55 55 (55 AA on 0x4E)
+void SimSuperIo::ConfigWrite(uint8_t value) {
+    if (configMode) {
+        if (chip.family != SioFamily::Ite && value == 0xAA) configMode = false;
+        else configIndex = value;
+        return;
+    }
+    static const uint8_t ITE_KEY_2E[4] = { 0x87, 0x01, 0x55, 0x55 };
+    static const uint8_t ITE_KEY_4E[4] = { 0x87, 0x01, 0x55, 0xAA };
+    const uint8_t* key = chip.family == SioFamily::Ite ? (configPort == 0x4E ? ITE_KEY_4E : ITE_KEY_2E) : nullptr;
+    int length = key ? 4 : 2;
+    uint8_t expect = key ? key[keyStep] : 0x87;
+    keyStep = (value == expect) ? keyStep + 1 : (value == (key ? key[0] : 0x87) ? 1 : 0);
+    if (keyStep == length) { configMode = true; keyStep = 0; }
+}
+
+uint8_t SimSuperIo::ConfigRead() {
+    if (!configMode) return 0xFF;
+    if (configIndex < 0x30) return configIndex == 0x07 ? logicalDevice : globalRegs[configIndex];
+    return logicalDevice == MonitorLdn(chip.family) ? hwmRegs[configIndex] : 0xFF;
+}
+
+uint8_t SimSuperIo::In8(uint16_t port) {
+    Spin();
+    reads++;
+    if (port == configPort + 1) return ConfigRead();
+    if (port < baseAddr || port > baseAddr + 7 || !Decoded()) return 0xFF;
+    int offset = port - baseAddr;
+    if (chip.family == SioFamily::NuvotonEc) {
+        switch (offset) {
+        case 4: return (uint8_t)page;
+        case 5: return address;
+        case 6: return page == 0xFF ? 0xFF : regs[(page << 8) | address];
+        default: return 0xFF;
+        }
+    }
+    if (offset == 5) return address;
+    if (offset != 6) return 0xFF;
+    if (chip.family == SioFamily::Nuvoton) return address == NCT_BANK_SELECT ? bank : regs[(bank << 8) | address];
+    return regs[address];
+}
+
+void SimSuperIo::Out8(uint16_t port, uint8_t value) {
+    Spin();
+    writes++;
+    if (port == configPort) { ConfigWrite(value); return; }
+    if (port == configPort + 1) {
+        if (!configMode) return;
+        if (configIndex == 0x07) logicalDevice = value;
+        else if (configIndex == 0x28 && chip.family == SioFamily::NuvotonEc) globalRegs[0x28] = value;
+        else if (configIndex == 0x02 && chip.family == SioFamily::Ite && (value & 0x02)) configMode = false;    // ITE exit
+        else if (configIndex >= 0x30 && logicalDevice == MonitorLdn(chip.family)) hwmRegs[configIndex] = value;
+        return;
+    }
+    if (port < baseAddr || port > baseAddr + 7 || !Decoded()) return;
+    int offset = port - baseAddr;
+    if (chip.family == SioFamily::NuvotonEc) {
+        if (offset == 4) page = value;
+        else if (offset == 5) address = value;
+        else if (offset == 6 && page != 0xFF) MonitorWrite((uint16_t)((page << 8) | address), value);
+        return;
+    }
+    if (offset == 5) address = value;
+    else if (offset == 6) {
+        if (chip.family == SioFamily::Nuvoton && address == NCT_BANK_SELECT) bank = value;
+        else MonitorWrite(chip.family == SioFamily::Nuvoton ? (uint16_t)((bank << 8) | address) : address, value);
+    }
+}
+
+void SimSuperIo::MonitorWrite(uint16_t reg, uint8_t value) {
+    int pwm = -1;
+    switch (chip.family) {
+    case SioFamily::NuvotonEc:
+        if (reg >= 0x100 && reg < 0x200) return;                    // Sensor page is read-only
+        if (reg >= EC_FAN_PWM && reg < EC_FAN_PWM + 6) pwm = reg - EC_FAN_PWM;
+        if (reg == EC_FAN_REQUEST && value == 0x40) {
+            // Commit: manual-mode fans take their duty registers
+            commits++;
+            for (int i = 0; i < 6; i++) if (regs[EC_FAN_MODE] & (1 << i)) ecApplied[i] = regs[EC_FAN_PWM + i];
+        }
+        break;
+    case SioFamily::Nuvoton:
+        for (int i = 0; i < SIM_FANS; i++) if (reg == NCT_PWM[i]) pwm = i;
+        break;
+    case SioFamily::Ite:
+        for (int i = 0; i < 6; i++) if (reg == ITE_PWM[i]) pwm = i;
+        break;
+    case SioFamily::Fintek:
+        if (reg >= FINTEK_PWM && (reg - FINTEK_PWM) % 0x10 == 0 && (reg - FINTEK_PWM) / 0x10 < 4) pwm = (reg - FINTEK_PWM) / 0x10;
+        break;
+    }
+    if (pwm >= 0) pwmWrites++;
+    regs[reg] = value;
+}
+
+// ---------------------------------------------------------
+//  THERMAL MODEL
+// ---------------------------------------------------------
+void SimThermalModel::Reset(const SimSuperIo& chip) {
+    cpuTempC = vrmTempC = ambientC;
+    for (int i = 0; i < SIM_FANS; i++) fanSpeed[i] = chip.Pwm(i) / 255.0f;
+}
+
+void SimThermalModel::Advance(SimSuperIo& chip, float cpuPowerW, float dtSec) {
+    int fans = chip.PwmChannels();
+    float lag = 1.0f - std::exp(-dtSec / fanLagSec);
+    for (int i = 0; i < fans; i++) fanSpeed[i] += (chip.Pwm(i) / 255.0f - fanSpeed[i]) * lag;
+
+    float caseFans = 0.0f;
+    for (int i = 1; i < fans; i++) caseFans += fanSpeed[i];
+    caseFans /= (std::max)(1, fans - 1);
+
+    // Small fixed sub-steps keep the explicit integration stable for any dt
+    for (float left = dtSec; left > 0.0f; left -= 0.1f) {
+        float h = (std::min)(left, 0.1f);
+        float gCpu = cpuConductIdle + cpuConductFan * fanSpeed[0];
+        float gVrm = vrmConductIdle + vrmConductFan * caseFans;
+        cpuTempC += h * (cpuPowerW - gCpu * (cpuTempC - ambientC)) / cpuHeatCapacity;
+        vrmTempC += h * (cpuPowerW * vrmShare - gVrm * (vrmTempC - ambientC)) / vrmHeatCapacity;
+    }
+    chip.SetSensor(SimSensorKind::Temp, 0, cpuTempC);
+    chip.SetSensor(SimSensorKind::Temp, 2, vrmTempC);
+    chip.SetSensor(SimSensorKind::Temp, 4, cpuTempC - 4.0f);
+    for (int i = 0; i < fans; i++) chip.SetSensor(SimSensorKind::Fan, i, (float)FanRpm(i));
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include "PortIo.hpp"
+#include "SuperIo.hpp"
+#include <cstdint>
+
+// ---------------------------------------------------------
+//  SIMULATED SUPER I/O
+//  A port-level model of every chip in the SuperIo.hpp database. It
+//  covers the config space (entry/exit keys, chip ID, the I/O lock bit,
+//  logical device selection with activate and base-address registers)
+//  and the hardware monitor behind that base. The four monitor interfaces are:
+//    - the NCT6683/6686/6687 EC (paged, base + 4/5/6)
+//    - the NCT67xx/679x bank-switched index/data pair
+//    - the ITE and Fintek 8-bit index/data pairs
+//  Sensor registers follow scripted waveforms on the model's clock;
+//  PWM registers are writable. Every port op is counted and can be
+//  slowed to LPC speed, so sweep cost can be measured and held to a
+//  budget without a board.
+// ---------------------------------------------------------
+// Channels are the same on every family: temps 0 CPU, 1 system, 2 VRM, 3 PCH, 4 SoC;
+// volts 0 +12V, 1 +5V, 2 Vcore, 4 DRAM, 6 SoC (at the pin, before board dividers);
+// fan 0 is the CPU fan. Where each lands in the register file is the family's business.
+enum class SimSensorKind { Temp, Volt, Fan };
+constexpr int SIM_TEMPS = 8;
+constexpr int SIM_VOLTS = 16;
+constexpr int SIM_FANS = 8;
+
+// base + amplitude * shape(t / period); Noise steps every 100 ms and is repeatable
+struct SimWaveform {
+    enum Shape { Const, Sine, Square, Ramp, Noise };
+    Shape shape = Const;
+    float base = 0.0f;
+    float amplitude = 0.0f;
+    float periodSec = 1.0f;
+    float Eval(double t, uint32_t seed) const;
+};
+
+class SimSuperIo : public IPortIo {
+public:
+    explicit SimSuperIo(const SioChip& chip, uint16_t configPort = 0x2E, uint16_t baseAddr = 0xA20);
+
+    uint8_t In8(uint16_t port) override;
+    void Out8(uint16_t port, uint8_t value) override;
+
+    const SioChip& Chip() const { return chip; }
+    uint16_t ConfigPort() const { return configPort; }
+    uint16_t BaseAddr() const { return baseAddr; }
+
+    // Temperatures in C, volts at the ADC pin, fans in RPM
+    void Script(SimSensorKind kind, int channel, const SimWaveform& wave);
+    void SetSensor(SimSensorKind kind, int channel, float value);
+    // What the chip is measuring on a channel right now, before encoding
+    float Value(SimSensorKind kind, int channel) const;
+    // Moves the waveform clock and re-encodes every sensor register
+    void SetTime(double seconds);
+    double Time() const { return now; }
+
+    // Duty the chip is driving fan n at (0-255). The EC only takes new duties
+    // on a commit, and only for fans switched to manual.
+    int PwmChannels() const;
+    uint8_t Pwm(int fan) const;
+    uint64_t PwmWrites() const { return pwmWrites; }
+    uint64_t PwmCommits() const { return commits; }
+
+    // Every In8/Out8 is counted and busy-waits 'ns' first (an LPC cycle is ~1 us)
+    void SetLatencyNs(int ns) { latencyNs = ns; }
+    uint64_t Reads() const { return reads; }
+    uint64_t Writes() const { return writes; }
+    void ResetCounters() { reads = writes = 0; }
+
+    // Hardware-monitor register file, (bank or page << 8) | index
+    uint8_t Reg(uint16_t reg) const { return regs[reg]; }
+    void SetReg(uint16_t reg, uint8_t value) { regs[reg] = value; }
+    // A recorded board: its ID and registers over the defaults. Construct with the
+    // dump's port and base, and don't call SetTime afterwards.
+    void Load(const SioDump& dump);
+
+private:
+    void Encode(SimSensorKind kind, int channel, float value);
+    bool Decoded() const;
+    uint8_t ConfigRead();
+    void ConfigWrite(uint8_t value);
+    void MonitorWrite(uint16_t reg, uint8_t value);
+    void Spin() const;
+
+    const SioChip& chip;
+    uint16_t configPort;
+    uint16_t baseAddr;
+
+    // Config space
+    int keyStep = 0;
+    bool configMode = false;
+    uint8_t configIndex = 0;
+    uint8_t globalRegs[0x30] = {};
+    uint8_t logicalDevice = 0;
+    uint8_t hwmRegs[0x100] = {};        // The hardware monitor's logical device
+
+    // Hardware monitor
+    int page = 0xFF;                    // EC page, or 0xFF while released
+    uint8_t bank = 0;                   // Nuvoton bank (register 0x4E)
+    uint8_t address = 0;
+    uint8_t regs[0x10000] = {};
+    uint8_t ecApplied[SIM_FANS] = {};   // EC duties in effect since the last commit
+
+    SimWaveform waves[3][SIM_VOLTS];
+    double now = 0.0;
+
+    int latencyNs = 0;
+    uint64_t reads = 0, writes = 0;
+    uint64_t pwmWrites = 0, commits = 0;
+};
+
+// ---------------------------------------------------------
+//  THERMAL MODEL
+//  Two nodes on top of any simulated chip: the CPU die + cooler on
+//  fan 0, the VRM on the remaining fans. Reads the duties the chip is
+//  driving and writes back temperatures and tach readings.
+// ---------------------------------------------------------
+struct SimThermalModel {
+    float ambientC = 25.0f;
+    float cpuHeatCapacity = 60.0f;      // J/K, die + heatsink
+    float cpuConductIdle = 0.6f;        // W/K with the fan stopped
+    float cpuConductFan = 3.4f;         // Extra W/K at full fan speed
+    float vrmHeatCapacity = 30.0f;
+    float vrmConductIdle = 0.3f;
+    float vrmConductFan = 1.2f;
+    float vrmShare = 0.12f;             // VRM loss as a share of CPU power
+    float fanLagSec = 1.5f;             // Tach follows duty with this time constant
+    int fanMaxRpm = 2000;
+
+    float cpuTempC = 25.0f;
+    float vrmTempC = 25.0f;
+    float fanSpeed[SIM_FANS] = {};      // 0-1, lagging the duty
+
+    // Starts at ambient with the fans already turning at the chip's duties
+    void Reset(const SimSuperIo& chip);
+    void Advance(SimSuperIo& chip, float cpuPowerW, float dtSec);
+    int FanRpm(int fan) const { return (int)(fanSpeed[fan] * fanMaxRpm); }
+};
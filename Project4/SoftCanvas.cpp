@@ -0,0 +1,294 @@
+#include "SoftCanvas.hpp"
+#include "GlyphAtlas.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFT_SSE2 1
+#endif
+
+// ---------------------------------------------------------
+//  PIXEL MATH (premultiplied 0xAARRGGBB)
+// ---------------------------------------------------------
+static inline uint32_t Div255(uint32_t x) { x += 128; return (x + (x >> 8)) >> 8; }
+
+static uint32_t Premultiply(UiRgba c) {
+    return ((uint32_t)c.a << 24) | (Div255(c.r * c.a) << 16) | (Div255(c.g * c.a) << 8) | Div255(c.b * c.a);
+}
+
+// Every channel of a premultiplied colour times coverage/255
+static inline uint32_t Scale(uint32_t p, uint32_t k) {
+    return (Div255((p >> 24) * k) << 24) | (Div255(((p >> 16) & 0xFF) * k) << 16) |
+        (Div255(((p >> 8) & 0xFF) * k) << 8) | Div255((p & 0xFF) * k);
+}
+
+static inline uint32_t Over(uint32_t src, uint32_t dst) {
+    uint32_t inv = 255 - (src >> 24);
+    uint32_t rb = (dst & 0x00FF00FF) * inv + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    uint32_t ag = ((dst >> 8) & 0x00FF00FF) * inv + 0x00800080;
+    ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+    return src + rb + ag;   // Cannot carry: src channels never exceed src alpha
+}
+
+#ifdef SOFT_SSE2
+static inline __m128i Div255x8(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+#endif
+
+static void SpanOver(uint32_t* d, int n, uint32_t src) {
+    if ((src >> 24) == 255) { std::fill(d, d + n, src); return; }
+    if (src == 0) return;
+    int i = 0;
+#ifdef SOFT_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i s = _mm_set1_epi32((int)src);
+    const __m128i inv = _mm_set1_epi16((short)(255 - (src >> 24)));
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(d + i));
+        __m128i lo = Div255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), inv));
+        __m128i hi = Div255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), inv));
+        _mm_storeu_si128((__m128i*)(d + i), _mm_add_epi8(_mm_packus_epi16(lo, hi), s));
+    }
+#endif
+    for (; i < n; i++) d[i] = Over(src, d[i]);
+}
+
+static void MaskOver(uint32_t* d, const uint8_t* mask, int n, uint32_t src) {
+    int i = 0;
+#ifdef SOFT_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c255 = _mm_set1_epi16(255);
+    const __m128i p = _mm_unpacklo_epi8(_mm_set1_epi32((int)src), zero);
+    for (; i + 4 <= n; i += 4) {
+        uint32_t m4; memcpy(&m4, mask + i, 4);
+        if (m4 == 0) continue;
+        __m128i m = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)m4), zero);
+        m = _mm_unpacklo_epi16(m, m);
+        __m128i slo = Div255x8(_mm_mullo_epi16(p, _mm_unpacklo_epi32(m, m)));
+        __m128i shi = Div255x8(_mm_mullo_epi16(p, _mm_unpackhi_epi32(m, m)));
+        __m128i ilo = _mm_sub_epi16(c255, _mm_shufflehi_epi16(_mm_shufflelo_epi16(slo, 0xFF), 0xFF));
+        __m128i ihi = _mm_sub_epi16(c255, _mm_shufflehi_epi16(_mm_shufflelo_epi16(shi, 0xFF), 0xFF));
+        __m128i v = _mm_loadu_si128((const __m128i*)(d + i));
+        __m128i lo = _mm_add_epi16(Div255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), ilo)), slo);
+        __m128i hi = _mm_add_epi16(Div255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), ihi)), shi);
+        _mm_storeu_si128((__m128i*)(d + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < n; i++) {
+        if (mask[i]) d[i] = Over(Scale(src, mask[i]), d[i]);
+    }
+}
+
+// Signed distance from a pixel centre to a rounded rect's outline (negative inside)
+struct RoundRectShape {
+    float cx, cy, hw, hh, rad;
+    RoundRectShape(const UiRect& r, int diameter) {
+        hw = r.w * 0.5f; hh = r.h * 0.5f;
+        cx = r.x + hw; cy = r.y + hh;
+        rad = (std::clamp)(diameter * 0.5f, 0.0f, (std::min)(hw, hh));
+    }
+    float Distance(int x, int y) const {
+        float qx = std::fabs(x + 0.5f - cx) - (hw - rad), qy = std::fabs(y + 0.5f - cy) - (hh - rad);
+        float ox = (std::max)(qx, 0.0f), oy = (std::max)(qy, 0.0f);
+        return std::sqrt(ox * ox + oy * oy) + (std::min)((std::max)(qx, qy), 0.0f) - rad;
+    }
+};
+
+static inline uint8_t ToCoverage(float c) { return (uint8_t)((std::clamp)(c, 0.0f, 1.0f) * 255.0f + 0.5f); }
+
+// ---------------------------------------------------------
+//  CANVAS
+// ---------------------------------------------------------
+SoftCanvas::SoftCanvas(int w, int h) { Resize(w, h); }
+
+SoftCanvas::SoftCanvas(uint32_t* bits, int w, int h) : width(w), height(h), pixels(bits) { ResetClip(); }
+
+void SoftCanvas::Resize(int w, int h) {
+    width = w;
+    height = h;
+    storage.assign((size_t)w * h, 0);
+    pixels = storage.data();
+    ResetClip();
+}
+
+void SoftCanvas::SetClip(const UiRect& r) { clip = r.Intersect({ 0, 0, width, height }); }
+
+void SoftCanvas::ResetClip() { clip = { 0, 0, width, height }; }
+
+void SoftCanvas::Clear() {
+    for (int y = clip.y; y < clip.Bottom(); y++) std::fill_n(pixels + (size_t)y * width + clip.x, clip.w, 0u);
+}
+
+void SoftCanvas::BlendSpan(int x, int y, int n, UiRgba color, int coverage) {
+    if (y < clip.y || y >= clip.Bottom()) return;
+    int x0 = (std::max)(x, clip.x), x1 = (std::min)(x + n, clip.Right());
+    if (x1 <= x0 || coverage <= 0) return;
+    SpanOver(pixels + (size_t)y * width + x0, x1 - x0, Scale(Premultiply(color), (uint32_t)coverage));
+}
+
+void SoftCanvas::BlendMask(int x, int y, const uint8_t* mask, int n, UiRgba color) {
+    if (y < clip.y || y >= clip.Bottom()) return;
+    int x0 = (std::max)(x, clip.x), x1 = (std::min)(x + n, clip.Right());
+    if (x1 <= x0) return;
+    MaskOver(pixels + (size_t)y * width + x0, mask + (x0 - x), x1 - x0, Premultiply(color));
+}
+
+void SoftCanvas::FillRoundRect(const UiRect& r, int diameter, UiRgba color) {
+    UiRect area = r.Intersect(clip);
+    if (area.Empty() || color.a == 0) return;
+    RoundRectShape shape(r, diameter);
+    int band = (int)std::ceil(shape.rad);
+    // Only the corner cells of the first and last 'band' rows are partially covered
+    int leftEnd = (std::min)(r.x + band, r.Right());
+    int rightStart = (std::max)(r.Right() - band, leftEnd);
+    uint8_t mask[256];
+    for (int y = area.y; y < area.Bottom(); y++) {
+        if (y >= r.y + band && y < r.Bottom() - band) { BlendSpan(r.x, y, r.w, color, 255); continue; }
+        int n = (std::min)(leftEnd - r.x, 256);
+        for (int i = 0; i < n; i++) mask[i] = ToCoverage(0.5f - shape.Distance(r.x + i, y));
+        BlendMask(r.x, y, mask, n, color);
+        BlendSpan(leftEnd, y, rightStart - leftEnd, color, 255);
+        n = (std::min)(r.Right() - rightStart, 256);
+        for (int i = 0; i < n; i++) mask[i] = ToCoverage(0.5f - shape.Distance(rightStart + i, y));
+        BlendMask(rightStart, y, mask, n, color);
+    }
+}
+
+void SoftCanvas::StrokeRoundRect(const UiRect& r, int diameter, UiRgba color) {
+    UiRect outer = { r.x - 1, r.y - 1, r.w + 2, r.h + 2 };
+    UiRect area = outer.Intersect(clip);
+    if (area.Empty() || color.a == 0) return;
+    RoundRectShape shape(r, diameter);
+    int band = (int)std::ceil(shape.rad) + 1;
+    if ((int)scratch.size() < outer.w) scratch.resize(outer.w);
+    uint8_t* mask = scratch.data();
+    for (int y = area.y; y < area.Bottom(); y++) {
+        if (y >= r.y + band && y < r.Bottom() - band) {
+            // Straight sides: the outline sits on a pixel boundary, so two half-covered columns each
+            BlendSpan(r.x - 1, y, 2, color, 128);
+            BlendSpan(r.Right() - 1, y, 2, color, 128);
+            continue;
+        }
+        for (int i = 0; i < outer.w; i++) mask[i] = ToCoverage(1.0f - std::fabs(shape.Distance(outer.x + i, y)));
+        BlendMask(outer.x, y, mask, outer.w, color);
+    }
+}
+
+int SoftCanvas::MeasureText(const wchar_t* str, UiFont font) {
+    return text.Layout(font, str).width;
+}
+
+void SoftCanvas::DrawText(const wchar_t* str, UiFont font, int x, int y, UiRgba color) {
+    const GlyphAtlas& atlas = GlyphAtlas::Get();
+    const TextRun& run = text.Layout(font, str);
+    // Only the quads that touch the clip are blitted, so a narrow dirty rect costs a few glyphs
+    for (size_t i = 0; i < run.pen.size(); i++) {
+        const GlyphInfo& g = atlas.Glyph(font, str[i]);
+        int gx = x + run.pen[i] + g.left, gy = y + g.top;
+        if (gx >= clip.Right()) break;
+        if (gx + g.w <= clip.x || str[i] == L' ') continue;
+        int y0 = (std::max)(gy, clip.y), y1 = (std::min)(gy + (int)g.h, clip.Bottom());
+        for (int row = y0; row < y1; row++) BlendMask(gx, row, atlas.Row(g.y + row - gy) + g.x, g.w, color);
+    }
+}
+
+// ---------------------------------------------------------
+//  IMAGE DUMPS
+// ---------------------------------------------------------
+bool SoftCanvas::WritePpm(const char* path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file << "P6\n" << width << " " << height << "\n255\n";
+    std::vector<uint8_t> row((size_t)width * 3);
+    for (int y = 0; y < height; y++) {
+        const uint32_t* src = pixels + (size_t)y * width;
+        for (int x = 0; x < width; x++) {
+            row[x * 3 + 0] = (uint8_t)(src[x] >> 16);
+            row[x * 3 + 1] = (uint8_t)(src[x] >> 8);
+            row[x * 3 + 2] = (uint8_t)src[x];
+        }
+        file.write((const char*)row.data(), row.size());
+    }
+    return (bool)file;
+}
+
+static uint32_t Crc32(uint32_t crc, const uint8_t* p, size_t n) {
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+    crc = ~crc;
+    while (n--) crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void PutBe32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)(v >> 24)); out.push_back((uint8_t)(v >> 16)); out.push_back((uint8_t)(v >> 8)); out.push_back((uint8_t)v);
+}
+
+static void PngChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> chunk;
+    PutBe32(chunk, (uint32_t)data.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    PutBe32(chunk, Crc32(0, chunk.data() + 4, chunk.size() - 4));
+    file.write((const char*)chunk.data(), chunk.size());
+}
+
+bool SoftCanvas::WritePng(const char* path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    file.write((const char*)signature, 8);
+
+    std::vector<uint8_t> ihdr;
+    PutBe32(ihdr, (uint32_t)width); PutBe32(ihdr, (uint32_t)height);
+    ihdr.insert(ihdr.end(), { 8, 6, 0, 0, 0 });     // 8-bit RGBA, no interlace
+    PngChunk(file, "IHDR", ihdr);
+
+    // Filter byte 0 per scanline, straight (unpremultiplied) RGBA
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t)height * (width * 4 + 1));
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        const uint32_t* src = pixels + (size_t)y * width;
+        for (int x = 0; x < width; x++) {
+            uint32_t p = src[x], a = p >> 24;
+            auto straight = [a](uint32_t c) { return (uint8_t)(a ? (std::min)((c * 255 + a / 2) / a, 255u) : 0); };
+            raw.push_back(straight((p >> 16) & 0xFF));
+            raw.push_back(straight((p >> 8) & 0xFF));
+            raw.push_back(straight(p & 0xFF));
+            raw.push_back((uint8_t)a);
+        }
+    }
+
+    // zlib stream of stored deflate blocks
+    std::vector<uint8_t> idat = { 0x78, 0x01 };
+    uint32_t s1 = 1, s2 = 0;
+    for (uint8_t b : raw) { s1 = (s1 + b) % 65521; s2 = (s2 + s1) % 65521; }
+    size_t pos = 0;
+    do {
+        size_t len = (std::min)(raw.size() - pos, (size_t)65535);
+        idat.push_back(pos + len == raw.size() ? 1 : 0);
+        idat.push_back((uint8_t)len); idat.push_back((uint8_t)(len >> 8));
+        idat.push_back((uint8_t)~len); idat.push_back((uint8_t)(~len >> 8));
+        idat.insert(idat.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+    } while (pos < raw.size());
+    PutBe32(idat, (s2 << 16) | s1);
+    PngChunk(file, "IDAT", idat);
+    PngChunk(file, "IEND", {});
+    return (bool)file;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "TextLayout.hpp"
+#include "UiCanvas.hpp"
+
+// ---------------------------------------------------------
+//  SOFTWARE CANVAS
+//  Portable IUiCanvas into an in-memory premultiplied BGRA buffer,
+//  the same layout UpdateLayeredWindow takes. Rounded rects are
+//  anti-aliased from their distance field at the corners and filled
+//  with SIMD span blends elsewhere; text blits cached runs of
+//  GlyphAtlas quads.
+// ---------------------------------------------------------
+class SoftCanvas : public IUiCanvas {
+public:
+    SoftCanvas(int w, int h);
+    // Draws into caller-owned memory (e.g. a DIB section), stride w
+    SoftCanvas(uint32_t* bits, int w, int h);
+    void Resize(int w, int h);
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    // Row-major 0xAARRGGBB, premultiplied; stride is Width()
+    const uint32_t* Pixels() const { return pixels; }
+    uint32_t* Pixels() { return pixels; }
+    TextLayoutCache& Text() { return text; }
+
+    void SetClip(const UiRect& r) override;
+    void ResetClip() override;
+    void Clear() override;
+    void FillRoundRect(const UiRect& r, int diameter, UiRgba color) override;
+    void StrokeRoundRect(const UiRect& r, int diameter, UiRgba color) override;
+    int MeasureText(const wchar_t* text, UiFont font) override;
+    void DrawText(const wchar_t* text, UiFont font, int x, int y, UiRgba color) override;
+
+    // Binary PPM, composited over black
+    bool WritePpm(const char* path) const;
+    // 8-bit RGBA PNG (stored deflate, no compression library needed)
+    bool WritePng(const char* path) const;
+
+private:
+    void BlendSpan(int x, int y, int n, UiRgba color, int coverage);
+    void BlendMask(int x, int y, const uint8_t* mask, int n, UiRgba color);
+
+    int width = 0, height = 0;
+    UiRect clip;
+    uint32_t* pixels = nullptr;
+    std::vector<uint32_t> storage;  // Empty when drawing into external memory
+    TextLayoutCache text;
+    std::vector<uint8_t> scratch;  // Stroke coverage row, kept to avoid per-frame allocation
+};
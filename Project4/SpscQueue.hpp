@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// Bounded single-producer / single-consumer ring.
+// Neither side blocks or allocates; TryPush fails when the ring is full.
+// Head and tail live on separate cache lines so the two threads do not
+// bounce one line between them.
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert((N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscQueue payload must be trivially copyable");
+
+public:
+    // Producer side
+    bool TryPush(const T& value) {
+        size_t tail = this->tail.load(std::memory_order_relaxed);
+        if (tail - head.load(std::memory_order_acquire) == N) return false;
+        items[tail & (N - 1)] = value;
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool TryPop(T& out) {
+        size_t head = this->head.load(std::memory_order_relaxed);
+        if (head == tail.load(std::memory_order_acquire)) return false;
+        out = items[head & (N - 1)];
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+
+private:
+    alignas(64) std::atomic<size_t> head{ 0 };
+    alignas(64) std::atomic<size_t> tail{ 0 };
+    alignas(64) T items[N];
+};
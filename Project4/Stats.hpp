@@ -0,0 +1,80 @@
+#pragma once
+#include "GpuMemory.hpp"
+
+// ---------------------------------------------------------
+//  STATS SNAPSHOT
+//  Each section has exactly one writer thread (the poll scheduler) and is published
+//  through its own SeqLock. The renderer copies all sections once
+//  per frame via ReadStats() and never takes a lock.
+// ---------------------------------------------------------
+constexpr int MAX_CORES = 256;
+constexpr int MAX_DRIVES = 26;
+
+struct CpuStats {           // Writer: PollCpu
+    int usage = 0;
+    int coreCount = 0;
+    int coreLoad[MAX_CORES] = {};
+    int avgMhz = 0;             // 0 = no clock source
+    int baseMhz = 0;
+    int throttledCores = 0;
+    int coreMhz[MAX_CORES] = {};
+};
+
+// Writers: PollBoard and PollSystemCounters. Both run on the poll scheduler thread and
+// publish one shared copy (s_Board), so the section still has a single writer.
+struct BoardStats {
+    int cpuTemp = 0;
+    int tempVRM = 0;
+    int tempPCH = 0;
+    int tempSocket = 0;
+    int tempSystem = 0;
+    float volt12V = 0.0f;
+    float volt5V = 0.0f;
+    float voltVCore = 0.0f;
+    float voltDram = 0.0f;
+    float voltSoC = 0.0f;
+    int fanRPM = 0;
+    int globalThreads = 0;
+    int contextSwitches = 0;
+};
+
+struct MemStats {           // Writer: UpdateMemory
+    int load = 0;
+    unsigned long long usedBytes = 0;
+    unsigned long long totalBytes = 0;
+};
+
+struct GpuAdapterStats {
+    wchar_t name[64] = {};
+    unsigned long long vramUsed = 0;
+    unsigned long long vramTotal = 0;
+    unsigned long long vramBudget = 0;
+};
+
+struct GpuStats {           // Writer: UpdateGpuVram
+    unsigned long long vramUsed = 0;    // Primary adapter
+    unsigned long long vramTotal = 0;
+    int adapterCount = 0;
+    GpuAdapterStats adapters[MAX_GPUS];
+};
+
+struct StorageStats {       // Writer: PollStorage
+    int driveCount = 0;
+    wchar_t drives[MAX_DRIVES][4] = {};
+};
+
+struct BatteryStats {       // Writer: UpdateBattery
+    bool present = false;
+    bool charging = false;
+    int pct = 0;
+    int lifeSeconds = -1;
+};
+
+struct StatsSnapshot {
+    CpuStats cpu;
+    BoardStats board;
+    MemStats mem;
+    GpuStats gpu;
+    StorageStats storage;
+    BatteryStats battery;
+};
@@ -0,0 +1,429 @@
+#include "SuperIo.hpp"
+#include "ChipDefs.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+// ---------------------------------------------------------
+//  CHIP DATABASE
+// ---------------------------------------------------------
+static const SioChip SIO_CHIPS[] = {
+    { CHIP_IT8613E, "IT8613E", SioFamily::Ite, 11.0f },
+    { CHIP_IT8620E, "IT8620E", SioFamily::Ite, 12.0f },
+    { CHIP_IT8625E, "IT8625E", SioFamily::Ite, 11.0f },
+    { CHIP_IT8628E, "IT8628E", SioFamily::Ite, 12.0f },
+    { CHIP_IT8631E, "IT8631E", SioFamily::Ite, 11.0f },
+    { CHIP_IT8637E, "IT8637E", SioFamily::Ite, 11.0f },
+    { CHIP_IT8655E, "IT8655E", SioFamily::Ite, 11.0f },
+    { CHIP_IT8665E, "IT8665E", SioFamily::Ite, 11.0f },
+    { CHIP_IT8686E, "IT8686E", SioFamily::Ite, 12.0f },
+    { CHIP_IT8688E, "IT8688E", SioFamily::Ite, 12.0f },
+    { CHIP_IT8689E, "IT8689E", SioFamily::Ite, 12.0f },
+    { CHIP_IT8695E, "IT8695E", SioFamily::Ite, 12.0f },
+    { CHIP_IT8705F, "IT8705F", SioFamily::Ite, 16.0f },
+    { CHIP_IT8712F, "IT8712F", SioFamily::Ite, 16.0f },
+    { CHIP_IT8716F, "IT8716F", SioFamily::Ite, 16.0f },
+    { CHIP_IT8718F, "IT8718F", SioFamily::Ite, 16.0f },
+    { CHIP_IT8720F, "IT8720F", SioFamily::Ite, 16.0f },
+    { CHIP_IT8721F, "IT8721F", SioFamily::Ite, 12.0f },
+    { CHIP_IT8726F, "IT8726F", SioFamily::Ite, 16.0f },
+    { CHIP_IT8728F, "IT8728F", SioFamily::Ite, 12.0f },
+    { CHIP_IT8733E, "IT8733E", SioFamily::Ite, 11.0f },
+    { CHIP_IT8771E, "IT8771E", SioFamily::Ite, 12.0f },
+    { CHIP_IT8772E, "IT8772E", SioFamily::Ite, 12.0f },
+    { CHIP_IT8792E, "IT8792E", SioFamily::Ite, 11.0f },
+
+    // NCT6775F/6776F keep voltages at bank 0 0x20-0x26 and fan counts at 0x630/0x656, and the
+    // NCT610x lay out their monitor differently again; no recorded board has checked a map for them
+    { CHIP_NCT6102D, "NCT6102D", SioFamily::Nuvoton, 8.0f, true },  // Same ID as NCT6106D
+    { CHIP_NCT6683D, "NCT6683D", SioFamily::NuvotonEc, 1.0f },
+    { CHIP_NCT6686D, "NCT6686D", SioFamily::NuvotonEc, 1.0f },
+    { CHIP_NCT6687D, "NCT6687D", SioFamily::NuvotonEc, 1.0f },
+    { CHIP_NCT6687D_R, "NCT6687D-R", SioFamily::NuvotonEc, 1.0f },
+    { CHIP_NCT6775F, "NCT6775F", SioFamily::Nuvoton, 8.0f, true },  // Same ID as NCT6771F/6772F
+    { CHIP_NCT6776F, "NCT6776F", SioFamily::Nuvoton, 8.0f, true },
+    { CHIP_NCT6779D, "NCT6779D", SioFamily::Nuvoton, 8.0f },
+    { CHIP_NCT6791D, "NCT6791D", SioFamily::Nuvoton, 8.0f },
+    { CHIP_NCT6792D, "NCT6792D", SioFamily::Nuvoton, 8.0f },
+    { CHIP_NCT6793D, "NCT6793D", SioFamily::Nuvoton, 8.0f },
+    { CHIP_NCT6795D, "NCT6795D", SioFamily::Nuvoton, 8.0f },
+    { CHIP_NCT6796D, "NCT6796D", SioFamily::Nuvoton, 8.0f },
+    { CHIP_NCT6797D, "NCT6797D", SioFamily::Nuvoton, 8.0f },
+    { CHIP_NCT6798D, "NCT6798D", SioFamily::Nuvoton, 8.0f },
+    { CHIP_NCT6799D, "NCT6799D", SioFamily::Nuvoton, 8.0f },
+
+    { CHIP_F71808E, "F71808E", SioFamily::Fintek, 8.0f },
+    { CHIP_F71858, "F71858", SioFamily::Fintek, 8.0f },
+    { CHIP_F71862, "F71862", SioFamily::Fintek, 8.0f },
+    { CHIP_F71869, "F71869", SioFamily::Fintek, 8.0f },
+    { CHIP_F71882, "F71882", SioFamily::Fintek, 8.0f },
+    { CHIP_F71889, "F71889", SioFamily::Fintek, 8.0f },
+};
+
+int SioChipCount() { return (int)(sizeof(SIO_CHIPS) / sizeof(SIO_CHIPS[0])); }
+const SioChip& SioChipAt(int i) { return SIO_CHIPS[i]; }
+
+const SioChip* FindSioChip(uint16_t id) {
+    for (const SioChip& c : SIO_CHIPS) if (c.id == id) return &c;
+    return nullptr;
+}
+
+const SioChip* FindSioChip(const char* nameOrId) {
+    for (const SioChip& c : SIO_CHIPS) {
+        size_t i = 0;
+        while (c.name[i] && toupper((unsigned char)nameOrId[i]) == c.name[i]) i++;
+        if (!c.name[i] && !nameOrId[i]) return &c;
+    }
+    char* end;
+    unsigned long id = strtoul(nameOrId, &end, 16);
+    return (*end == 0 && end != nameOrId) ? FindSioChip((uint16_t)id) : nullptr;
+}
+
+const char* SioFamilyName(SioFamily family) {
+    switch (family) {
+    case SioFamily::NuvotonEc: return "nuvoton-ec";
+    case SioFamily::Nuvoton: return "nuvoton";
+    case SioFamily::Ite: return "ite";
+    default: return "fintek";
+    }
+}
+
+const SioChip* MatchSioChip(uint16_t id) {
+    if (const SioChip* exact = FindSioChip(id)) return exact;
+    for (const SioChip& c : SIO_CHIPS) {
+        bool nuvoton = c.family == SioFamily::Nuvoton || c.family == SioFamily::NuvotonEc;
+        if (nuvoton && (c.id & 0xFFF8) == (id & 0xFFF8)) return &c;
+    }
+    return nullptr;
+}
+
+// ---------------------------------------------------------
+//  REGISTER MAPS
+// ---------------------------------------------------------
+using F = SioFormat;
+
+static constexpr SioRegisterMap SIO_MAP_EC = {
+    SioFamily::NuvotonEc, "nct", 0x0B,
+    {
+        { 0x100, 0x101, F::TempHalf }, { 0x102, 0x103, F::TempHalf }, { 0x104, 0x105, F::TempHalf },
+        { 0x106, 0x107, F::TempHalf }, { 0x108, 0x109, F::TempHalf },
+        { 0x120, 0x121, F::VoltEc, 12.0f }, { 0x122, 0x123, F::VoltEc, 5.0f }, { 0x124, 0x125, F::VoltEc, 1.0f },
+        { 0x128, 0x129, F::VoltEc, 2.0f }, { 0x12C, 0x12D, F::VoltEc, 1.0f },
+        { 0x140, 0x141, F::Rpm16 }, { 0x142, 0x143, F::Rpm16 }, { 0x144, 0x145, F::Rpm16 },
+    },
+    { 0xA28, 0xA29, 0xA2A, 0xA2B, 0xA2C, 0xA2D }, 6,
+};
+
+static constexpr SioRegisterMap SIO_MAP_NUVOTON = {
+    SioFamily::Nuvoton, "nct", 0x0B,
+    {
+        { 0x073, 0x074, F::TempHalf }, { 0x075, 0x076, F::TempHalf }, { 0x077, 0x078, F::TempHalf },
+        { 0x079, 0x07A, F::TempHalf }, { 0x07B, 0x07C, F::TempHalf },
+        { 0x480, 0, F::Volt8, 12.0f }, { 0x481, 0, F::Volt8, 5.0f }, { 0x482, 0, F::Volt8, 1.0f },
+        { 0x484, 0, F::Volt8, 2.0f }, { 0x486, 0, F::Volt8, 1.0f },
+        { 0x4C0, 0x4C1, F::Rpm16 }, { 0x4C2, 0x4C3, F::Rpm16 }, { 0x4C4, 0x4C5, F::Rpm16 },
+    },
+    { 0x109, 0x209, 0x309, 0x809, 0x909, 0xA09, 0xB09 }, 7,
+};
+
+static constexpr SioRegisterMap SIO_MAP_ITE = {
+    SioFamily::Ite, "ite", 0x04,
+    {
+        { 0x29, 0, F::Temp8 }, { 0x2A, 0, F::Temp8 }, { 0x2B, 0, F::Temp8 }, { 0x2C, 0, F::Temp8 }, { 0x2D, 0, F::Temp8 },
+        { 0x20, 0, F::Volt8, 12.0f }, { 0x21, 0, F::Volt8, 5.0f }, { 0x22, 0, F::Volt8, 1.0f },
+        { 0x24, 0, F::Volt8, 2.0f }, { 0x26, 0, F::Volt8, 1.0f },
+        { 0x18, 0x0D, F::IteTach }, { 0x19, 0x0E, F::IteTach }, { 0x1A, 0x0F, F::IteTach },
+    },
+    { 0x63, 0x6B, 0x73, 0x7B, 0xA3, 0xAB }, 6,
+};
+
+static constexpr SioRegisterMap SIO_MAP_FINTEK = {
+    SioFamily::Fintek, "f718", 0x04,
+    {
+        { 0x72, 0, F::Temp8 }, { 0x74, 0, F::Temp8 }, { 0x76, 0, F::Temp8 }, {}, {},
+        { 0x20, 0, F::Volt8, 12.0f }, { 0x21, 0, F::Volt8, 5.0f }, { 0x22, 0, F::Volt8, 1.0f },
+        { 0x24, 0, F::Volt8, 2.0f }, { 0x26, 0, F::Volt8, 1.0f },
+        { 0xA0, 0xA1, F::FintekTach }, { 0xB0, 0xB1, F::FintekTach }, { 0xC0, 0xC1, F::FintekTach },
+    },
+    { 0xA3, 0xB3, 0xC3, 0xD3 }, 4,
+};
+
+// Bytes a map reads, counted twice where shared; an upper bound on the sweep buffer
+static constexpr int MapBytes(const SioRegisterMap& map) {
+    int n = 0;
+    for (const SioSensorDef& d : map.sensors) n += (d.reg ? 1 : 0) + (d.reg2 ? 1 : 0);
+    return n;
+}
+static_assert(MapBytes(SIO_MAP_EC) <= SIO_MAX_SWEEP_BYTES && MapBytes(SIO_MAP_NUVOTON) <= SIO_MAX_SWEEP_BYTES);
+static_assert(MapBytes(SIO_MAP_ITE) <= SIO_MAX_SWEEP_BYTES && MapBytes(SIO_MAP_FINTEK) <= SIO_MAX_SWEEP_BYTES);
+static_assert(SIO_SENSOR_COUNT <= NCT_MAX_SENSORS);
+
+const SioRegisterMap& SioMap(SioFamily family) {
+    switch (family) {
+    case SioFamily::NuvotonEc: return SIO_MAP_EC;
+    case SioFamily::Nuvoton: return SIO_MAP_NUVOTON;
+    case SioFamily::Ite: return SIO_MAP_ITE;
+    default: return SIO_MAP_FINTEK;
+    }
+}
+
+const char* SioSensorRole(SioSensor sensor) {
+    static const char* roles[SIO_SENSOR_COUNT] = {
+        "cpu_temp", "system_temp", "vrm_temp", "pch_temp", "soc_temp",
+        "12v", "5v", "vcore", "vdram", "vsoc",
+        "cpu_fan", "sys_fan1", "sys_fan2",
+    };
+    return roles[sensor];
+}
+
+SensorUnit SioSensorUnit(SioSensor sensor) {
+    if (sensor <= SIO_TEMP_SOC) return SensorUnit::Celsius;
+    if (sensor <= SIO_VOLT_SOC) return SensorUnit::Volt;
+    return SensorUnit::Rpm;
+}
+
+float DecodeSioValue(const SioSensorDef& def, uint8_t first, uint8_t second, float voltLsbMv) {
+    int count = (first << 8) | second;
+    switch (def.format) {
+    case F::TempHalf: return DecodeNct6687_Temp(first, second);
+    case F::Temp8: return (float)(int8_t)first;
+    case F::VoltEc: return DecodeNct6687_Voltage(first, second, def.multiplier);
+    case F::Volt8: return first * voltLsbMv * 0.001f * def.multiplier;
+    case F::Rpm16: return (float)count;
+    // A stopped fan never completes a period: the counter reads all ones (or 0 before the first)
+    case F::IteTach: return (count == 0 || count == 0xFFFF) ? 0.0f : (float)(1350000 / (2 * count));
+    case F::FintekTach: return (count == 0 || count == 0xFFFF) ? 0.0f : (float)(1500000 / count);
+    }
+    return 0.0f;
+}
+
+// ---------------------------------------------------------
+//  DETECTION
+// ---------------------------------------------------------
+constexpr uint8_t SIO_EC_LOCK_BIT = 0x10;       // Global 0x28 on the EC parts
+constexpr uint16_t FINTEK_VENDOR_ID = 0x1934;
+constexpr uint8_t NUVOTON_BANK_SELECT = 0x4E;
+
+static int ReadConfigWord(IPortIo& io, int port, uint8_t index) {
+    io.Out8(port, index); int high = io.In8(port + 1);
+    io.Out8(port, index + 1); int low = io.In8(port + 1);
+    return (high << 8) | low;
+}
+
+// In config mode: unlock, select and activate the hardware monitor, read its base
+static void EnableMonitor(IPortIo& io, int port, const SioChip& chip, SioDetectResult& out) {
+    if (chip.family == SioFamily::NuvotonEc) {
+        // MSI firmware leaves the EC's I/O space locked
+        io.Out8(port, 0x28);
+        int options = io.In8(port + 1);
+        if (options & SIO_EC_LOCK_BIT) io.Out8(port + 1, options & ~SIO_EC_LOCK_BIT);
+    }
+    io.Out8(port, 0x07); io.Out8(port + 1, SioMap(chip.family).monitorLdn);
+    io.Out8(port, 0x30);
+    if ((io.In8(port + 1) & 0x01) == 0) io.Out8(port + 1, 0x01);
+    out.baseAddr = ReadConfigWord(io, port, 0x60) & 0xFFF8;
+    out.chip = &chip;
+    out.port = port;
+}
+
+bool DetectSuperIo(IPortIo& io, SioDetectResult& out) {
+    out = SioDetectResult();
+    const int ports[] = { 0x4E, 0x2E };
+    for (int port : ports) {
+        // Nuvoton and Fintek: 87 87 in, AA out
+        io.Out8(port, 0x87); io.Out8(port, 0x87);
+        int id = ReadConfigWord(io, port, 0x20);
+        if (id != 0 && id != 0xFFFF) {
+            out.lastId = id;
+            const SioChip* chip = MatchSioChip((uint16_t)id);
+            if (chip && chip->family == SioFamily::Fintek && ReadConfigWord(io, port, 0x23) != FINTEK_VENDOR_ID) chip = nullptr;
+            if (chip && chip->family != SioFamily::Ite) { out.chipId = id; EnableMonitor(io, port, *chip, out); }
+            io.Out8(port, 0xAA);
+            if (out.chip) return true;
+            continue;   // Something is in config mode here; the ITE key is not ours to send
+        }
+        io.Out8(port, 0xAA);
+
+        // ITE: 87 01 55 55 (55 AA on 0x4E) in, bit 1 of CR02 out
+        io.Out8(port, 0x87); io.Out8(port, 0x01); io.Out8(port, 0x55); io.Out8(port, port == 0x4E ? 0xAA : 0x55);
+        id = ReadConfigWord(io, port, 0x20);
+        if (id == 0 || id == 0xFFFF) continue;
+        out.lastId = id;
+        const SioChip* chip = FindSioChip((uint16_t)id);
+        if (chip && chip->family == SioFamily::Ite) { out.chipId = id; EnableMonitor(io, port, *chip, out); }
+        io.Out8(port, 0x02); io.Out8(port + 1, 0x02);
+        if (out.chip) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------
+//  SWEEP
+// ---------------------------------------------------------
+int SioSweep::PortOps() const {
+    if (family == SioFamily::NuvotonEc) {
+        int pages = 0, last = -1;
+        for (int r = 0; r < ec.runCount; r++) if ((ec.runs[r].startReg >> 8) != last) { last = ec.runs[r].startReg >> 8; pages++; }
+        return ec.runCount ? 2 + pages + 2 * ec.byteCount : 0;      // Idle check, page selects, index/data, release
+    }
+    return 2 * (regCount + bankSwitches);
+}
+
+bool CompileSioSweep(const SioRegisterMap& map, SioSweep& out) {
+    out = SioSweep();
+    out.family = map.family;
+    std::fill(out.first, out.first + SIO_SENSOR_COUNT, (int16_t)-1);
+    std::fill(out.second, out.second + SIO_SENSOR_COUNT, (int16_t)-1);
+
+    if (map.family == SioFamily::NuvotonEc) {
+        // The EC's sensors are all 16-bit pairs: reuse the page-run planner
+        uint16_t regs[SIO_SENSOR_COUNT];
+        int sensor[SIO_SENSOR_COUNT], n = 0;
+        for (int i = 0; i < SIO_SENSOR_COUNT; i++) {
+            if (!map.sensors[i].reg) continue;
+            if (map.sensors[i].reg2 != map.sensors[i].reg + 1) return false;
+            sensor[n] = i;
+            regs[n++] = map.sensors[i].reg;
+        }
+        if (!PlanNct6687_Sweep(regs, n, out.ec)) return false;
+        for (int k = 0; k < n; k++) {
+            out.first[sensor[k]] = (int16_t)out.ec.offsets[k];
+            out.second[sensor[k]] = (int16_t)(out.ec.offsets[k] + 1);
+        }
+        return true;
+    }
+
+    // Index/data: every byte once, sorted so each bank is selected once
+    for (const SioSensorDef& d : map.sensors) {
+        for (uint16_t reg : { d.reg, d.reg2 }) {
+            if (!reg || std::find(out.regs, out.regs + out.regCount, reg) != out.regs + out.regCount) continue;
+            if (out.regCount == SIO_MAX_SWEEP_BYTES) return false;
+            out.regs[out.regCount++] = reg;
+        }
+    }
+    std::sort(out.regs, out.regs + out.regCount);
+    auto offset = [&out](uint16_t reg) { return (int16_t)(std::find(out.regs, out.regs + out.regCount, reg) - out.regs); };
+    for (int i = 0; i < SIO_SENSOR_COUNT; i++) {
+        const SioSensorDef& d = map.sensors[i];
+        if (d.reg) out.first[i] = offset(d.reg);
+        if (d.reg2) out.second[i] = offset(d.reg2);
+    }
+    if (map.family == SioFamily::Nuvoton) {
+        int bank = -1;
+        for (int i = 0; i < out.regCount; i++) if ((out.regs[i] >> 8) != bank) { bank = out.regs[i] >> 8; out.bankSwitches++; }
+    }
+    return true;
+}
+
+void RunSioSweep(IPortIo& io, int baseAddr, const SioSweep& sweep, uint8_t raw[]) {
+    if (sweep.family == SioFamily::NuvotonEc) { ReadNct6687_Sweep(io, baseAddr, sweep.ec, raw); return; }
+    if (baseAddr == 0) return;
+    int addressPort = baseAddr + 0x05;
+    int dataPort = baseAddr + 0x06;
+    bool banked = sweep.family == SioFamily::Nuvoton;
+    int bank = -1;
+    for (int i = 0; i < sweep.regCount; i++) {
+        uint16_t reg = sweep.regs[i];
+        if (banked && (reg >> 8) != bank) {
+            bank = reg >> 8;
+            io.Out8(addressPort, NUVOTON_BANK_SELECT); io.Out8(dataPort, (uint8_t)bank);
+        }
+        io.Out8(addressPort, reg & 0xFF);
+        raw[i] = io.In8(dataPort);
+    }
+}
+
+// ---------------------------------------------------------
+//  SENSOR PROVIDER
+// ---------------------------------------------------------
+bool SuperIoProvider::Open() {
+    if (!chip || chip->detectOnly) return false;
+    map = &SioMap(chip->family);
+    if (!CompileSioSweep(*map, sweep)) return false;
+    count = 0;
+    for (int i = 0; i < SIO_SENSOR_COUNT; i++) {
+        slots[i] = -1;
+        if (!map->sensors[i].reg) continue;
+        SioSensor s = (SioSensor)i;
+        SetSensorName(sensors[count], "%s.%s", map->prefix, SioSensorRole(s));
+        sensors[count].unit = SioSensorUnit(s);
+        roles[count] = s;
+        slots[i] = count++;
+    }
+    return true;
+}
+
+bool SuperIoProvider::Poll(float* values) {
+    if (!io || !map || baseAddr == 0) return false;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        RunSioSweep(*io, baseAddr, sweep, raw);
+    }
+    for (int i = 0; i < count; i++) {
+        SioSensor s = roles[i];
+        uint8_t second = sweep.second[s] >= 0 ? raw[sweep.second[s]] : 0;
+        values[i] = DecodeSioValue(map->sensors[s], raw[sweep.first[s]], second, chip->voltLsbMv);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------
+//  REGISTER DUMPS
+// ---------------------------------------------------------
+static uint8_t ReadMonitorReg(IPortIo& io, SioFamily family, int baseAddr, uint16_t reg) {
+    if (family == SioFamily::NuvotonEc) return (uint8_t)ReadNct6687_EC(io, baseAddr, reg);
+    if (family == SioFamily::Nuvoton) { io.Out8(baseAddr + 5, NUVOTON_BANK_SELECT); io.Out8(baseAddr + 6, reg >> 8); }
+    io.Out8(baseAddr + 5, reg & 0xFF);
+    return io.In8(baseAddr + 6);
+}
+
+bool WriteSioDump(IPortIo& io, const SioDetectResult& chip, FILE* out) {
+    if (!chip.chip || chip.baseAddr == 0) return false;
+    if (chip.chip->detectOnly) {
+        // Status registers may clear on read; harmless here, nothing uses the alarms
+        fprintf(out, "# %s super i/o register dump, banks 0-7 (no register map yet)\nchip 0x%04X\nport 0x%02X\nbase 0x%03X\n", chip.chip->name, chip.chipId, chip.port, chip.baseAddr);
+        for (int reg = 0; reg < 0x800; reg++) {
+            if ((reg & 0xFF) == NUVOTON_BANK_SELECT) continue;
+            fprintf(out, "0x%04X 0x%02X\n", reg, ReadMonitorReg(io, chip.chip->family, chip.baseAddr, (uint16_t)reg));
+        }
+        return true;
+    }
+    const SioRegisterMap& map = SioMap(chip.chip->family);
+    SioSweep sweep;
+    if (!CompileSioSweep(map, sweep)) return false;
+    uint8_t raw[NCT_MAX_SWEEP_BYTES];
+    RunSioSweep(io, chip.baseAddr, sweep, raw);
+
+    fprintf(out, "# %s super i/o register dump\nchip 0x%04X\nport 0x%02X\nbase 0x%03X\n", chip.chip->name, chip.chipId, chip.port, chip.baseAddr);
+    if (sweep.family == SioFamily::NuvotonEc) {
+        for (int r = 0; r < sweep.ec.runCount; r++) {
+            const NctRun& run = sweep.ec.runs[r];
+            for (int i = 0; i < run.count; i++) fprintf(out, "0x%04X 0x%02X\n", run.startReg + i, raw[run.bufOffset + i]);
+        }
+    }
+    else {
+        for (int i = 0; i < sweep.regCount; i++) fprintf(out, "0x%04X 0x%02X\n", sweep.regs[i], raw[i]);
+    }
+    for (int i = 0; i < map.pwmCount; i++) fprintf(out, "0x%04X 0x%02X\n", map.pwm[i], ReadMonitorReg(io, map.family, chip.baseAddr, map.pwm[i]));
+    return true;
+}
+
+bool ReadSioDump(const char* path, SioDump& out) {
+    out = SioDump();
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[128];
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        unsigned reg, value;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+        if (sscanf(line, "chip %x", &value) == 1) out.chipId = (int)value;
+        else if (sscanf(line, "port %x", &value) == 1) out.port = (int)value;
+        else if (sscanf(line, "base %x", &value) == 1) out.baseAddr = (int)value;
+        else if (sscanf(line, "%x %x", &reg, &value) == 2 && reg <= 0xFFFF && value <= 0xFF) out.regs.push_back({ (uint16_t)reg, (uint8_t)value });
+        else ok = false;
+    }
+    fclose(f);
+    return ok && out.chipId && out.port && out.baseAddr;
+}
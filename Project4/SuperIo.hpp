@@ -0,0 +1,179 @@
+#pragma once
+#include "Nct6687.hpp"
+#include "PortIo.hpp"
+#include "SensorProvider.hpp"
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+// ---------------------------------------------------------
+//  CHIP DATABASE
+//  Every ID in ChipDefs.hpp, tagged with the family that decides how
+//  its hardware monitor is reached and laid out.
+// ---------------------------------------------------------
+enum class SioFamily {
+    NuvotonEc,      // NCT6683/6686/6687: EC pages behind base + 4/5/6
+    Nuvoton,        // NCT677x/679x: banked index/data at base + 5/6
+    Ite,            // IT86xx/IT87xx: 8-bit index/data at base + 5/6
+    Fintek,         // F718xx: 8-bit index/data at base + 5/6
+};
+
+struct SioChip {
+    uint16_t id;
+    const char* name;
+    SioFamily family;
+    float voltLsbMv;            // ADC step; the EC reports whole millivolts
+    // Found and named, but the family map does not fit its register layout: no
+    // sweep, no fan writes, and a dump records whole banks to build a map from
+    bool detectOnly = false;
+};
+
+int SioChipCount();
+const SioChip& SioChipAt(int i);
+const SioChip* FindSioChip(uint16_t id);
+// "NCT6798D" or "0xD428", case-insensitive
+const SioChip* FindSioChip(const char* nameOrId);
+// An ID as read from config space; Nuvoton parts keep a revision in the low three bits
+const SioChip* MatchSioChip(uint16_t id);
+const char* SioFamilyName(SioFamily family);
+
+// ---------------------------------------------------------
+//  REGISTER MAPS
+//  One constexpr map per family. A sensor is one or two register
+//  bytes plus a format; reg == 0 means the family has no such input.
+//  Registers are (bank or page << 8) | index.
+// ---------------------------------------------------------
+enum SioSensor {
+    SIO_TEMP_CPU, SIO_TEMP_SYSTEM, SIO_TEMP_VRM, SIO_TEMP_PCH, SIO_TEMP_SOC,
+    SIO_VOLT_12V, SIO_VOLT_5V, SIO_VOLT_VCORE, SIO_VOLT_DRAM, SIO_VOLT_SOC,
+    SIO_FAN_CPU, SIO_FAN_SYS1, SIO_FAN_SYS2,
+    SIO_SENSOR_COUNT
+};
+
+enum class SioFormat : uint8_t {
+    TempHalf,       // reg = whole degrees, reg2 bit 7 = +0.5
+    Temp8,          // reg = signed degrees
+    VoltEc,         // 12-bit millivolts, reg = bits 11-4, reg2 = bits 3-0 in its high nibble
+    Volt8,          // reg * the chip's ADC step
+    Rpm16,          // reg:reg2 = RPM
+    IteTach,        // reg:reg2 = period count, RPM = 1350000 / (2 * count)
+    FintekTach,     // reg:reg2 = period count, RPM = 1500000 / count
+};
+
+struct SioSensorDef {
+    uint16_t reg = 0;
+    uint16_t reg2 = 0;          // Second byte, where the format has one
+    SioFormat format = SioFormat::Temp8;
+    float multiplier = 1.0f;    // Board divider on voltage inputs
+};
+
+constexpr int SIO_MAX_PWM = 8;
+
+struct SioRegisterMap {
+    SioFamily family;
+    const char* prefix;         // Hub sensor names are prefix.role, e.g. "nct.cpu_temp"
+    uint8_t monitorLdn;         // Logical device holding the hardware monitor
+    SioSensorDef sensors[SIO_SENSOR_COUNT];
+    uint16_t pwm[SIO_MAX_PWM];  // Duty registers, fan 0 first
+    int pwmCount;
+};
+
+const SioRegisterMap& SioMap(SioFamily family);
+const char* SioSensorRole(SioSensor sensor);     // "cpu_temp", "12v", ...
+SensorUnit SioSensorUnit(SioSensor sensor);
+float DecodeSioValue(const SioSensorDef& def, uint8_t first, uint8_t second, float voltLsbMv);
+
+// ---------------------------------------------------------
+//  DETECTION
+// ---------------------------------------------------------
+struct SioDetectResult {
+    const SioChip* chip = nullptr;
+    int chipId = 0;             // As read, revision bits included
+    int port = 0;               // Config port the chip answered on
+    int baseAddr = 0;           // Hardware monitor I/O base
+    int lastId = 0;             // Any other ID read on the way, for diagnostics
+};
+
+// Probes 0x4E then 0x2E, first with the Nuvoton/Fintek key (87 87), then, if
+// nothing answered, with the ITE key (87 01 55 55/AA). On a known chip it clears
+// the EC's I/O lock bit, activates the hardware monitor and reads its base.
+bool DetectSuperIo(IPortIo& io, SioDetectResult& out);
+
+// ---------------------------------------------------------
+//  SWEEP
+//  A map compiled into the shortest port sequence that reads all of
+//  it: page runs on the EC, and on the index/data chips each byte once,
+//  in register order, with a bank select only where the bank changes.
+// ---------------------------------------------------------
+constexpr int SIO_MAX_SWEEP_BYTES = 64;
+
+struct SioSweep {
+    SioFamily family = SioFamily::NuvotonEc;
+    NctSweepPlan ec;                            // EC family
+    uint16_t regs[SIO_MAX_SWEEP_BYTES] = {};    // Index/data families, raw[i] = regs[i]
+    int regCount = 0;
+    int bankSwitches = 0;
+    int16_t first[SIO_SENSOR_COUNT] = {};       // Offsets into the raw buffer, -1 if absent
+    int16_t second[SIO_SENSOR_COUNT] = {};
+    int ByteCount() const { return family == SioFamily::NuvotonEc ? ec.byteCount : regCount; }
+    int PortOps() const;
+};
+
+bool CompileSioSweep(const SioRegisterMap& map, SioSweep& out);
+// Caller holds the I/O lock
+void RunSioSweep(IPortIo& io, int baseAddr, const SioSweep& sweep, uint8_t raw[]);
+
+// ---------------------------------------------------------
+//  SENSOR PROVIDER
+//  Whatever DetectSuperIo found, read as one compiled sweep. Only the
+//  inputs the chip's family has are registered.
+// ---------------------------------------------------------
+class SuperIoProvider : public ISensorProvider {
+public:
+    SuperIoProvider(IPortIo*& io, std::mutex& ioMutex, const SioChip*& chip, const int& baseAddr)
+        : io(io), ioMutex(ioMutex), chip(chip), baseAddr(baseAddr) {}
+    const char* Name() const override { return "superio"; }
+    bool Open() override;
+    int SensorCount() const override { return count; }
+    const SensorDesc& Sensor(int i) const override { return sensors[i]; }
+    int PollCostUs() const override { return sweep.PortOps() + 5; }   // ~1us per port op
+    bool Poll(float* values) override;
+    // Index of 'sensor' in Poll's output, or -1 if the chip lacks it
+    int Slot(SioSensor sensor) const { return slots[sensor]; }
+
+private:
+    IPortIo*& io;
+    std::mutex& ioMutex;
+    const SioChip*& chip;
+    const int& baseAddr;
+    const SioRegisterMap* map = nullptr;
+    SioSweep sweep;
+    SensorDesc sensors[SIO_SENSOR_COUNT];
+    SioSensor roles[SIO_SENSOR_COUNT] = {};
+    int slots[SIO_SENSOR_COUNT] = {};
+    int count = 0;
+    uint8_t raw[NCT_MAX_SWEEP_BYTES] = {};
+};
+
+// ---------------------------------------------------------
+//  REGISTER DUMPS
+//  A text snapshot of everything the sweep and the fan code read:
+//    chip 0xD592
+//    port 0x4E
+//    base 0xA20
+//    0x0100 0x2D
+//    ...
+//  Recorded on a real board, replayed through the simulator so the
+//  database can be checked on any machine. A detect-only chip has no
+//  map yet, so its dump is every register of banks 0-7 instead.
+// ---------------------------------------------------------
+struct SioDump {
+    int chipId = 0;
+    int port = 0;
+    int baseAddr = 0;
+    std::vector<std::pair<uint16_t, uint8_t>> regs;
+};
+
+// Caller holds the I/O lock
+bool WriteSioDump(IPortIo& io, const SioDetectResult& chip, FILE* out);
+bool ReadSioDump(const char* path, SioDump& out);
@@ -0,0 +1,183 @@
+#include "TelemetryExport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+static_assert(TSHM_MAX_SENSORS == MAX_SENSORS, "The mapping holds the whole hub");
+static_assert(TSHM_UNIT_MHZ == (int)SensorUnit::MHz, "TSHM_UNIT_* follows SensorUnit");
+
+// Multiplier from the hub's unit to its base unit
+static float UnitScale(SensorUnit unit) {
+    switch (unit) {
+    case SensorUnit::Percent: return 0.01f;
+    case SensorUnit::MegaBytes:
+    case SensorUnit::MegaBytesPerSec: return 1048576.0f;
+    case SensorUnit::MHz: return 1e6f;
+    default: return 1.0f;
+    }
+}
+
+// A block with no valid header this long after it was created was left by a writer that
+// died during setup (Linux; a Windows section cannot outlive it half-written)
+constexpr int TSHM_SETUP_SECONDS = 5;
+
+static uint32_t ProcessId() {
+#ifdef _WIN32
+    return GetCurrentProcessId();
+#else
+    return (uint32_t)getpid();
+#endif
+}
+
+// A block that exists is taken while its writer runs: a valid one until it is closed or its
+// process exits, one still being set up (magic not stored yet) unless its pid is known dead.
+// 'stale' marks a setup that has gone on far too long to be in progress.
+static bool WriterHolds(const TshmHeader* h, size_t size, bool stale) {
+    if (size < sizeof(TshmHeader)) return !stale;
+    TshmReader r;
+    memset(&r, 0, sizeof(r));
+    r.header = h;
+    r.size = size;
+    uint32_t pid = std::atomic_ref<const uint32_t>(h->writerPid).load(std::memory_order_acquire);
+    if (std::atomic_ref<const uint32_t>(h->magic).load(std::memory_order_acquire) == TSHM_MAGIC)
+        return tshm_live(&r) && tshm_writer_alive(&r);
+    if (pid == 0) return !stale;
+    return tshm_writer_alive(&r) != 0;
+}
+
+bool TelemetryExporter::Open(const char* shmName, int intervalMs) {
+    Close();
+    const uint32_t sensorsOffset = sizeof(TshmHeader);
+    const uint32_t valuesOffset = sensorsOffset + TSHM_MAX_SENSORS * sizeof(TshmSensor);
+    size_t bytes = valuesOffset + TSHM_MAX_SENSORS * sizeof(float);
+    void* base = nullptr;
+    bool reused = false;
+#ifdef _WIN32
+    // The section lives as long as any handle does, so a reader still holding a dead
+    // writer's block keeps the name: reuse that block in place rather than fail
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)bytes, shmName);
+    if (!h) return false;
+    reused = GetLastError() == ERROR_ALREADY_EXISTS;
+    base = MapViewOfFile(h, FILE_MAP_WRITE, 0, 0, bytes);       // Fails if an existing section is smaller
+    if (!base) { CloseHandle(h); return false; }
+    if (reused) {
+        TshmHeader* old = (TshmHeader*)base;
+        uint32_t pid = std::atomic_ref<uint32_t>(old->writerPid).load(std::memory_order_acquire);
+        // Claim it with the pid, so two writers restarting at once cannot both take it over
+        if (WriterHolds(old, bytes, false) || !std::atomic_ref<uint32_t>(old->writerPid).compare_exchange_strong(pid, ProcessId())) {
+            UnmapViewOfFile(base);
+            CloseHandle(h);
+            return false;
+        }
+    }
+    mapping = h;
+#else
+    // Take the name over only from a writer that closed or died, never from a running one
+    int existing = shm_open(shmName, O_RDONLY, 0);
+    if (existing >= 0) {
+        struct stat st;
+        bool held = true;
+        if (fstat(existing, &st) == 0) {
+            bool stale = time(nullptr) - st.st_mtime > TSHM_SETUP_SECONDS;
+            void* p = st.st_size >= (off_t)sizeof(TshmHeader) ? mmap(nullptr, sizeof(TshmHeader), PROT_READ, MAP_SHARED, existing, 0) : MAP_FAILED;
+            if (p != MAP_FAILED) {
+                held = WriterHolds((const TshmHeader*)p, sizeof(TshmHeader), stale);
+                munmap(p, sizeof(TshmHeader));
+            }
+            else held = WriterHolds(nullptr, 0, stale);
+        }
+        close(existing);
+        if (held) return false;
+    }
+    shm_unlink(shmName);
+    int fd = shm_open(shmName, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) return false;
+    if (ftruncate(fd, (off_t)bytes) == 0) {
+        base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) base = nullptr;
+    }
+    close(fd);
+    if (!base) { shm_unlink(shmName); return false; }
+#endif
+    name = shmName;
+    size = bytes;
+    header = (TshmHeader*)base;
+    sensors = (TshmSensor*)((uint8_t*)base + sensorsOffset);
+    values = (uint32_t*)((uint8_t*)base + valuesOffset);
+    published = 0;
+    publishes = 0;
+    // The pid first, so another writer probing the name sees whose setup this is
+    std::atomic_ref<uint32_t>(header->writerPid).store(ProcessId(), std::memory_order_release);
+    if (reused) {
+        // Readers of the old block see it closed, and an odd sequence while it is rewritten
+        std::atomic_ref<uint32_t>(header->live).store(0, std::memory_order_release);
+        std::atomic_ref<uint32_t>(header->magic).store(0, std::memory_order_release);
+        std::atomic_ref<uint32_t> sequence(header->sequence);
+        uint32_t odd = sequence.load(std::memory_order_relaxed) | 1;     // Already odd if the old writer died mid-publish
+        sequence.store(odd, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic_ref<uint32_t>(header->sensorCount).store(0, std::memory_order_relaxed);
+        std::atomic_ref<uint64_t>(header->publishes).store(0, std::memory_order_relaxed);
+        std::atomic_ref<int64_t>(header->publishMs).store(0, std::memory_order_relaxed);
+        sequence.store(odd + 1, std::memory_order_release);
+    }
+    // A new mapping is zero-filled: no sensors, sequence 0, magic not yet set
+    header->versionMajor = TSHM_VERSION_MAJOR;
+    header->versionMinor = TSHM_VERSION_MINOR;
+    header->headerSize = sizeof(TshmHeader);
+    header->sensorStride = sizeof(TshmSensor);
+    header->capacity = TSHM_MAX_SENSORS;
+    header->sensorsOffset = sensorsOffset;
+    header->valuesOffset = valuesOffset;
+    header->intervalMs = (uint32_t)intervalMs;
+    std::atomic_ref<uint32_t>(header->live).store(1, std::memory_order_relaxed);
+    std::atomic_ref<uint32_t>(header->magic).store(TSHM_MAGIC, std::memory_order_release);
+    return true;
+}
+
+void TelemetryExporter::Close() {
+    if (!header) return;
+    std::atomic_ref<uint32_t>(header->live).store(0, std::memory_order_release);
+#ifdef _WIN32
+    UnmapViewOfFile(header);
+    CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    munmap(header, size);
+    shm_unlink(name.c_str());
+#endif
+    header = nullptr;
+    sensors = nullptr;
+    values = nullptr;
+}
+
+void TelemetryExporter::Publish(const SensorHub& hub, int64_t nowMs) {
+    if (!header) return;
+    int total = (std::min)(hub.SensorCount(), TSHM_MAX_SENSORS);
+    // Metadata first: slots past sensorCount are invisible to readers until the count moves
+    for (int provider = 0; published < total; published++) {
+        while (provider + 1 < hub.ProviderCount() && hub.FirstSensor(provider + 1) <= published) provider++;
+        const SensorDesc& desc = hub.Sensor(published);
+        TshmSensor& s = sensors[published];
+        snprintf(s.name, sizeof(s.name), "%s", desc.name);
+        snprintf(s.unit, sizeof(s.unit), "%s", SensorUnitSuffix(desc.unit));
+        s.unitCode = (uint8_t)desc.unit;
+        s.flags = desc.detail ? TSHM_SENSOR_DETAIL : 0;
+        s.provider = (uint16_t)provider;
+        s.scale = UnitScale(desc.unit);
+    }
+
+    // Same protocol as SeqLock::Store, on the mapped words
+    std::atomic_ref<uint32_t> sequence(header->sequence);
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int id = 0; id < total; id++) std::atomic_ref<uint32_t>(values[id]).store(std::bit_cast<uint32_t>(hub.Value(id)), std::memory_order_relaxed);
+    std::atomic_ref<int64_t>(header->publishMs).store(nowMs, std::memory_order_relaxed);
+    std::atomic_ref<uint64_t>(header->publishes).store(++publishes, std::memory_order_relaxed);
+    std::atomic_ref<uint32_t>(header->sensorCount).store((uint32_t)total, std::memory_order_release);
+    sequence.store(seq + 2, std::memory_order_release);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "SensorProvider.hpp"
+#include "TelemetryShm.h"
+#include <cstdint>
+#include <string>
+
+// ---------------------------------------------------------
+//  SHARED-MEMORY EXPORT (writer side of TelemetryShm.h)
+//  Publishes the hub into a named mapping so other processes (capture
+//  tools, a monitoring agent) read the same values without polling
+//  WMI/PDH themselves. One writer per name; Publish is called from a
+//  single thread.
+// ---------------------------------------------------------
+class TelemetryExporter {
+public:
+    TelemetryExporter() = default;
+    ~TelemetryExporter() { Close(); }
+    TelemetryExporter(const TelemetryExporter&) = delete;
+    TelemetryExporter& operator=(const TelemetryExporter&) = delete;
+
+    // Creates the mapping. Fails if another running writer holds the name, or is still
+    // setting it up; a block left by a writer that closed or died is taken over (replaced
+    // on Linux, reused in place on Windows, where a reader's handle keeps it alive).
+    bool Open(const char* name = TSHM_DEFAULT_NAME, int intervalMs = 0);
+    // Marks the block dead and drops the name; readers keep a frozen copy until they reopen
+    void Close();
+    bool IsOpen() const { return header != nullptr; }
+
+    // Appends metadata for sensors the hub gained since the last call, then
+    // publishes every value in one seqlock write
+    void Publish(const SensorHub& hub, int64_t nowMs);
+
+    int SensorCount() const { return published; }
+    uint64_t Publishes() const { return publishes; }
+
+private:
+    TshmHeader* header = nullptr;
+    TshmSensor* sensors = nullptr;
+    uint32_t* values = nullptr;
+    size_t size = 0;
+    int published = 0;
+    uint64_t publishes = 0;
+    std::string name;
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+};
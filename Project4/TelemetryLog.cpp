@@ -0,0 +1,488 @@
+#include "TelemetryLog.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+int64_t TelemetryNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// ---------------------------------------------------------
+//  CODECS
+// ---------------------------------------------------------
+static void PutVarint(std::vector<uint8_t>& out, int64_t v) {
+    uint64_t z = ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);   // Zigzag: small magnitudes stay short
+    while (z >= 0x80) { out.push_back((uint8_t)(z | 0x80)); z >>= 7; }
+    out.push_back((uint8_t)z);
+}
+
+static bool GetVarint(const uint8_t*& p, const uint8_t* end, int64_t& v) {
+    uint64_t z = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t b = *p++;
+        z |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) { v = (int64_t)(z >> 1) ^ -(int64_t)(z & 1); return true; }
+    }
+    return false;
+}
+
+void EncodeTelemetryTimes(const int64_t* times, int rows, std::vector<uint8_t>& out) {
+    int64_t prevDelta = 0;
+    for (int r = 1; r < rows; r++) {
+        int64_t delta = times[r] - times[r - 1];
+        PutVarint(out, delta - prevDelta);
+        prevDelta = delta;
+    }
+}
+
+bool DecodeTelemetryTimes(const uint8_t* data, size_t size, int64_t firstMs, int rows, int64_t* out) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    int64_t delta = 0;
+    if (rows > 0) out[0] = firstMs;
+    for (int r = 1; r < rows; r++) {
+        int64_t dod;
+        if (!GetVarint(p, end, dod)) return false;
+        delta += dod;
+        out[r] = out[r - 1] + delta;
+    }
+    return true;
+}
+
+namespace {
+    struct BitWriter {
+        std::vector<uint8_t>& out;
+        uint64_t acc = 0;
+        int bits = 0;
+
+        void Write(uint32_t v, int n) {
+            acc = (acc << n) | (v & ((1ull << n) - 1));
+            bits += n;
+            while (bits >= 8) { bits -= 8; out.push_back((uint8_t)(acc >> bits)); }
+            acc &= (1ull << bits) - 1;
+        }
+        void Flush() { if (bits) out.push_back((uint8_t)(acc << (8 - bits))); acc = 0; bits = 0; }
+    };
+
+    struct BitReader {
+        const uint8_t* p;
+        const uint8_t* end;
+        uint64_t acc = 0;
+        int bits = 0;
+
+        bool Read(int n, uint32_t& v) {
+            while (bits < n) {
+                if (p >= end) return false;
+                acc = (acc << 8) | *p++;
+                bits += 8;
+            }
+            bits -= n;
+            v = (uint32_t)((acc >> bits) & ((1ull << n) - 1));
+            acc &= (1ull << bits) - 1;
+            return true;
+        }
+    };
+}
+
+// Gorilla: first value raw, then XOR with the previous value.
+//   0                       same value
+//   10 <bits>               meaningful bits fit the previous window
+//   11 <lead:5> <len-1:5>   new window, then len meaningful bits
+void EncodeTelemetryColumn(const float* values, int rows, int stride, std::vector<uint8_t>& out) {
+    if (rows <= 0) return;
+    BitWriter w{ out };
+    uint32_t prev = std::bit_cast<uint32_t>(values[0]);
+    w.Write(prev, 32);
+    int prevLead = -1, prevTrail = 0;
+    for (int r = 1; r < rows; r++) {
+        uint32_t cur = std::bit_cast<uint32_t>(values[(size_t)r * stride]);
+        uint32_t x = cur ^ prev;
+        prev = cur;
+        if (x == 0) { w.Write(0, 1); continue; }
+
+        int lead = std::countl_zero(x);
+        int trail = std::countr_zero(x);
+        if (prevLead >= 0 && lead >= prevLead && trail >= prevTrail) {
+            w.Write(2, 2);
+            w.Write(x >> prevTrail, 32 - prevLead - prevTrail);
+        }
+        else {
+            int len = 32 - lead - trail;
+            w.Write(3, 2);
+            w.Write(lead, 5);
+            w.Write(len - 1, 5);
+            w.Write(x >> trail, len);
+            prevLead = lead;
+            prevTrail = trail;
+        }
+    }
+    w.Flush();
+}
+
+bool DecodeTelemetryColumn(const uint8_t* data, size_t size, int rows, float* out) {
+    if (rows <= 0) return true;
+    BitReader r{ data, data + size };
+    uint32_t prev, bit, v;
+    if (!r.Read(32, prev)) return false;
+    out[0] = std::bit_cast<float>(prev);
+    int lead = 0, len = 0;
+    for (int i = 1; i < rows; i++) {
+        if (!r.Read(1, bit)) return false;
+        if (bit) {
+            if (!r.Read(1, bit)) return false;
+            if (bit) {
+                uint32_t l, n;
+                if (!r.Read(5, l) || !r.Read(5, n)) return false;
+                lead = (int)l;
+                len = (int)n + 1;
+                if (lead + len > 32) return false;
+            }
+            if (len == 0 || !r.Read(len, v)) return false;
+            prev ^= v << (32 - lead - len);
+        }
+        out[i] = std::bit_cast<float>(prev);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------
+//  WRITER
+// ---------------------------------------------------------
+bool TelemetryLogWriter::Open(const std::filesystem::path& path) {
+    if (IsOpen()) return false;
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    // A Push that raced the previous Close may have left rows behind
+    while (queue.TryPop(popScratch)) {}
+    offset = 0;
+    schemaColumns = 0;
+    blockColumns = 0;
+    blockTimes.clear();
+    blockValues.clear();
+    index.clear();
+    bytesWritten = 0;
+    dropped = 0;
+
+    TelemetryFileHeader header = { TLOG_MAGIC, TLOG_VERSION, TelemetryNowMs() };
+    file.write((const char*)&header, sizeof(header));
+    offset = sizeof(header);
+
+    stopping = false;
+    worker = std::thread(&TelemetryLogWriter::Run, this);
+    open.store(true, std::memory_order_release);
+    return true;
+}
+
+void TelemetryLogWriter::Close() {
+    if (!open.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> l(wakeMutex);
+        stopping = true;
+    }
+    wakeCv.notify_one();
+    if (worker.joinable()) worker.join();
+
+    // Footer: block index, then the whole column table so readers need not scan
+    WriteSchema(columnCount.load(std::memory_order_acquire));
+    std::vector<uint8_t> payload;
+    uint32_t counts[2] = { (uint32_t)index.size(), (uint32_t)schemaColumns };
+    payload.insert(payload.end(), (const uint8_t*)counts, (const uint8_t*)counts + sizeof(counts));
+    payload.insert(payload.end(), (const uint8_t*)index.data(), (const uint8_t*)(index.data() + index.size()));
+    payload.insert(payload.end(), (const uint8_t*)columns, (const uint8_t*)(columns + schemaColumns));
+
+    TelemetryTrailer trailer = { offset, TLOG_TRAILER_MAGIC, TLOG_VERSION };
+    WriteRecord(TLOG_RECORD_INDEX, payload.data(), payload.size());
+    file.write((const char*)&trailer, sizeof(trailer));
+    bytesWritten.store(offset + sizeof(trailer), std::memory_order_relaxed);
+    file.close();
+}
+
+int TelemetryLogWriter::AddColumn(const SensorDesc& desc) {
+    int n = columnCount.load(std::memory_order_relaxed);
+    if (n >= TLOG_MAX_COLUMNS) return -1;
+    TelemetryColumnEntry& c = columns[n];
+    memcpy(c.name, desc.name, sizeof(c.name));
+    c.name[sizeof(c.name) - 1] = 0;
+    c.unit = (uint32_t)desc.unit;
+    c.flags = desc.detail ? 1 : 0;
+    columnCount.store(n + 1, std::memory_order_release);
+    return n;
+}
+
+bool TelemetryLogWriter::Push(int64_t timeMs, const float* values, int count) {
+    if (!IsOpen()) return false;
+    pushScratch.timeMs = timeMs;
+    pushScratch.count = std::clamp(count, 0, ColumnCount());
+    memcpy(pushScratch.values, values, pushScratch.count * sizeof(float));
+    if (queue.TryPush(pushScratch)) {
+        // Bursts (replays, fast producers) wake the writer early instead of waiting out the tick
+        if (queue.Size() >= TLOG_QUEUE_DEPTH / 2) wakeCv.notify_one();
+        return true;
+    }
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void TelemetryLogWriter::Run() {
+    for (;;) {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> l(wakeMutex);
+            wakeCv.wait_for(l, std::chrono::milliseconds(250), [&] { return stopping || queue.Size() >= TLOG_QUEUE_DEPTH / 2; });
+            stop = stopping;
+        }
+        while (queue.TryPop(popScratch)) Append(popScratch);
+        if (stop) break;
+    }
+    FlushBlock();
+}
+
+void TelemetryLogWriter::Append(const Sample& s) {
+    bool full = blockTimes.size() >= (size_t)TLOG_BLOCK_ROWS;
+    bool stale = !blockTimes.empty() && s.timeMs - blockTimes.front() >= TLOG_BLOCK_MAX_MS;
+    if (full || stale || s.count > blockColumns) FlushBlock();
+    if (blockTimes.empty()) {
+        blockColumns = s.count;
+        WriteSchema(blockColumns);
+    }
+
+    blockTimes.push_back(s.timeMs);
+    blockValues.insert(blockValues.end(), s.values, s.values + s.count);
+    blockValues.resize(blockTimes.size() * blockColumns, NAN);
+}
+
+void TelemetryLogWriter::FlushBlock() {
+    int rows = (int)blockTimes.size();
+    if (rows == 0) return;
+
+    encoded.clear();
+    TelemetryBlockHeader header = { blockTimes.front(), blockTimes.back(), (uint32_t)rows, (uint32_t)blockColumns, 0, 0 };
+    encoded.resize(sizeof(header));
+    EncodeTelemetryTimes(blockTimes.data(), rows, encoded);
+    header.timeBytes = (uint32_t)(encoded.size() - sizeof(header));
+    memcpy(encoded.data(), &header, sizeof(header));
+
+    size_t sizeTable = encoded.size();
+    encoded.resize(sizeTable + blockColumns * sizeof(uint32_t));
+    for (int c = 0; c < blockColumns; c++) {
+        size_t before = encoded.size();
+        EncodeTelemetryColumn(blockValues.data() + c, rows, blockColumns, encoded);
+        uint32_t bytes = (uint32_t)(encoded.size() - before);
+        memcpy(encoded.data() + sizeTable + c * sizeof(uint32_t), &bytes, sizeof(bytes));
+    }
+
+    index.push_back({ offset, header.firstMs, header.lastMs, header.rows, header.columns });
+    WriteRecord(TLOG_RECORD_DATA, encoded.data(), encoded.size());
+    file.flush();   // Once per block, not per row
+
+    blockTimes.clear();
+    blockValues.clear();
+}
+
+void TelemetryLogWriter::WriteSchema(int upTo) {
+    if (upTo <= schemaColumns) return;
+    std::vector<uint8_t> payload;
+    uint32_t range[2] = { (uint32_t)schemaColumns, (uint32_t)(upTo - schemaColumns) };
+    payload.insert(payload.end(), (const uint8_t*)range, (const uint8_t*)range + sizeof(range));
+    payload.insert(payload.end(), (const uint8_t*)(columns + schemaColumns), (const uint8_t*)(columns + upTo));
+    WriteRecord(TLOG_RECORD_SCHEMA, payload.data(), payload.size());
+    schemaColumns = upTo;
+}
+
+void TelemetryLogWriter::WriteRecord(uint32_t type, const void* payload, size_t size) {
+    TelemetryRecordHeader header = { type, (uint32_t)size };
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)payload, size);
+    offset += sizeof(header) + size;
+    bytesWritten.store(offset, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------
+//  READER
+// ---------------------------------------------------------
+bool TelemetryLogReader::Open(const std::filesystem::path& path) {
+    columns.clear();
+    blocks.clear();
+    recovered = false;
+    if (!map.Open(path)) return false;
+
+    TelemetryFileHeader header;
+    if (map.Size() < sizeof(header)) return false;
+    memcpy(&header, map.Data(), sizeof(header));
+    if (header.magic != TLOG_MAGIC || header.version != TLOG_VERSION) return false;
+
+    if (ReadFooter()) return true;
+    columns.clear();
+    blocks.clear();
+    recovered = true;
+    Scan();
+    return true;
+}
+
+bool TelemetryLogReader::ReadFooter() {
+    const uint8_t* base = map.Data();
+    uint64_t fileSize = map.Size();
+    TelemetryTrailer trailer;
+    TelemetryRecordHeader rh;
+    if (fileSize < sizeof(TelemetryFileHeader) + sizeof(rh) + sizeof(trailer)) return false;
+    memcpy(&trailer, base + fileSize - sizeof(trailer), sizeof(trailer));
+    if (trailer.magic != TLOG_TRAILER_MAGIC || trailer.indexOffset > fileSize - sizeof(trailer) - sizeof(rh)) return false;
+
+    memcpy(&rh, base + trailer.indexOffset, sizeof(rh));
+    if (rh.type != TLOG_RECORD_INDEX || trailer.indexOffset + sizeof(rh) + rh.size + sizeof(trailer) != fileSize) return false;
+
+    uint32_t counts[2];
+    const uint8_t* p = base + trailer.indexOffset + sizeof(rh);
+    if (rh.size < sizeof(counts)) return false;
+    memcpy(counts, p, sizeof(counts));
+    size_t need = sizeof(counts) + (size_t)counts[0] * sizeof(TelemetryBlockInfo) + (size_t)counts[1] * sizeof(TelemetryColumnEntry);
+    if (need != rh.size) return false;
+    p += sizeof(counts);
+    blocks.resize(counts[0]);
+    memcpy(blocks.data(), p, counts[0] * sizeof(TelemetryBlockInfo));
+    columns.resize(counts[1]);
+    memcpy(columns.data(), p + counts[0] * sizeof(TelemetryBlockInfo), counts[1] * sizeof(TelemetryColumnEntry));
+    for (const TelemetryBlockInfo& b : blocks) {
+        if (b.offset + sizeof(rh) + sizeof(TelemetryBlockHeader) > trailer.indexOffset || b.columns > counts[1]) return false;
+    }
+    return true;
+}
+
+void TelemetryLogReader::Scan() {
+    // Walk the records; a torn tail (partial record) just ends the scan
+    const uint8_t* base = map.Data();
+    uint64_t fileSize = map.Size();
+    uint64_t pos = sizeof(TelemetryFileHeader);
+    TelemetryRecordHeader rh;
+    while (pos + sizeof(rh) <= fileSize) {
+        memcpy(&rh, base + pos, sizeof(rh));
+        if (pos + sizeof(rh) + rh.size > fileSize) break;
+        const uint8_t* payload = base + pos + sizeof(rh);
+        if (rh.type == TLOG_RECORD_SCHEMA) AddSchema(payload, rh.size);
+        else if (rh.type == TLOG_RECORD_DATA) {
+            TelemetryBlockHeader bh;
+            if (rh.size < sizeof(bh)) break;
+            memcpy(&bh, payload, sizeof(bh));
+            if (bh.columns > columns.size()) break;
+            blocks.push_back({ pos, bh.firstMs, bh.lastMs, bh.rows, bh.columns });
+        }
+        else if (rh.type != TLOG_RECORD_INDEX) break;
+        pos += sizeof(rh) + rh.size;
+    }
+}
+
+void TelemetryLogReader::AddSchema(const uint8_t* payload, size_t size) {
+    uint32_t range[2];
+    if (size < sizeof(range)) return;
+    memcpy(range, payload, sizeof(range));
+    if (range[0] != columns.size() || size != sizeof(range) + (size_t)range[1] * sizeof(TelemetryColumnEntry)) return;
+    columns.resize(range[0] + range[1]);
+    memcpy(columns.data() + range[0], payload + sizeof(range), range[1] * sizeof(TelemetryColumnEntry));
+}
+
+int TelemetryLogReader::FindColumn(const char* name) const {
+    for (int c = 0; c < ColumnCount(); c++) {
+        if (strncmp(columns[c].name, name, sizeof(columns[c].name)) == 0) return c;
+    }
+    return -1;
+}
+
+int TelemetryLogReader::FindBlock(int64_t fromMs) const {
+    auto it = std::lower_bound(blocks.begin(), blocks.end(), fromMs, [](const TelemetryBlockInfo& b, int64_t t) { return b.lastMs < t; });
+    return (int)(it - blocks.begin());
+}
+
+bool TelemetryLogReader::View(int block, BlockView& out) const {
+    if (block < 0 || block >= BlockCount()) return false;
+    const TelemetryBlockInfo& info = blocks[block];
+    TelemetryRecordHeader rh;
+    if (info.offset + sizeof(rh) + sizeof(TelemetryBlockHeader) > map.Size()) return false;
+    memcpy(&rh, map.Data() + info.offset, sizeof(rh));
+    const uint8_t* payload = map.Data() + info.offset + sizeof(rh);
+    if (rh.type != TLOG_RECORD_DATA || info.offset + sizeof(rh) + rh.size > map.Size() || rh.size < sizeof(out.header)) return false;
+
+    memcpy(&out.header, payload, sizeof(out.header));
+    out.end = payload + rh.size;
+    out.times = payload + sizeof(out.header);
+    out.sizeTable = out.times + out.header.timeBytes;
+    out.columns = out.sizeTable + (size_t)out.header.columns * sizeof(uint32_t);
+    return out.header.timeBytes <= rh.size && out.columns <= out.end;
+}
+
+bool TelemetryLogReader::ColumnSpan(const BlockView& v, int column, const uint8_t*& data, uint32_t& bytes) const {
+    if (column < 0 || column >= (int)v.header.columns) return false;
+    // Sum the sizes of the columns before this one; the table is tiny next to the payload
+    data = v.columns;
+    for (int c = 0; c <= column; c++) {
+        memcpy(&bytes, v.sizeTable + c * sizeof(uint32_t), sizeof(bytes));
+        if (c < column) data += bytes;
+    }
+    return data + bytes <= v.end;
+}
+
+bool TelemetryLogReader::ReadTimes(int block, std::vector<int64_t>& out) const {
+    BlockView v;
+    if (!View(block, v)) return false;
+    out.resize(v.header.rows);
+    return DecodeTelemetryTimes(v.times, v.header.timeBytes, v.header.firstMs, (int)v.header.rows, out.data());
+}
+
+bool TelemetryLogReader::ReadColumn(int block, int column, std::vector<float>& out) const {
+    BlockView v;
+    const uint8_t* data;
+    uint32_t bytes;
+    if (!View(block, v) || !ColumnSpan(v, column, data, bytes)) return false;
+    out.resize(v.header.rows);
+    return DecodeTelemetryColumn(data, bytes, (int)v.header.rows, out.data());
+}
+
+bool TelemetryLogReader::ReadBlock(int block, TelemetryBlock& out) const {
+    BlockView v;
+    if (!View(block, v)) return false;
+    out.rows = (int)v.header.rows;
+    out.columns = (int)v.header.columns;
+    out.times.resize(out.rows);
+    out.values.resize((size_t)out.rows * out.columns);
+    if (!DecodeTelemetryTimes(v.times, v.header.timeBytes, v.header.firstMs, out.rows, out.times.data())) return false;
+
+    const uint8_t* data = v.columns;
+    for (int c = 0; c < out.columns; c++) {
+        uint32_t bytes;
+        memcpy(&bytes, v.sizeTable + c * sizeof(uint32_t), sizeof(bytes));
+        if (data + bytes > v.end) return false;
+        if (!DecodeTelemetryColumn(data, bytes, out.rows, out.values.data() + (size_t)c * out.rows)) return false;
+        data += bytes;
+    }
+    return true;
+}
+
+void WriteTelemetryCsv(const TelemetryLogReader& reader, std::ostream& os, int64_t fromMs, int64_t toMs) {
+    int columns = reader.ColumnCount();
+    os << "time_ms";
+    for (int c = 0; c < columns; c++) {
+        const TelemetryColumnEntry& col = reader.Column(c);
+        os << "," << col.name << "[" << SensorUnitSuffix((SensorUnit)col.unit) << "]";
+    }
+    os << "\n";
+
+    // Enough digits that every float reads back bit-exact; the default 6 drops what the log kept
+    std::streamsize precision = os.precision(std::numeric_limits<float>::max_digits10);
+    TelemetryBlock block;
+    for (int b = reader.FindBlock(fromMs); b < reader.BlockCount() && reader.Block(b).firstMs <= toMs; b++) {
+        if (!reader.ReadBlock(b, block)) continue;
+        for (int r = 0; r < block.rows; r++) {
+            if (block.times[r] < fromMs || block.times[r] > toMs) continue;
+            os << block.times[r];
+            for (int c = 0; c < columns; c++) {
+                os << ",";
+                if (c < block.columns) os << block.values[(size_t)c * block.rows + r];
+            }
+            os << "\n";
+        }
+    }
+    os.precision(precision);
+}
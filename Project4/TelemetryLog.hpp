@@ -0,0 +1,208 @@
+#pragma once
+#include "MappedFile.hpp"
+#include "SensorProvider.hpp"
+#include "SpscQueue.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------
+//  TELEMETRY LOG
+//  Append-only binary log, one file per session:
+//    FileHeader, then records (RecordHeader + payload):
+//      SCHM  columns appended to the table (name, unit)
+//      DATA  one block of rows, stored column by column
+//      INDX  footer: block index + full column table, then Trailer
+//  Inside a DATA block timestamps are delta-of-delta zigzag varints and
+//  each column is Gorilla XOR-encoded floats, so a steady sensor
+//  costs about one bit per sample. A per-column size table lets
+//  readers decode only the columns they need.
+//  A log without a footer (crash, power loss) is still readable by
+//  scanning the records.
+// ---------------------------------------------------------
+constexpr uint32_t TLOG_MAGIC = 0x31474C54;         // "TLG1"
+constexpr uint32_t TLOG_TRAILER_MAGIC = 0x45474C54; // "TLGE"
+constexpr uint32_t TLOG_VERSION = 1;
+constexpr uint32_t TLOG_RECORD_SCHEMA = 0x4D484353; // "SCHM"
+constexpr uint32_t TLOG_RECORD_DATA = 0x41544144;   // "DATA"
+constexpr uint32_t TLOG_RECORD_INDEX = 0x58444E49;  // "INDX"
+
+constexpr int TLOG_MAX_COLUMNS = MAX_SENSORS;
+constexpr int TLOG_BLOCK_ROWS = 1024;
+constexpr int64_t TLOG_BLOCK_MAX_MS = 60000;        // Bounds what a crash can lose
+constexpr int TLOG_QUEUE_DEPTH = 64;
+
+struct TelemetryFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    int64_t startMs;
+};
+
+struct TelemetryRecordHeader {
+    uint32_t type;
+    uint32_t size;              // Payload bytes after this header
+};
+
+struct TelemetryColumnEntry {
+    char name[48];
+    uint32_t unit;
+    uint32_t flags;             // Bit 0: detail sensor
+};
+
+struct TelemetryBlockHeader {
+    int64_t firstMs;
+    int64_t lastMs;
+    uint32_t rows;
+    uint32_t columns;
+    uint32_t timeBytes;
+    uint32_t reserved;
+    // Followed by timeBytes of timestamps, uint32 columnBytes[columns], then the columns
+};
+
+struct TelemetryBlockInfo {     // Also the on-disk index entry
+    uint64_t offset;            // Of the DATA record header
+    int64_t firstMs;
+    int64_t lastMs;
+    uint32_t rows;
+    uint32_t columns;
+};
+
+struct TelemetryTrailer {
+    uint64_t indexOffset;       // Of the INDX record header
+    uint32_t magic;
+    uint32_t version;
+};
+
+static_assert(sizeof(TelemetryFileHeader) == 16 && sizeof(TelemetryRecordHeader) == 8, "TelemetryLog layout");
+static_assert(sizeof(TelemetryColumnEntry) == 56 && sizeof(TelemetryBlockHeader) == 32, "TelemetryLog layout");
+static_assert(sizeof(TelemetryBlockInfo) == 32 && sizeof(TelemetryTrailer) == 16, "TelemetryLog layout");
+
+int64_t TelemetryNowMs();
+
+// Block codecs, shared by the writer and the reader
+void EncodeTelemetryTimes(const int64_t* times, int rows, std::vector<uint8_t>& out);
+bool DecodeTelemetryTimes(const uint8_t* data, size_t size, int64_t firstMs, int rows, int64_t* out);
+void EncodeTelemetryColumn(const float* values, int rows, int stride, std::vector<uint8_t>& out);
+bool DecodeTelemetryColumn(const uint8_t* data, size_t size, int rows, float* out);
+
+// ---------------------------------------------------------
+//  WRITER
+//  The poll thread pushes rows into a lock-free ring; a background
+//  thread drains it every 250 ms (or as soon as it is half full) into
+//  the open block and writes whole blocks. The producer never blocks:
+//  a full ring drops the row.
+// ---------------------------------------------------------
+class TelemetryLogWriter {
+public:
+    ~TelemetryLogWriter() { Close(); }
+
+    // Creates (truncates) the file and starts the writer thread
+    bool Open(const std::filesystem::path& path);
+    // Flushes the open block, writes the footer and joins the thread
+    void Close();
+    bool IsOpen() const { return open.load(std::memory_order_acquire); }
+
+    // Producer side (one thread). Columns are append-only; returns the index or -1.
+    int AddColumn(const SensorDesc& desc);
+    int ColumnCount() const { return columnCount.load(std::memory_order_acquire); }
+    bool Push(int64_t timeMs, const float* values, int count);
+
+    uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+    uint64_t BytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); }
+
+private:
+    struct Sample {
+        int64_t timeMs;
+        int count;
+        float values[TLOG_MAX_COLUMNS];
+    };
+
+    void Run();
+    void Append(const Sample& s);
+    void FlushBlock();
+    void WriteSchema(int upTo);
+    void WriteRecord(uint32_t type, const void* payload, size_t size);
+
+    std::atomic<bool> open{ false };
+    SpscQueue<Sample, TLOG_QUEUE_DEPTH> queue;
+    Sample pushScratch = {};
+
+    TelemetryColumnEntry columns[TLOG_MAX_COLUMNS] = {};
+    std::atomic<int> columnCount{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::atomic<uint64_t> bytesWritten{ 0 };
+
+    // Writer thread only
+    std::ofstream file;
+    uint64_t offset = 0;
+    int schemaColumns = 0;
+    int blockColumns = 0;
+    std::vector<int64_t> blockTimes;
+    std::vector<float> blockValues;     // Row-major [row * blockColumns + column]
+    std::vector<uint8_t> encoded;
+    std::vector<TelemetryBlockInfo> index;
+    Sample popScratch = {};
+
+    std::thread worker;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    bool stopping = false;
+};
+
+// ---------------------------------------------------------
+//  READER
+// ---------------------------------------------------------
+struct TelemetryBlock {
+    int rows = 0;
+    int columns = 0;
+    std::vector<int64_t> times;
+    std::vector<float> values;          // Column-major [column * rows + row]
+};
+
+class TelemetryLogReader {
+public:
+    // Maps the file. Uses the footer when present, otherwise rebuilds the index by scanning.
+    bool Open(const std::filesystem::path& path);
+    bool Recovered() const { return recovered; }
+
+    int ColumnCount() const { return (int)columns.size(); }
+    const TelemetryColumnEntry& Column(int i) const { return columns[i]; }
+    int FindColumn(const char* name) const;
+    int BlockCount() const { return (int)blocks.size(); }
+    const TelemetryBlockInfo& Block(int i) const { return blocks[i]; }
+
+    // First block that may hold rows at or after fromMs (blocks are in time order)
+    int FindBlock(int64_t fromMs) const;
+    bool ReadBlock(int block, TelemetryBlock& out) const;
+    // Decode just the timestamps, or just one column, of a block.
+    // ReadColumn fails if the block predates the column.
+    bool ReadTimes(int block, std::vector<int64_t>& out) const;
+    bool ReadColumn(int block, int column, std::vector<float>& out) const;
+
+private:
+    struct BlockView {
+        TelemetryBlockHeader header;
+        const uint8_t* times;
+        const uint8_t* sizeTable;
+        const uint8_t* columns;
+        const uint8_t* end;
+    };
+    bool View(int block, BlockView& out) const;
+    bool ColumnSpan(const BlockView& v, int column, const uint8_t*& data, uint32_t& bytes) const;
+    bool ReadFooter();
+    void Scan();
+    void AddSchema(const uint8_t* payload, size_t size);
+
+    MappedFile map;
+    std::vector<TelemetryColumnEntry> columns;
+    std::vector<TelemetryBlockInfo> blocks;
+    bool recovered = false;
+};
+
+// Rows in [fromMs, toMs] as CSV; columns a block predates are left empty
+void WriteTelemetryCsv(const TelemetryLogReader& reader, std::ostream& os, int64_t fromMs, int64_t toMs);
@@ -0,0 +1,189 @@
+#include "TelemetryQuery.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+// ---------------------------------------------------------
+//  QUANTILE SKETCH
+//  Bucket i holds magnitudes in (MIN * G^(i-1), MIN * G^i]; reporting
+//  the bucket's midpoint bounds the relative error by (G-1)/(G+1).
+// ---------------------------------------------------------
+static constexpr double SKETCH_GAMMA = 1.02;
+static constexpr double SKETCH_MIN = 1e-3;     // Smaller magnitudes count as zero
+static constexpr int SKETCH_BUCKETS = 1100;     // Up to ~1e7
+
+QuantileSketch::QuantileSketch() : positive(SKETCH_BUCKETS, 0), negative(SKETCH_BUCKETS, 0) {}
+
+int QuantileSketch::Bucket(double magnitude) {
+    int i = (int)std::ceil(std::log(magnitude / SKETCH_MIN) / std::log(SKETCH_GAMMA));
+    return std::clamp(i, 0, SKETCH_BUCKETS - 1);
+}
+
+double QuantileSketch::BucketValue(int bucket) {
+    return SKETCH_MIN * 2.0 * std::pow(SKETCH_GAMMA, bucket) / (SKETCH_GAMMA + 1.0);
+}
+
+void QuantileSketch::Add(float v) {
+    double m = std::fabs((double)v);
+    if (m < SKETCH_MIN) zero++;
+    else if (v > 0) positive[Bucket(m)]++;
+    else negative[Bucket(m)]++;
+    count++;
+}
+
+void QuantileSketch::Merge(const QuantileSketch& other) {
+    for (int i = 0; i < SKETCH_BUCKETS; i++) {
+        positive[i] += other.positive[i];
+        negative[i] += other.negative[i];
+    }
+    zero += other.zero;
+    count += other.count;
+}
+
+double QuantileSketch::Quantile(double q) const {
+    if (count == 0) return NAN;
+    uint64_t rank = (uint64_t)(std::clamp(q, 0.0, 1.0) * (double)(count - 1));
+    uint64_t seen = 0;
+    // Ascending order: most negative first, then zero, then positives
+    for (int i = SKETCH_BUCKETS - 1; i >= 0; i--) {
+        seen += negative[i];
+        if (seen > rank) return -BucketValue(i);
+    }
+    seen += zero;
+    if (seen > rank) return 0.0;
+    for (int i = 0; i < SKETCH_BUCKETS; i++) {
+        seen += positive[i];
+        if (seen > rank) return BucketValue(i);
+    }
+    return BucketValue(SKETCH_BUCKETS - 1);
+}
+
+void SensorAggregate::Merge(const SensorAggregate& other) {
+    if (other.samples == 0) return;
+    min = samples ? (std::min)(min, other.min) : other.min;
+    max = samples ? (std::max)(max, other.max) : other.max;
+    samples += other.samples;
+    sum += other.sum;
+    coveredMs += other.coveredMs;
+    aboveMs += other.aboveMs;
+    sketch.Merge(other.sketch);
+}
+
+// ---------------------------------------------------------
+//  QUERY
+// ---------------------------------------------------------
+static bool MatchSensor(const std::vector<std::string>& patterns, const char* name) {
+    if (patterns.empty()) return true;
+    for (const std::string& p : patterns) {
+        if (!p.empty() && p.back() == '*') {
+            if (strncmp(name, p.c_str(), p.size() - 1) == 0) return true;
+        }
+        else if (p == name) return true;
+    }
+    return false;
+}
+
+static void QueryFile(const std::string& path, const TelemetryQuery& query, TelemetryFileResult& result) {
+    result.path = path;
+    TelemetryLogReader reader;
+    if (!reader.Open(path)) return;
+    result.ok = true;
+    result.recovered = reader.Recovered();
+
+    struct Column {
+        int index;
+        int64_t prevMs;         // Previous in-window sample, for time accounting
+        float prevValue;
+        bool hasPrev;
+    };
+    std::vector<Column> cols;
+    for (int c = 0; c < reader.ColumnCount(); c++) {
+        const TelemetryColumnEntry& e = reader.Column(c);
+        if (!query.includeDetail && (e.flags & 1)) continue;
+        if (!MatchSensor(query.sensors, e.name)) continue;
+
+        SensorAggregate agg;
+        agg.name = e.name;
+        agg.unit = (SensorUnit)e.unit;
+        auto t = query.thresholds.find(agg.name);
+        if (t == query.thresholds.end()) t = query.thresholds.find("");
+        if (t != query.thresholds.end()) { agg.hasThreshold = true; agg.threshold = t->second; }
+        result.sensors.push_back(std::move(agg));
+        cols.push_back({ c, 0, 0.0f, false });
+    }
+    if (cols.empty()) return;
+
+    std::vector<int64_t> times;
+    std::vector<float> values;
+    for (int b = reader.FindBlock(query.fromMs); b < reader.BlockCount() && reader.Block(b).firstMs <= query.toMs; b++) {
+        if (!reader.ReadTimes(b, times)) continue;
+        // Rows inside the window; times are sorted within a block
+        int first = (int)(std::lower_bound(times.begin(), times.end(), query.fromMs) - times.begin());
+        int last = (int)(std::upper_bound(times.begin(), times.end(), query.toMs) - times.begin());
+        if (first >= last) continue;
+        result.blocksRead++;
+
+        for (size_t k = 0; k < cols.size(); k++) {
+            Column& col = cols[k];
+            if (!reader.ReadColumn(b, col.index, values)) continue;    // Block predates the column
+            SensorAggregate& agg = result.sensors[k];
+            for (int r = first; r < last; r++) {
+                float v = values[r];
+                if (std::isnan(v)) { col.hasPrev = false; continue; }
+                if (col.hasPrev) {
+                    int64_t dt = (std::min)(times[r] - col.prevMs, query.maxGapMs);
+                    agg.coveredMs += dt;
+                    if (agg.hasThreshold && col.prevValue > agg.threshold) agg.aboveMs += dt;
+                }
+                col.prevMs = times[r];
+                col.prevValue = v;
+                col.hasPrev = true;
+
+                agg.min = agg.samples ? (std::min)(agg.min, v) : v;
+                agg.max = agg.samples ? (std::max)(agg.max, v) : v;
+                agg.samples++;
+                agg.sum += v;
+                agg.sketch.Add(v);
+            }
+        }
+    }
+}
+
+int64_t TelemetryNewestMs(const std::vector<std::string>& paths) {
+    int64_t newest = INT64_MIN;
+    TelemetryLogReader reader;
+    for (const std::string& p : paths) {
+        if (reader.Open(p) && reader.BlockCount() > 0) newest = (std::max)(newest, reader.Block(reader.BlockCount() - 1).lastMs);
+    }
+    return newest;
+}
+
+void RunTelemetryQuery(const std::vector<std::string>& paths, const TelemetryQuery& query, int threads,
+    std::vector<TelemetryFileResult>& perFile, std::vector<SensorAggregate>& merged) {
+    perFile.assign(paths.size(), {});
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&]() {
+        for (size_t i; (i = next.fetch_add(1)) < paths.size();) QueryFile(paths[i], query, perFile[i]);
+    };
+    int n = std::clamp(threads, 1, (int)(std::max)(paths.size(), (size_t)1));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < n; t++) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+
+    // Merge by name, keeping first-seen order
+    merged.clear();
+    std::map<std::string, size_t> byName;
+    for (const TelemetryFileResult& f : perFile) {
+        for (const SensorAggregate& s : f.sensors) {
+            auto it = byName.find(s.name);
+            if (it == byName.end()) {
+                byName[s.name] = merged.size();
+                merged.push_back(s);
+            }
+            else merged[it->second].Merge(s);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "TelemetryLog.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------
+//  TELEMETRY QUERY
+//  Aggregates over a time window of one or many telemetry logs.
+//  Only the blocks overlapping the window and the columns that match
+//  are decoded; files are scanned in parallel and the per-sensor
+//  aggregates merged by name, so logs from many machines combine.
+// ---------------------------------------------------------
+
+// Log-spaced histogram with ~1% relative error. Fixed size and
+// mergeable, so percentiles over weeks of 2 Hz data need no sorting.
+class QuantileSketch {
+public:
+    QuantileSketch();
+    void Add(float v);
+    void Merge(const QuantileSketch& other);
+    uint64_t Count() const { return count; }
+    double Quantile(double q) const;     // q in [0, 1]
+
+private:
+    static int Bucket(double magnitude);
+    static double BucketValue(int bucket);
+
+    std::vector<uint64_t> positive, negative;
+    uint64_t zero = 0;
+    uint64_t count = 0;
+};
+
+struct SensorAggregate {
+    std::string name;
+    SensorUnit unit = SensorUnit::Count;
+    uint64_t samples = 0;
+    double sum = 0.0;
+    float min = 0.0f;
+    float max = 0.0f;
+    double threshold = 0.0;
+    bool hasThreshold = false;
+    int64_t coveredMs = 0;      // Time between consecutive samples (gaps capped)
+    int64_t aboveMs = 0;        // Part of coveredMs spent above the threshold
+    QuantileSketch sketch;
+
+    void Merge(const SensorAggregate& other);
+};
+
+struct TelemetryQuery {
+    int64_t fromMs = INT64_MIN;
+    int64_t toMs = INT64_MAX;
+    std::vector<std::string> sensors;       // Exact names or "prefix*"; empty = all
+    std::map<std::string, double> thresholds;   // By sensor name; "" applies to all
+    int64_t maxGapMs = 5000;                // Longer gaps count as "not recording"
+    bool includeDetail = true;
+};
+
+struct TelemetryFileResult {
+    std::string path;
+    bool ok = false;
+    bool recovered = false;
+    int blocksRead = 0;
+    std::vector<SensorAggregate> sensors;
+};
+
+// Newest sample across the files (footer/index only), or INT64_MIN if none
+int64_t TelemetryNewestMs(const std::vector<std::string>& paths);
+
+// Runs the query on every file using up to 'threads' workers.
+// Fills one result per file (same order) and the merged per-sensor totals.
+void RunTelemetryQuery(const std::vector<std::string>& paths, const TelemetryQuery& query, int threads,
+    std::vector<TelemetryFileResult>& perFile, std::vector<SensorAggregate>& merged);
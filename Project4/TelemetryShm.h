@@ -0,0 +1,251 @@
+#ifndef TELEMETRY_SHM_H
+#define TELEMETRY_SHM_H
+// ---------------------------------------------------------
+//  SHARED-MEMORY TELEMETRY (reader, header-only, C or C++)
+//  The collector publishes every hub sensor in one named mapping
+//  (shm_open on Linux, a pagefile-backed section on Windows):
+//    TshmHeader   at 0
+//    TshmSensor   capacity slots at sensorsOffset, sensorStride apart
+//    float        capacity values at valuesOffset
+//  Values are updated under a seqlock: 'sequence' is odd while a
+//  publish is in flight, and a read that saw it change is retried.
+//  Sensors are only ever appended; a slot below sensorCount never
+//  changes, so its metadata can be read once and cached. On Windows a
+//  reader's handle keeps the section alive, so a restarted writer
+//  reuses it in place: a changed writerPid means the same as live
+//  going to 0, and cached metadata must be read again.
+//
+//  Compatibility: a new field goes at the end of its struct and bumps
+//  versionMinor; readers step by headerSize/sensorStride and the
+//  offsets, never by sizeof, so an older reader keeps working. Only a
+//  change to an existing field bumps versionMajor, which tshm_open
+//  refuses.
+//
+//  Plain C on POSIX needs the POSIX declarations (-std=gnu11, or
+//  _POSIX_C_SOURCE 200809L before any include).
+//
+//    TshmReader r;
+//    if (tshm_open(&r, NULL)) {
+//        float v[TSHM_MAX_SENSORS];
+//        uint32_t n = tshm_read(&r, v, TSHM_MAX_SENSORS, NULL);
+//        for (uint32_t i = 0; i < n; i++) printf("%s %g %s\n", tshm_sensor(&r, i)->name, v[i], tshm_sensor(&r, i)->unit);
+//        tshm_close(&r);
+//    }
+// ---------------------------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define TSHM_MAGIC 0x4D485354u          // "TSHM"
+#define TSHM_VERSION_MAJOR 1
+#define TSHM_VERSION_MINOR 0
+#define TSHM_MAX_SENSORS 512
+#ifdef _WIN32
+#define TSHM_DEFAULT_NAME "Local\\AppleOverlay.Telemetry"
+#else
+#define TSHM_DEFAULT_NAME "/AppleOverlay.Telemetry"
+#endif
+
+// TshmSensor.unitCode, same order as SensorUnit
+enum {
+    TSHM_UNIT_PERCENT, TSHM_UNIT_CELSIUS, TSHM_UNIT_VOLT, TSHM_UNIT_RPM,
+    TSHM_UNIT_MEGABYTES, TSHM_UNIT_MEGABYTES_PER_SEC, TSHM_UNIT_COUNT, TSHM_UNIT_MHZ,
+};
+#define TSHM_SENSOR_DETAIL 0x01         // High-cardinality (per-core etc.)
+// tshm_read gives up after this many attempts. A publish takes microseconds; each attempt that
+// finds one in flight yields the CPU, so this is on the order of a second.
+#define TSHM_READ_TRIES 1000000
+
+typedef struct TshmHeader {
+    uint32_t magic;             // Stored last by the writer; 0 while it is still setting up
+    uint16_t versionMajor;
+    uint16_t versionMinor;
+    uint32_t headerSize;        // sizeof(TshmHeader) as written
+    uint32_t sensorStride;      // sizeof(TshmSensor) as written
+    uint32_t capacity;          // Sensor slots in the mapping
+    uint32_t sensorsOffset;     // From the start of the mapping
+    uint32_t valuesOffset;
+    uint32_t writerPid;         // Stored first, before the rest of the setup
+    uint32_t sequence;          // Seqlock over sensorCount, the values and the publish fields
+    uint32_t sensorCount;       // Only grows
+    uint32_t live;              // Cleared when the writer closes; reopen to find its successor
+    uint32_t intervalMs;        // How often the writer publishes
+    int64_t publishMs;          // Wall clock of the last publish, Unix ms
+    uint64_t publishes;
+} TshmHeader;
+
+typedef struct TshmSensor {
+    char name[48];              // "nct.cpu_temp", NUL-terminated
+    char unit[8];               // Display suffix: "%", "C", "V", "RPM", "MB", "MB/s", "", "MHz"
+    uint8_t unitCode;           // TSHM_UNIT_*
+    uint8_t flags;              // TSHM_SENSOR_*
+    uint16_t provider;          // Sensors from one source share this
+    float scale;                // value * scale = base unit (fraction, bytes, Hz); 1 where it already is
+} TshmSensor;
+
+#ifdef __cplusplus
+static_assert(sizeof(TshmHeader) == 64, "TelemetryShm layout");
+static_assert(sizeof(TshmSensor) == 64, "TelemetryShm layout");
+#else
+_Static_assert(sizeof(TshmHeader) == 64, "TelemetryShm layout");
+_Static_assert(sizeof(TshmSensor) == 64, "TelemetryShm layout");
+#endif
+
+// Aligned 32-bit loads are single-copy atomic everywhere we run; these add the ordering
+#if defined(_MSC_VER) && !defined(__clang__)
+static inline uint32_t tshm_load_acquire(const uint32_t* p) { uint32_t v = *(const volatile uint32_t*)p; MemoryBarrier(); return v; }
+static inline uint32_t tshm_load_relaxed(const uint32_t* p) { return *(const volatile uint32_t*)p; }
+static inline void tshm_fence_acquire(void) { MemoryBarrier(); }
+static inline void tshm_pause(void) { SwitchToThread(); }
+#else
+static inline uint32_t tshm_load_acquire(const uint32_t* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline uint32_t tshm_load_relaxed(const uint32_t* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline void tshm_fence_acquire(void) { __atomic_thread_fence(__ATOMIC_ACQUIRE); }
+#ifdef _WIN32
+static inline void tshm_pause(void) { SwitchToThread(); }
+#else
+static inline void tshm_pause(void) { sched_yield(); }
+#endif
+#endif
+
+typedef struct TshmReader {
+    const TshmHeader* header;
+    size_t size;
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+} TshmReader;
+
+static inline void tshm_close(TshmReader* r) {
+    if (r->header) {
+#ifdef _WIN32
+        UnmapViewOfFile((LPCVOID)r->header);
+        CloseHandle(r->mapping);
+#else
+        munmap((void*)r->header, r->size);
+#endif
+    }
+    memset(r, 0, sizeof(*r));
+}
+
+// Maps the block read-only. 'name' NULL means TSHM_DEFAULT_NAME. Returns 0 if there is no
+// writer yet, it is still setting up, or it speaks another major version.
+static inline int tshm_open(TshmReader* r, const char* name) {
+    memset(r, 0, sizeof(*r));
+    if (!name) name = TSHM_DEFAULT_NAME;
+#ifdef _WIN32
+    r->mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+    if (!r->mapping) return 0;
+    r->header = (const TshmHeader*)MapViewOfFile(r->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!r->header) { CloseHandle(r->mapping); r->mapping = NULL; return 0; }
+    MEMORY_BASIC_INFORMATION info;
+    r->size = VirtualQuery(r->header, &info, sizeof(info)) ? info.RegionSize : 0;
+#else
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(TshmHeader)) {
+        void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (p != MAP_FAILED) { r->header = (const TshmHeader*)p; r->size = (size_t)st.st_size; }
+    }
+    close(fd);
+    if (!r->header) return 0;
+#endif
+    const TshmHeader* h = r->header;
+    if (r->size < sizeof(TshmHeader) || tshm_load_acquire(&h->magic) != TSHM_MAGIC || h->versionMajor != TSHM_VERSION_MAJOR ||
+        h->sensorStride < sizeof(TshmSensor) || (uint64_t)h->sensorsOffset + (uint64_t)h->capacity * h->sensorStride > r->size ||
+        (uint64_t)h->valuesOffset + (uint64_t)h->capacity * sizeof(float) > r->size) {
+        tshm_close(r);
+        return 0;
+    }
+    return 1;
+}
+
+// 0 once the writer has closed; the mapping stays readable but is frozen
+static inline int tshm_live(const TshmReader* r) { return tshm_load_acquire(&r->header->live) != 0; }
+
+// 0 if the process that created the block has exited (its pid may since have been reused,
+// so 1 is only a strong hint)
+static inline int tshm_writer_alive(const TshmReader* r) {
+    uint32_t pid = tshm_load_relaxed(&r->header->writerPid);
+#ifdef _WIN32
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, pid);
+    if (!process) return GetLastError() == ERROR_ACCESS_DENIED;
+    DWORD wait = WaitForSingleObject(process, 0);
+    CloseHandle(process);
+    return wait == WAIT_TIMEOUT;
+#else
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+#endif
+}
+
+static inline uint32_t tshm_sensor_count(const TshmReader* r) { return tshm_load_acquire(&r->header->sensorCount); }
+
+// Metadata of slot i < tshm_sensor_count(); never changes once published
+static inline const TshmSensor* tshm_sensor(const TshmReader* r, uint32_t i) {
+    return (const TshmSensor*)((const uint8_t*)r->header + r->header->sensorsOffset + (size_t)i * r->header->sensorStride);
+}
+
+// Slot of a sensor by name, or -1 (it may appear later)
+static inline int tshm_find(const TshmReader* r, const char* name) {
+    uint32_t count = tshm_sensor_count(r);
+    for (uint32_t i = 0; i < count; i++) {
+        if (strncmp(tshm_sensor(r, i)->name, name, sizeof(tshm_sensor(r, i)->name)) == 0) return (int)i;
+    }
+    return -1;
+}
+
+// The latest value of one sensor, straight from the mapping (no retry, no copy of the rest)
+static inline float tshm_value(const TshmReader* r, uint32_t i) {
+    const uint32_t* values = (const uint32_t*)((const uint8_t*)r->header + r->header->valuesOffset);
+    uint32_t bits = tshm_load_relaxed(&values[i]);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// A consistent snapshot of the first 'max' values, all from the same publish. Returns how many
+// were copied; 'publishes' (optional) receives the publish count, to skip unchanged snapshots.
+// Returns 0 without a snapshot if the writer died mid-publish (the sequence stays odd) or
+// TSHM_READ_TRIES attempts never saw a stable one; reopen to find its successor.
+static inline uint32_t tshm_read(const TshmReader* r, float* out, uint32_t max, uint64_t* publishes) {
+    const TshmHeader* h = r->header;
+    const uint32_t* values = (const uint32_t*)((const uint8_t*)h + h->valuesOffset);
+    const uint32_t* counter = (const uint32_t*)&h->publishes;     // Two halves, checked by the sequence
+    for (uint32_t tries = 0; tries < TSHM_READ_TRIES; tries++) {
+        uint32_t before = tshm_load_acquire(&h->sequence);
+        if (before & 1) {
+            // Stuck odd: check now and then whether anyone is left to finish the publish
+            if ((tries & 1023) == 1023 && (!tshm_live(r) || !tshm_writer_alive(r))) return 0;
+            tshm_pause();
+            continue;
+        }
+        uint32_t count = tshm_load_relaxed(&h->sensorCount);
+        if (count > max) count = max;
+        if (count > h->capacity) count = h->capacity;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t bits = tshm_load_relaxed(&values[i]);
+            memcpy(&out[i], &bits, sizeof(float));
+        }
+        uint64_t n = tshm_load_relaxed(&counter[0]) | ((uint64_t)tshm_load_relaxed(&counter[1]) << 32);
+        tshm_fence_acquire();
+        if (tshm_load_relaxed(&h->sequence) == before) {
+            if (publishes) *publishes = n;      // Little-endian halves; every supported target is
+            return count;
+        }
+    }
+    return 0;
+}
+
+#endif
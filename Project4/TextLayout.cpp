@@ -0,0 +1,59 @@
+#include "TextLayout.hpp"
+#include "GlyphAtlas.hpp"
+#include <algorithm>
+
+static size_t LayoutKey(const wchar_t* text, wchar_t* key, size_t cap) {
+    size_t n = 0;
+    for (; text[n] && n < cap; n++) key[n] = (text[n] >= L'0' && text[n] <= L'9') ? L'0' : text[n];
+    return n;
+}
+
+const TextRun& TextLayoutCache::Layout(UiFont font, const wchar_t* text) {
+    wchar_t key[UI_TEXT_MAX];
+    std::wstring_view view(key, LayoutKey(text, key, UI_TEXT_MAX));
+    Map& map = runs[(int)font];
+    auto it = map.find(view);
+    if (it != map.end()) { hits++; return it->second; }
+
+    misses++;
+    if (map.size() >= MAX_RUNS) map.clear();    // Strings that never repeat; start over rather than track recency
+    const GlyphAtlas& atlas = GlyphAtlas::Get();
+    TextRun run;
+    run.pen.reserve(view.size());
+    for (wchar_t ch : view) {
+        run.pen.push_back((uint16_t)run.width);
+        run.width += atlas.Glyph(font, ch).advance;
+    }
+    return map.emplace(std::wstring(view), std::move(run)).first->second;
+}
+
+bool TextLayoutCache::ChangedSpan(UiFont font, const wchar_t* a, const wchar_t* b, int& x0, int& x1) {
+    int first = -1, last = -1, i = 0;
+    auto isDigit = [](wchar_t c) { return c >= L'0' && c <= L'9'; };
+    for (; a[i] && b[i]; i++) {
+        if (a[i] == b[i]) continue;
+        if (!isDigit(a[i]) || !isDigit(b[i])) return false;
+        if (first < 0) first = i;
+        last = i;
+    }
+    if (a[i] || b[i]) return false;     // Different lengths
+    if (first < 0) { x0 = x1 = 0; return true; }
+
+    const GlyphAtlas& atlas = GlyphAtlas::Get();
+    const TextRun& run = Layout(font, a);
+    x0 = run.pen[first];
+    x1 = run.pen[last] + atlas.Glyph(font, L'0').advance;
+    // Anti-aliased edges may spill past the advance box
+    for (int d = first; d <= last; d++) {
+        const GlyphInfo& ga = atlas.Glyph(font, a[d]), & gb = atlas.Glyph(font, b[d]);
+        x0 = (std::min)(x0, run.pen[d] + (std::min)(ga.left, gb.left));
+        x1 = (std::max)(x1, run.pen[d] + (std::max)(ga.left + ga.w, gb.left + gb.w));
+    }
+    return true;
+}
+
+size_t TextLayoutCache::Size() const {
+    size_t n = 0;
+    for (const Map& m : runs) n += m.size();
+    return n;
+}
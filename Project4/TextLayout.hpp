@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "UiTree.hpp"
+
+// ---------------------------------------------------------
+//  TEXT LAYOUT CACHE
+//  Laid-out runs (pen offset per character) keyed by font and by the
+//  string with every digit replaced by '0'. Digits are tabular in the
+//  atlas, so "45%" and "46%" share one entry: a ticking value never
+//  misses the cache, and only the glyphs that changed need repainting.
+// ---------------------------------------------------------
+struct TextRun {
+    std::vector<uint16_t> pen;  // x of each character relative to the start of the run
+    int width = 0;
+};
+
+class TextLayoutCache {
+public:
+    const TextRun& Layout(UiFont font, const wchar_t* text);
+    // Columns [x0, x1), relative to the run start, covering every glyph that differs
+    // between a and b. False when the two strings do not share a layout.
+    bool ChangedSpan(UiFont font, const wchar_t* a, const wchar_t* b, int& x0, int& x1);
+
+    size_t Size() const;
+    uint64_t Hits() const { return hits; }
+    uint64_t Misses() const { return misses; }
+
+private:
+    // Transparent hashing so lookups do not allocate a key
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::wstring_view s) const { return std::hash<std::wstring_view>()(s); }
+    };
+    using Map = std::unordered_map<std::wstring, TextRun, Hash, std::equal_to<>>;
+
+    static constexpr size_t MAX_RUNS = 512;  // Per font; the overlay uses a few dozen
+    Map runs[(int)UiFont::Count];
+    uint64_t hits = 0, misses = 0;
+};
@@ -0,0 +1,61 @@
+#include "UiCanvas.hpp"
+
+UiRgba UiPaletteColor(UiColor color) {
+    switch (color) {
+    case UiColor::White: return { 255, 255, 255, 255 };
+    case UiColor::Gray: return { 142, 142, 147, 150 };
+    case UiColor::Blue: return { 10, 132, 255, 255 };
+    case UiColor::Red: return { 255, 69, 58, 255 };
+    case UiColor::Yellow: return { 255, 204, 0, 255 };
+    case UiColor::Green: return { 46, 204, 113, 255 };
+    case UiColor::Track: return { 255, 255, 255, 50 };
+    case UiColor::ButtonActive: return { 255, 69, 58, 200 };
+    case UiColor::ButtonIdle: return { 80, 80, 80, 80 };
+    case UiColor::Border: return { 255, 255, 255, 50 };
+    default: return { 20, 20, 22, 230 };    // Background; the panel widget overrides alpha
+    }
+}
+
+static void PaintWidget(IUiCanvas& c, const UiWidget& w) {
+    const UiRect& r = w.rect;
+    UiRgba color = UiPaletteColor(w.color);
+    switch (w.kind) {
+    case UiKind::Panel: {
+        UiRgba bg = UiPaletteColor(UiColor::Background);
+        bg.a = w.alpha;
+        c.FillRoundRect(r, w.radius, bg);
+        c.StrokeRoundRect(r, w.radius, UiPaletteColor(w.track));
+        break;
+    }
+    case UiKind::Dot:
+        c.FillRoundRect(r, w.radius, color);
+        break;
+    case UiKind::Text:
+        c.DrawText(w.text, w.font, r.x, r.y, color);
+        break;
+    case UiKind::Bar: {
+        c.FillRoundRect(r, r.h, UiPaletteColor(w.track));
+        float fillW = r.w * w.value; if (fillW < r.h) fillW = (float)r.h; if (fillW > r.w) fillW = (float)r.w;
+        c.FillRoundRect({ r.x, r.y, (int)fillW, r.h }, r.h, color);
+        break;
+    }
+    case UiKind::Button: {
+        c.FillRoundRect(r, w.radius, UiPaletteColor(w.active ? UiColor::ButtonActive : UiColor::ButtonIdle));
+        int textW = c.MeasureText(w.text, w.font);
+        c.DrawText(w.text, w.font, r.x + (r.w - textW) / 2, r.y + 5, UiPaletteColor(UiColor::White));
+        break;
+    }
+    }
+}
+
+void PaintUiFrame(IUiCanvas& canvas, const UiFrame& frame, const UiRect* dirty, int count) {
+    for (int i = 0; i < count; i++) {
+        canvas.SetClip(dirty[i]);
+        canvas.Clear();
+        // Text may overhang its line box slightly; the clip keeps it inside the region
+        for (const UiWidget& w : frame.widgets) {
+            if (w.rect.Intersects(dirty[i])) PaintWidget(canvas, w);
+        }
+        canvas.ResetClip();
+    }
+}
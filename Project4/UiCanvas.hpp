@@ -0,0 +1,33 @@
+#pragma once
+#include "UiTree.hpp"
+
+// ---------------------------------------------------------
+//  UI CANVAS
+//  The handful of primitives the overlay needs. PaintUiFrame maps
+//  widgets onto them, so a backend only has to draw shapes and text;
+//  SoftCanvas serves both the desktop window and headless renders.
+// ---------------------------------------------------------
+struct UiRgba {
+    uint8_t r, g, b, a;
+};
+
+UiRgba UiPaletteColor(UiColor color);
+
+class IUiCanvas {
+public:
+    virtual ~IUiCanvas() = default;
+    virtual void SetClip(const UiRect& r) = 0;
+    virtual void ResetClip() = 0;
+    // Sets every pixel inside the clip to transparent
+    virtual void Clear() = 0;
+    // 'diameter' is the corner arc size, as in GraphicsPath::AddArc
+    virtual void FillRoundRect(const UiRect& r, int diameter, UiRgba color) = 0;
+    // One pixel wide, centered on the outline
+    virtual void StrokeRoundRect(const UiRect& r, int diameter, UiRgba color) = 0;
+    virtual int MeasureText(const wchar_t* text, UiFont font) = 0;
+    // (x, y) is the top-left of the line box
+    virtual void DrawText(const wchar_t* text, UiFont font, int x, int y, UiRgba color) = 0;
+};
+
+// Clears and repaints each dirty rect (clipped) with the widgets that touch it
+void PaintUiFrame(IUiCanvas& canvas, const UiFrame& frame, const UiRect* dirty, int count);
@@ -0,0 +1,115 @@
+#include "UiTree.hpp"
+#include "TextLayout.hpp"
+#include <algorithm>
+#include <cwchar>
+#include <iterator>
+
+bool UiRect::Intersects(const UiRect& o) const {
+    return !Empty() && !o.Empty() && x < o.Right() && o.x < Right() && y < o.Bottom() && o.y < Bottom();
+}
+
+UiRect UiRect::Union(const UiRect& o) const {
+    if (Empty()) return o;
+    if (o.Empty()) return *this;
+    int l = (std::min)(x, o.x), t = (std::min)(y, o.y);
+    return { l, t, (std::max)(Right(), o.Right()) - l, (std::max)(Bottom(), o.Bottom()) - t };
+}
+
+UiRect UiRect::Intersect(const UiRect& o) const {
+    int l = (std::max)(x, o.x), t = (std::max)(y, o.y);
+    int r = (std::min)(Right(), o.Right()), b = (std::min)(Bottom(), o.Bottom());
+    if (r <= l || b <= t) return {};
+    return { l, t, r - l, b - t };
+}
+
+bool UiWidget::operator==(const UiWidget& o) const {
+    return kind == o.kind && rect == o.rect && color == o.color && track == o.track && font == o.font &&
+        active == o.active && alpha == o.alpha && radius == o.radius && value == o.value && wcscmp(text, o.text) == 0;
+}
+
+void UiFrame::Clear(int w, int h) {
+    width = w;
+    height = h;
+    widgets.clear();    // Keeps capacity: steady-state frames do not allocate
+    std::fill(std::begin(hits), std::end(hits), UiRect{});
+}
+
+UiWidget& UiFrame::Add(UiKind kind, UiRect rect) {
+    widgets.emplace_back();
+    UiWidget& w = widgets.back();
+    w.kind = kind;
+    w.rect = rect;
+    return w;
+}
+
+void UiFrame::Text(UiFont font, UiColor color, int x, int y, const wchar_t* text) {
+    UiWidget& w = Add(UiKind::Text, { x, y, width - x, UiLineHeight(font) });
+    w.font = font;
+    w.color = color;
+    for (int i = 0; i < UI_TEXT_MAX - 1 && text[i]; i++) w.text[i] = text[i];
+}
+
+int UiLineHeight(UiFont font) {
+    switch (font) {
+    case UiFont::Header: return 22;
+    case UiFont::Body: return 18;
+    default: return 15;
+    }
+}
+
+// Same widget with only its text changed: the columns of the glyphs that differ
+static bool NarrowTextChange(const UiWidget& a, const UiWidget& b, TextLayoutCache& text, UiRect& out) {
+    if (a.kind != UiKind::Text || b.kind != UiKind::Text || !(a.rect == b.rect) || a.font != b.font || a.color != b.color) return false;
+    int x0, x1;
+    if (!text.ChangedSpan(a.font, a.text, b.text, x0, x1)) return false;
+    out = { a.rect.x + x0, a.rect.y, x1 - x0, a.rect.h };
+    return true;
+}
+
+int DiffUiFrames(const UiFrame& prev, const UiFrame& next, UiRect* out, int max, TextLayoutCache* text) {
+    if (max <= 0) return 0;
+    UiRect whole = { 0, 0, next.width, next.height };
+    if (prev.widgets.empty() || prev.width != next.width || prev.height != next.height) {
+        out[0] = whole;
+        return 1;
+    }
+
+    // Widgets are matched by position in the list; a layout shift shows up as many changes
+    std::vector<UiRect> dirty;
+    size_t n = (std::max)(prev.widgets.size(), next.widgets.size());
+    for (size_t i = 0; i < n; i++) {
+        const UiWidget* a = i < prev.widgets.size() ? &prev.widgets[i] : nullptr;
+        const UiWidget* b = i < next.widgets.size() ? &next.widgets[i] : nullptr;
+        if (a && b && *a == *b) continue;
+        UiRect r;
+        if (!(a && b && text && NarrowTextChange(*a, *b, *text, r))) {
+            r = a ? a->rect : UiRect{};
+            if (b) r = r.Union(b->rect);
+        }
+        r = r.Intersect(whole);
+        if (!r.Empty()) dirty.push_back(r);
+    }
+
+    // Merge overlapping rects until stable, then collapse to the bounding box if still too many
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (size_t i = 0; i < dirty.size() && !merged; i++) {
+            for (size_t j = i + 1; j < dirty.size(); j++) {
+                if (dirty[i].Intersects(dirty[j])) {
+                    dirty[i] = dirty[i].Union(dirty[j]);
+                    dirty.erase(dirty.begin() + j);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+    if ((int)dirty.size() > max) {
+        UiRect all;
+        for (const UiRect& r : dirty) all = all.Union(r);
+        out[0] = all;
+        return 1;
+    }
+    std::copy(dirty.begin(), dirty.end(), out);
+    return (int)dirty.size();
+}
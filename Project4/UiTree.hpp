@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// ---------------------------------------------------------
+//  UI TREE
+//  The overlay is described as a flat, ordered list of widgets (later
+//  ones paint over earlier ones). The list is rebuilt from the stats
+//  every frame but kept between frames: diffing it against the
+//  previous one yields the dirty rects, and only those are repainted
+//  and re-uploaded. No platform types here so layout and dirty
+//  tracking build and run anywhere.
+// ---------------------------------------------------------
+struct UiRect {
+    int x = 0, y = 0, w = 0, h = 0;
+
+    bool Empty() const { return w <= 0 || h <= 0; }
+    int Right() const { return x + w; }
+    int Bottom() const { return y + h; }
+    bool Intersects(const UiRect& o) const;
+    bool Contains(int px, int py) const { return px >= x && px <= Right() && py >= y && py <= Bottom(); }
+    UiRect Union(const UiRect& o) const;
+    UiRect Intersect(const UiRect& o) const;
+    bool operator==(const UiRect& o) const { return x == o.x && y == o.y && w == o.w && h == o.h; }
+};
+
+// Palette and fonts are indices so the renderer can build each brush/font once
+enum class UiColor : uint8_t { White, Gray, Blue, Red, Yellow, Green, Track, ButtonActive, ButtonIdle, Border, Background, Count };
+enum class UiFont : uint8_t { Header, Body, Small, Count };
+
+enum class UiKind : uint8_t {
+    Panel,      // Rounded background with border; 'alpha' is the fill opacity
+    Dot,        // Filled rounded rect, 'radius'
+    Text,       // Left-aligned at rect.x/rect.y
+    Bar,        // Pill track ('track') with a pill fill of 'value' (0..1)
+    Button,     // Rounded button with centered text; 'active' picks the color
+};
+
+constexpr int UI_TEXT_MAX = 96;
+
+struct UiWidget {
+    UiKind kind = UiKind::Text;
+    UiRect rect;
+    UiColor color = UiColor::White;
+    UiColor track = UiColor::Track;
+    UiFont font = UiFont::Body;
+    bool active = false;
+    uint8_t alpha = 255;
+    int radius = 0;
+    float value = 0.0f;
+    wchar_t text[UI_TEXT_MAX] = {};
+
+    bool operator==(const UiWidget& o) const;
+};
+
+// Hit targets the window procedure needs, filled by the layout
+enum class UiHit : uint8_t { FanSlider, MultiCore, SingleCore, GpuTest, MemTest, CpuBurn, RamBurn, GpuBurn, Count };
+
+struct UiFrame {
+    int width = 0;
+    int height = 0;
+    std::vector<UiWidget> widgets;
+    UiRect hits[(int)UiHit::Count];
+
+    void Clear(int w, int h);
+    UiWidget& Add(UiKind kind, UiRect rect);
+    void Text(UiFont font, UiColor color, int x, int y, const wchar_t* text);
+};
+
+// Line box used for text widgets, so a changed string dirties its whole line
+int UiLineHeight(UiFont font);
+
+class TextLayoutCache;
+
+// Rects that differ between two frames, merged into at most 'max' rects.
+// A size change (or an empty 'prev') dirties the whole frame. With a layout
+// cache, a text widget whose digits changed dirties only those glyphs.
+constexpr int UI_MAX_DIRTY = 8;
+int DiffUiFrames(const UiFrame& prev, const UiFrame& next, UiRect* out, int max, TextLayoutCache* text = nullptr);
@@ -0,0 +1,52 @@
+#include "WmiReader.hpp"
+#include <algorithm>
+
+// Any thread may prepare; the session hands out the same id for the same text, so a
+// race only costs a map lookup
+int WmiReader::Query(std::atomic<int>& id, const wchar_t* wql) {
+    int q = id.load(std::memory_order_acquire);
+    if (q < 0) {
+        q = wmi.Prepare(wql);
+        if (q >= 0) id.store(q, std::memory_order_release);
+    }
+    return q;
+}
+
+std::wstring WmiReader::FirstString(std::atomic<int>& id, const wchar_t* wql, const wchar_t* prop) {
+    std::wstring result;
+    int q = Query(id, wql);
+    if (q >= 0) wmi.Exec(q, [&](const IWmiRow& row) { result = row.String(prop); return false; });
+    return result;
+}
+
+std::wstring WmiReader::BoardProduct() {
+    return FirstString(boardQuery, L"SELECT Product FROM Win32_BaseBoard", L"Product");
+}
+
+std::wstring WmiReader::GpuName() {
+    return FirstString(gpuQuery, L"SELECT Name FROM Win32_VideoController", L"Name");
+}
+
+bool WmiReader::RamInfo(WmiRamInfo& out) {
+    int q = Query(ramQuery, L"SELECT Capacity, Speed FROM Win32_PhysicalMemory");
+    WmiRamInfo info;
+    if (q < 0 || !wmi.Exec(q, [&](const IWmiRow& row) {
+        info.modules++;
+        info.capacityBytes += (uint64_t)(std::max)(row.Int(L"Capacity"), 0LL);
+        info.speedMTs = (std::max)(info.speedMTs, (int)row.Int(L"Speed"));
+        return true;
+        })) return false;
+    if (info.modules == 0) return false;
+    out = info;
+    return true;
+}
+
+bool WmiReader::SystemCounters(WmiSystemCounters& out) {
+    static const wchar_t* props[] = { L"Threads", L"ContextSwitchesPerSec" };
+    if (systemHandle < 0) systemHandle = wmi.AddRefreshed(L"Win32_PerfFormattedData_PerfOS_System=@", props, 2);     // Until WMI connects
+    long long values[2];
+    if (systemHandle < 0 || !wmi.Refresh() || !wmi.ReadRefreshed(systemHandle, values)) return false;
+    out.threads = (int)values[0];
+    out.contextSwitchesPerSec = (int)values[1];
+    return true;
+}
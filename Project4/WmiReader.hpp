@@ -0,0 +1,51 @@
+#pragma once
+#include "WmiSource.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// ---------------------------------------------------------
+//  WMI READER
+//  The queries the overlay runs, decoded into plain values. Each WQL
+//  text is prepared once and re-run by id, and the perf object is bound
+//  to the refresher once; while the service is unavailable both are
+//  retried on the next call. Only talks to IWmiSource, so it builds and
+//  is tested on Linux against a fake.
+// ---------------------------------------------------------
+struct WmiRamInfo {
+    int modules = 0;
+    uint64_t capacityBytes = 0;     // Sum over the modules
+    int speedMTs = 0;               // Fastest module's rated speed
+};
+
+struct WmiSystemCounters {
+    int threads = 0;
+    int contextSwitchesPerSec = 0;
+};
+
+class WmiReader {
+public:
+    explicit WmiReader(IWmiSource& wmi) : wmi(wmi) {}
+
+    // Empty if the query failed or returned no row
+    std::wstring BoardProduct();
+    std::wstring GpuName();
+    // False if the query failed or found no modules
+    bool RamInfo(WmiRamInfo& out);
+    // One refresher round trip. Called from a single thread (the poll scheduler).
+    bool SystemCounters(WmiSystemCounters& out);
+
+private:
+    int Query(std::atomic<int>& id, const wchar_t* wql);
+    std::wstring FirstString(std::atomic<int>& id, const wchar_t* wql, const wchar_t* prop);
+
+    IWmiSource& wmi;
+    std::atomic<int> boardQuery{ -1 };
+    std::atomic<int> gpuQuery{ -1 };
+    std::atomic<int> ramQuery{ -1 };
+    int systemHandle = -1;
+};
+
+// The reader over GetWmi(), shared by every subsystem. Binds on first use, so a
+// SetWmiSource() override must come before that.
+WmiReader& GetWmiReader();
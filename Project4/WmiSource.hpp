@@ -0,0 +1,41 @@
+#pragma once
+#include <functional>
+#include <string>
+
+// ---------------------------------------------------------
+//  WMI SOURCE
+//  Process-wide query layer. Queries are prepared once (text, BSTRs and
+//  flags cached) and re-run by id; perf classes go through a refresher
+//  so steady-state polling reuses the same objects. Kept free of COM
+//  types so a fake can stand in for the real service.
+// ---------------------------------------------------------
+class IWmiRow {
+public:
+    virtual ~IWmiRow() = default;
+    virtual std::wstring String(const wchar_t* prop) const = 0;
+    virtual long long Int(const wchar_t* prop) const = 0;
+};
+
+class IWmiSource {
+public:
+    virtual ~IWmiSource() = default;
+    // Same text returns the same id. -1 if the service is unavailable.
+    virtual int Prepare(const wchar_t* wql) = 0;
+    // Visits each row until the callback returns false. Returns false on failure.
+    virtual bool Exec(int query, const std::function<bool(const IWmiRow&)>& onRow) = 0;
+
+    // Registers one perf object (e.g. L"Win32_PerfFormattedData_PerfOS_System=@")
+    // and the integer properties to read from it. Returns a handle or -1.
+    virtual int AddRefreshed(const wchar_t* objectPath, const wchar_t* const* props, int propCount) = 0;
+    // One round trip refreshes every registered object
+    virtual bool Refresh() = 0;
+    // Values in the order given to AddRefreshed
+    virtual bool ReadRefreshed(int handle, long long* out) = 0;
+};
+
+// Joins the process to COM's MTA for its whole lifetime; main() calls it before any thread starts
+void InitCom();
+// The CIMV2 session shared by every subsystem (created on first use)
+IWmiSource& GetWmi();
+// Test hook: route GetWmi() to another source (nullptr restores the real one)
+void SetWmiSource(IWmiSource* source);
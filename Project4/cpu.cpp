@@ -1,7 +1,7 @@
 #include "shared.hpp"
+#include "CpuClock.hpp"
 #include <pdh.h>
 #include <pdhmsg.h>
-#include <immintrin.h> 
 #include <fstream>
 #include <filesystem>
 #include <comdef.h>
@@ -10,9 +10,7 @@
 namespace fs = std::filesystem;
 
 // Definitions
-int g_CpuUsage = 0;
-std::vector<int> g_CoreLoad;
-int g_CpuTemp = 0;
+SeqLock<CpuStats> g_CpuStats;
 std::wstring g_CpuName = L"CPU";
 
 std::atomic<int> g_BenchScore = 0;
@@ -20,73 +18,22 @@ std::atomic<bool> g_BenchRunning = false;
 std::atomic<int> g_BenchProgress = 0;
 std::wstring g_BenchMode = L"";
 
-const int B_WIDTH = 4096;
-const int B_HEIGHT = 4096;
-const int MAX_ITER = 1000;
-
-void BenchmarkWorkerScalar(int startRow, int endRow, std::atomic<long long>* totalIter) {
-    long long localIter = 0;
-    for (int y = startRow; y < endRow; y++) {
-        double ci = (y * (2.0 / B_HEIGHT)) - 1.0;
-        for (int x = 0; x < B_WIDTH; x++) {
-            double cr = (x * (3.5 / B_WIDTH)) - 2.5;
-            double zr = 0.0, zi = 0.0;
-            int iter = 0;
-            while ((zr * zr + zi * zi) <= 4.0 && iter < MAX_ITER) {
-                double temp = zr * zr - zi * zi + cr;
-                zi = 2.0 * zr * zi + ci;
-                zr = temp;
-                iter++;
-            }
-            localIter += iter;
-        }
-        if (y % 10 == 0) g_BenchProgress = (int)((float)y / B_HEIGHT * 100.0f);
-    }
-    *totalIter += localIter;
-}
+// The overlay runs a shorter schedule than headless --bench so a click stays interactive
+static const BenchHarnessConfig s_OverlayBench = { 1, 3, 3.5 };
 
-void BenchmarkWorkerAVX2(int startRow, int endRow, std::atomic<long long>* totalIter) {
-    __m256 ymm_const_2 = _mm256_set1_ps(2.0f);
-    __m256 ymm_const_4 = _mm256_set1_ps(4.0f);
-    __m256 dx = _mm256_set1_ps(3.5f / B_WIDTH);
-    __m256 x_offsets = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
-
-    long long localIter = 0;
-    for (int y = startRow; y < endRow; y++) {
-        float fy = (float)y * (2.0f / B_HEIGHT) - 1.0f;
-        __m256 y0 = _mm256_set1_ps(fy);
-        for (int x = 0; x < B_WIDTH; x += 8) {
-            __m256 x0 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps((float)x), dx), _mm256_mul_ps(x_offsets, dx));
-            x0 = _mm256_sub_ps(x0, _mm256_set1_ps(2.5f));
-            __m256 zr = _mm256_setzero_ps();
-            __m256 zi = _mm256_setzero_ps();
-            __m256 iter_counts = _mm256_setzero_ps();
-            __m256 mask_active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
-
-            for (int i = 0; i < MAX_ITER; i++) {
-                __m256 zr2 = _mm256_mul_ps(zr, zr);
-                __m256 zi2 = _mm256_mul_ps(zi, zi);
-                __m256 dist = _mm256_add_ps(zr2, zi2);
-                __m256 mask_div = _mm256_cmp_ps(dist, ymm_const_4, _CMP_LE_OQ);
-                if (_mm256_movemask_ps(mask_div) == 0) break;
-                mask_active = _mm256_and_ps(mask_active, mask_div);
-                iter_counts = _mm256_add_ps(iter_counts, _mm256_and_ps(mask_active, _mm256_set1_ps(1.0f)));
-                __m256 temp = _mm256_mul_ps(zr, zi);
-                zi = _mm256_add_ps(_mm256_mul_ps(temp, ymm_const_2), y0);
-                zr = _mm256_add_ps(_mm256_sub_ps(zr2, zi2), x0);
-            }
-            float* counts = (float*)&iter_counts;
-            for (int k = 0; k < 8; k++) localIter += (long long)counts[k];
-        }
-        if (y % 10 == 0) g_BenchProgress = (int)((float)y / B_HEIGHT * 100.0f);
+void SaveBenchRecord(BenchRecord& record) {
+    char name[256] = {};
+    {
+        std::lock_guard<std::mutex> lock(g_StatsMutex);
+        WideCharToMultiByte(CP_UTF8, 0, g_CpuName.c_str(), -1, name, sizeof(name) - 1, NULL, NULL);
     }
-    *totalIter += localIter;
-}
-
-bool CpuSupportsAVX2() {
-    int cpuInfo[4];
-    __cpuid(cpuInfo, 0); if (cpuInfo[0] < 7) return false;
-    __cpuid(cpuInfo, 7); return (cpuInfo[1] & (1 << 5)) != 0;
+    record.cpuName = name;
+    SYSTEMTIME st; GetLocalTime(&st);
+    char path[128];
+    snprintf(path, sizeof(path), "bench-%s-%04d%02d%02d-%02d%02d%02d.json", record.benchmark.c_str(),
+        st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    std::ofstream file(path);
+    file << BenchRecordToJson(record);
 }
 
 void StartBenchmark(bool multiCore) {
@@ -97,45 +44,47 @@ void StartBenchmark(bool multiCore) {
         g_BenchScore = 0;
         g_BenchProgress = 0;
 
-        bool useAVX = CpuSupportsAVX2();
-        g_BenchMode = multiCore ? (useAVX ? L"Multi (AVX)" : L"Multi (Std)")
-            : (useAVX ? L"Single (AVX)" : L"Single (Std)");
-
-        std::atomic<long long> totalIterations = 0;
-        auto startTime = std::chrono::high_resolution_clock::now();
+        const MandelKernelInfo& kernel = SelectMandelKernel();
+        std::wstring isa(kernel.name, kernel.name + strlen(kernel.name));
+        g_BenchMode = (multiCore ? L"Multi (" : L"Single (") + isa + L")";
 
         int threads = multiCore ? std::thread::hardware_concurrency() : 1;
-        int rowsPerThread = B_HEIGHT / threads;
-
-        std::vector<std::thread> pool;
-        for (int i = 0; i < threads; i++) {
-            int start = i * rowsPerThread;
-            int end = (i == threads - 1) ? B_HEIGHT : start + rowsPerThread;
-            if (useAVX) pool.emplace_back(BenchmarkWorkerAVX2, start, end, &totalIterations);
-            else pool.emplace_back(BenchmarkWorkerScalar, start, end, &totalIterations);
-        }
-
-        for (auto& t : pool) t.join();
+        auto readTemp = []() { int t = g_BoardStats.Load().cpuTemp; return t > 0 ? (float)t : -1.0f; };
+        BenchRecord record = RunMandelHarness(s_OverlayBench, kernel, threads, readTemp,
+            [](int done, int total) { g_BenchProgress = done * 100 / total; });
+        SaveBenchRecord(record);
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed = endTime - startTime;
-        double score = (totalIterations / elapsed.count()) / 100000.0;
-
-        g_BenchScore = (int)score;
+        g_BenchScore = (int)record.summary.median;
         g_BenchProgress = 100;
         g_BenchRunning = false;
         }).detach();
 }
 
-void CpuStressTask(int) {
-    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
-    float a = 1.1f, b = 2.2f;
-    while (g_CpuStress) { for (int i = 0; i < 1000; i++) a = a * b + 0.001f; }
-}
+static CpuStressEngine s_Stress;
+std::atomic<int> g_StressProfile = (int)StressProfile::FmaVirus;
+std::atomic<int> g_StressDuty = 100;
 
 void StartCpuStress() {
+    CpuStressConfig cfg;
+    cfg.profile = (StressProfile)g_StressProfile.load();
+    cfg.dutyPct = g_StressDuty;
+    s_Stress.Start(cfg);
     g_CpuStress = true;
-    for (int i = 0; i < std::thread::hardware_concurrency(); i++) std::thread(CpuStressTask, i).detach();
+}
+
+void StopCpuStress() {
+    s_Stress.Stop();
+    g_CpuStress = false;
+}
+
+void CycleStressProfile() {
+    g_StressProfile = (g_StressProfile + 1) % (int)StressProfile::Count;
+    if (g_CpuStress) StartCpuStress();     // Start() joins the old workers first
+}
+
+void AdjustStressDuty(int deltaPct) {
+    g_StressDuty = (std::min)((std::max)(g_StressDuty + deltaPct, 10), 100);
+    s_Stress.SetDuty(g_StressDuty);
 }
 
 int GetWmiTemp(IWbemServices* pSvc) {
@@ -158,48 +107,148 @@ int GetWmiTemp(IWbemServices* pSvc) {
     return 0;
 }
 
-void MonitorCpu() {
+// ---------------------------------------------------------
+//  PDH CPU PROVIDER
+//  Sensor 0 is _Total, sensors 1..N are the logical processors.
+//  Then, if the OS has the counters, cpu.mhz, cpu.mhz.base,
+//  cpu.throttled and cpu0..N.mhz. "% Processor Performance" is the
+//  kernel's APERF/MPERF ratio, taken on each core during its own
+//  tick, so it costs no MSR driver and wakes nothing; times the
+//  nominal "Processor Frequency" it is the effective clock.
+// ---------------------------------------------------------
+class PdhCpuProvider : public ISensorProvider {
+public:
+    ~PdhCpuProvider() { if (query) PdhCloseQuery(query); }
+    const char* Name() const override { return "pdh.cpu"; }
+    int SensorCount() const override { return (int)sensors.size(); }
+    const SensorDesc& Sensor(int i) const override { return sensors[i]; }
+    int PollCostUs() const override { return 50 + 10 * (int)counters.size(); }
+    int CoreCount() const { return coreCount; }
+    bool HasClocks() const { return clocks; }
+
+    bool Open() override {
+        if (PdhOpenQueryW(NULL, 0, &query) != ERROR_SUCCESS) return false;
+        SYSTEM_INFO sys; GetSystemInfo(&sys);
+        coreCount = (std::min)((int)sys.dwNumberOfProcessors, MAX_CORES);
+
+        counters.resize(coreCount + 1);
+        sensors.resize(coreCount + 1);
+        PdhAddEnglishCounterW(query, L"\\Processor(_Total)\\% Processor Time", 0, &counters[0]);
+        SetSensorName(sensors[0], "cpu.load");
+        for (int i = 0; i < coreCount; i++) {
+            std::wstring path = L"\\Processor(" + std::to_wstring(i) + L")\\% Processor Time";
+            PdhAddEnglishCounterW(query, path.c_str(), 0, &counters[i + 1]);
+            SetSensorName(sensors[i + 1], "cpu%d.load", i);
+            sensors[i + 1].detail = true;
+        }
+        for (auto& d : sensors) d.unit = SensorUnit::Percent;
+        OpenClocks();
+        PdhCollectQueryData(query); // Prime: rate counters need two samples
+        return true;
+    }
+
+    bool Poll(float* values) override {
+        if (PdhCollectQueryData(query) != ERROR_SUCCESS) return false;
+        for (int i = 0; i <= coreCount; i++) values[i] = Read(counters[i]);
+        if (!clocks) return true;
+
+        float base = Read(counters[coreCount + 1]);
+        float* mhz = values + coreCount + 4;
+        float sum = 0.0f;
+        int throttled = 0;
+        for (int i = 0; i < coreCount; i++) {
+            mhz[i] = base * Read(counters[coreCount + 2 + i]) / 100.0f;
+            sum += mhz[i];
+            if (IsCoreThrottled(values[i + 1], mhz[i], base)) throttled++;
+        }
+        values[coreCount + 1] = coreCount ? sum / coreCount : 0.0f;
+        values[coreCount + 2] = base;
+        values[coreCount + 3] = (float)throttled;
+        return true;
+    }
+
+private:
+    static float Read(PDH_HCOUNTER counter) {
+        PDH_FMT_COUNTERVALUE cv;
+        return (PdhGetFormattedCounterValue(counter, PDH_FMT_DOUBLE, NULL, &cv) == ERROR_SUCCESS) ? (float)cv.doubleValue : 0.0f;
+    }
+
+    // Processor Information instances are "group,index"; groups hold up to 64 processors.
+    // Past MAX_SENSORS / 4 processors a second per-core series would crowd the hub, so no clocks.
+    void OpenClocks() {
+        if (coreCount > MAX_SENSORS / 4) return;
+        std::vector<PDH_HCOUNTER> added(coreCount + 1);
+        bool ok = PdhAddEnglishCounterW(query, L"\\Processor Information(_Total)\\Processor Frequency", 0, &added[0]) == ERROR_SUCCESS;
+        for (int i = 0; ok && i < coreCount; i++) {
+            std::wstring path = L"\\Processor Information(" + std::to_wstring(i / 64) + L"," + std::to_wstring(i % 64) + L")\\% Processor Performance";
+            ok = PdhAddEnglishCounterW(query, path.c_str(), 0, &added[i + 1]) == ERROR_SUCCESS;
+        }
+        if (!ok) {
+            for (PDH_HCOUNTER c : added) if (c) PdhRemoveCounter(c);
+            return;
+        }
+        clocks = true;
+        counters.insert(counters.end(), added.begin(), added.end());
+        SensorDesc d; d.unit = SensorUnit::MHz;
+        SetSensorName(d, "cpu.mhz"); sensors.push_back(d);
+        SetSensorName(d, "cpu.mhz.base"); sensors.push_back(d);
+        d.unit = SensorUnit::Count;
+        SetSensorName(d, "cpu.throttled"); sensors.push_back(d);
+        d.unit = SensorUnit::MHz; d.detail = true;
+        for (int i = 0; i < coreCount; i++) { SetSensorName(d, "cpu%d.mhz", i); sensors.push_back(d); }
+    }
+
+    PDH_HQUERY query = NULL;
+    std::vector<PDH_HCOUNTER> counters;     // Loads, then Processor Frequency and the per-core performance
+    std::vector<SensorDesc> sensors;
+    int coreCount = 0;
+    bool clocks = false;
+};
+
+static PdhCpuProvider s_Pdh;
+static int s_PdhProvider = -1;
+
+void InitCpuMonitor() {
     HKEY hKey;
     if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, L"HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0", 0, KEY_READ, &hKey) == 0) {
         wchar_t buf[256]; DWORD sz = sizeof(buf);
         RegQueryValueExW(hKey, L"ProcessorNameString", NULL, NULL, (LPBYTE)buf, &sz);
+        std::lock_guard<std::mutex> l(g_StatsMutex);
         g_CpuName = buf;
         RegCloseKey(hKey);
     }
 
     // Simulate WMI Init manually or assume it's available via helper
     // For standalone simplicity, we assume GetWmiTemp is called with a local service if needed
+    s_PdhProvider = g_Sensors.Add(&s_Pdh);
+}
 
-    PDH_HQUERY q; PdhOpenQueryW(NULL, 0, &q);
-    PDH_HCOUNTER cTotal;
-    PdhAddEnglishCounterW(q, L"\\Processor(_Total)\\% Processor Time", 0, &cTotal);
-
-    SYSTEM_INFO sys; GetSystemInfo(&sys);
-    int coreCount = sys.dwNumberOfProcessors;
-    std::vector<PDH_HCOUNTER> cCores(coreCount);
-
-    for (int i = 0; i < coreCount; i++) {
-        std::wstring path = L"\\Processor(" + std::to_wstring(i) + L")\\% Processor Time";
-        PdhAddEnglishCounterW(q, path.c_str(), 0, &cCores[i]);
+PollResult PollCpu() {
+    static CpuStats stats;
+    float values[2 * MAX_CORES + 4];
+    if (s_PdhProvider < 0 || !g_Sensors.Poll(s_PdhProvider, values)) return PollResult::Stable;
+
+    int prevUsage = stats.usage;
+    int prevThrottled = stats.throttledCores;
+    int maxCoreDelta = 0;
+    stats.coreCount = s_Pdh.CoreCount();
+    stats.usage = (int)values[0];
+    for (int i = 0; i < stats.coreCount; i++) {
+        int load = (int)values[i + 1];
+        maxCoreDelta = (std::max)(maxCoreDelta, abs(load - stats.coreLoad[i]));
+        stats.coreLoad[i] = load;
     }
-    PdhCollectQueryData(q);
-    while (g_AppRunning) {
-        PdhCollectQueryData(q);
-        PDH_FMT_COUNTERVALUE cv;
-        PdhGetFormattedCounterValue(cTotal, PDH_FMT_LONG, NULL, &cv);
-        int total = (int)cv.longValue;
-        std::vector<int> loads;
-        for (int i = 0; i < coreCount; i++) {
-            PdhGetFormattedCounterValue(cCores[i], PDH_FMT_LONG, NULL, &cv);
-            loads.push_back((int)cv.longValue);
-        }
-        // int temp = GetWmiTemp(...); // Optional fallback
-        {
-            std::lock_guard<std::mutex> l(g_StatsMutex);
-            g_CpuUsage = total;
-            g_CoreLoad = loads;
-            // g_CpuTemp is updated by system.cpp via hardware poll
-        }
-        Sleep(500);
+    if (s_Pdh.HasClocks()) {
+        const float* clocks = values + stats.coreCount + 1;
+        stats.avgMhz = (int)clocks[0];
+        stats.baseMhz = (int)clocks[1];
+        stats.throttledCores = (int)clocks[2];
+        for (int i = 0; i < stats.coreCount; i++) stats.coreMhz[i] = (int)clocks[3 + i];
     }
-}
\ No newline at end of file
+    // int temp = GetWmiTemp(...); // Optional fallback
+    // CPU temp is published with BoardStats by system.cpp via hardware poll
+    g_CpuStats.Store(stats);
+
+    if (stats.usage >= 95) return PollResult::Urgent;
+    return (abs(stats.usage - prevUsage) >= 5 || maxCoreDelta >= 20 || stats.throttledCores != prevThrottled) ? PollResult::Changed : PollResult::Stable;
+}
@@ -1,7 +1,7 @@
 #include "shared.hpp"
 #include <gl/GL.h>
 #include <chrono>
-#include <dxgi.h>
+#include <dxgi1_4.h>
 
 #pragma comment(lib, "opengl32.lib")
 #pragma comment(lib, "dxgi.lib")
@@ -11,36 +11,85 @@ std::wstring g_GpuName = L"GPU";
 std::atomic<int> g_GpuScore = 0;
 std::atomic<bool> g_GpuBenchRunning = false;
 
-unsigned long long g_GpuVramUsed = 0;
-unsigned long long g_GpuVramTotal = 0;
+SeqLock<GpuStats> g_GpuStats;
 
 void InitGpuInfo() {
-    WmiQuery wmi; wmi.Init();
-    IEnumWbemClassObject* pEnum = wmi.Exec(L"SELECT Name FROM Win32_VideoController");
-    if (pEnum) {
-        IWbemClassObject* pObj = NULL; ULONG uRet = 0;
-        pEnum->Next(WBEM_INFINITE, 1, &pObj, &uRet);
-        if (uRet) {
-            VARIANT v; pObj->Get(L"Name", 0, &v, 0, 0);
-            if (v.vt == VT_BSTR) { std::lock_guard<std::mutex> l(g_StatsMutex); g_GpuName = v.bstrVal; }
-            VariantClear(&v); pObj->Release();
-        }
-        pEnum->Release();
-    }
+    std::wstring name = GetWmiReader().GpuName();
+    if (!name.empty()) { std::lock_guard<std::mutex> l(g_StatsMutex); g_GpuName = name; }
 }
 
-void UpdateGpuVram() {
-    IDXGIFactory* f = NULL; CreateDXGIFactory(__uuidof(IDXGIFactory), (void**)&f);
-    if (f) {
-        IDXGIAdapter* a = NULL;
-        if (f->EnumAdapters(0, &a) != DXGI_ERROR_NOT_FOUND) {
-            DXGI_ADAPTER_DESC d; a->GetDesc(&d);
-            std::lock_guard<std::mutex> l(g_StatsMutex);
-            g_GpuVramTotal = d.DedicatedVideoMemory;
+// ---------------------------------------------------------
+//  DXGI BACKEND
+//  Factory and IDXGIAdapter3 pointers live for the whole session;
+//  usage comes from QueryVideoMemoryInfo on the local segment group.
+// ---------------------------------------------------------
+class DxgiGpuBackend : public IGpuBackend {
+public:
+    ~DxgiGpuBackend() { ReleaseAll(); }
+
+    int EnumerateAdapters(GpuAdapterInfo* out, int max) override {
+        ReleaseAll();
+        if (FAILED(CreateDXGIFactory1(__uuidof(IDXGIFactory1), (void**)&factory))) return 0;
+
+        IDXGIAdapter1* a = NULL;
+        for (UINT i = 0; count < max && factory->EnumAdapters1(i, &a) != DXGI_ERROR_NOT_FOUND; i++) {
+            DXGI_ADAPTER_DESC1 d; a->GetDesc1(&d);
+            IDXGIAdapter3* a3 = NULL;
+            if (!(d.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) && SUCCEEDED(a->QueryInterface(__uuidof(IDXGIAdapter3), (void**)&a3))) {
+                adapters[count] = a3;
+                wcsncpy_s(out[count].name, d.Description, _TRUNCATE);
+                out[count].dedicatedBytes = d.DedicatedVideoMemory;
+                count++;
+            }
             a->Release();
         }
-        f->Release();
+        return count;
+    }
+
+    bool NeedsRefresh() override { return !factory || !factory->IsCurrent(); }
+
+    bool QueryMemory(int adapter, GpuMemoryUsage& out) override {
+        if (adapter >= count || !adapters[adapter]) return false;
+        DXGI_QUERY_VIDEO_MEMORY_INFO info;
+        if (FAILED(adapters[adapter]->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info))) return false;
+        out.usedBytes = info.CurrentUsage;
+        out.budgetBytes = info.Budget;
+        return true;
+    }
+
+private:
+    void ReleaseAll() {
+        for (int i = 0; i < count; i++) if (adapters[i]) adapters[i]->Release();
+        count = 0;
+        if (factory) { factory->Release(); factory = NULL; }
+    }
+
+    IDXGIFactory1* factory = NULL;
+    IDXGIAdapter3* adapters[MAX_GPUS] = {};
+    int count = 0;
+};
+
+PollResult UpdateGpuVram() {
+    static DxgiGpuBackend dxgi;
+    static GpuMonitor monitor(dxgi);
+    PollResult result = monitor.Poll();
+
+    GpuStats stats;
+    stats.adapterCount = monitor.AdapterCount();
+    for (int i = 0; i < stats.adapterCount; i++) {
+        const GpuAdapterState& a = monitor.Adapter(i);
+        GpuAdapterStats& out = stats.adapters[i];
+        wcsncpy_s(out.name, a.info.name, _TRUNCATE);
+        out.vramUsed = a.usage.usedBytes;
+        out.vramTotal = a.info.dedicatedBytes ? a.info.dedicatedBytes : a.usage.budgetBytes;
+        out.vramBudget = a.usage.budgetBytes;
+    }
+    if (stats.adapterCount > 0) {
+        stats.vramUsed = stats.adapters[0].vramUsed;
+        stats.vramTotal = stats.adapters[0].vramTotal;
     }
+    g_GpuStats.Store(stats);
+    return result;
 }
 
 HWND CreateHiddenGLWindow(HDC& hDC, HGLRC& hRC) {
@@ -59,20 +108,21 @@ void GpuBenchWorker() {
     HDC hDC; HGLRC hRC; HWND hWnd = CreateHiddenGLWindow(hDC, hRC);
 
     glDisable(GL_DEPTH_TEST); glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    auto start = std::chrono::high_resolution_clock::now();
-    int frames = 0;
-    while (true) {
-        auto now = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> el = now - start;
-        if (el.count() > 5.0) break;
-        g_BenchProgress = (int)(el.count() / 5.0 * 100.0);
-
-        glClear(GL_COLOR_BUFFER_BIT);
-        glBegin(GL_QUADS); glColor4f(0.01f, 0.01f, 0.01f, 0.01f);
-        for (int i = 0; i < 1000; i++) { glVertex2f(-1, -1); glVertex2f(1, -1); glVertex2f(1, 1); glVertex2f(-1, 1); }
-        glEnd(); SwapBuffers(hDC); frames++;
-    }
-    g_GpuScore = frames; g_BenchProgress = 100; g_GpuBenchRunning = false;
+    // One-second passes: the first warms clocks and the driver, the median of the rest is the score
+    BenchHarnessConfig cfg = { 1, 5, 3.5 };
+    BenchSummary summary = RunRepeated(cfg, [hDC]() {
+        auto start = std::chrono::steady_clock::now();
+        int frames = 0;
+        while (std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            glBegin(GL_QUADS); glColor4f(0.01f, 0.01f, 0.01f, 0.01f);
+            for (int i = 0; i < 1000; i++) { glVertex2f(-1, -1); glVertex2f(1, -1); glVertex2f(1, 1); glVertex2f(-1, 1); }
+            glEnd(); SwapBuffers(hDC); frames++;
+        }
+        return (double)frames;
+    }, [](int done, int total) { g_BenchProgress = done * 100 / total; });
+    // Frames per five seconds, the scale the score has always had
+    g_GpuScore = (int)(summary.median * 5.0 + 0.5); g_BenchProgress = 100; g_GpuBenchRunning = false;
     wglMakeCurrent(NULL, NULL); wglDeleteContext(hRC); ReleaseDC(hWnd, hDC); DestroyWindow(hWnd);
 }
 
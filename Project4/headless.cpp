@@ -0,0 +1,720 @@
+// Headless collector for Linux nodes: same sensor table as the overlay,
+// no window. Providers are polled by the PollScheduler at their own
+// adaptive rates; the latest values are printed as one CSV row per tick,
+// or appended to a binary telemetry log with --log. --render draws the
+// overlay for the last sample with the software canvas (.ppm or .png),
+// and --render-bench times full and incremental frames. --bench runs the
+// CPU benchmark under the harness and exits 3 on a baseline regression,
+// 4 if passes disagreed on the work done, 7 if the baseline ran another
+// benchmark, kernel or thread count. --membench does the same for
+// memory bandwidth and latency, with triad as the compared median.
+// --memtest pattern-tests a share of free memory and exits 5 on any error.
+// --stress runs a CPU load profile for a soak, printing the work rate, CPU
+// temperature, mean clock and throttled core count once a second.
+// --fan-sim runs the fan controller against a simulated NCT6687D with a
+// thermal model (idle, a CPU BURN spike, idle again) in simulated time.
+// --sio-bench detects and sweeps every simulated Super I/O chip, checks the
+// readings, and exits 6 if a sweep needs more than --max-sweep-ops. The
+// simulator lays out its registers from the same maps, so this checks the
+// sweep and the decoding, not that a map matches the silicon; only
+// --sio-replay of a dump from a real board does that.
+// --sio-dump records the board's chip registers through /dev/port, and
+// --sio-replay decodes such a dump on any machine. --trace records every
+// port op of --fan-sim or --sio-dump; --sio-replay on that trace feeds it
+// back through detection and the sweep, printing each sweep's readings,
+// then times whole passes over it (at least --sweeps sweeps).
+// --export also publishes every tick to shared memory (TelemetryShm.h);
+// --read-export prints what another collector publishes, through the
+// header-only reader.
+//   headless [--interval ms] [--count n] [--stats] [--log file.tlog] [--export] [--render file] [--render-bench frames]
+//   headless --read-export [--interval ms] [--count n]       (--shm-name name overrides the mapping's name)
+//   headless --bench [--threads n] [--kernel name] [--warmup n] [--reps n] [--json out.json]
+//            [--baseline base.json] [--threshold pct]
+//   headless --membench [--threads n] [--mem-mib n] [--warmup n] [--reps n] [--json out.json] [--baseline base.json] [--threshold pct]
+//   headless --memtest [--mem-pct n] [--mem-mib n] [--passes n] [--threads n] [--seed n]
+//   headless --stress fma|integer|cache|mixed [--duty pct] [--seconds n] [--threads n]
+//   headless --fan-sim [--seconds n] [--trace out.ptrace] [--fan "n:sensor=nct.cpu_temp curve=40:25,80:100 hyst=3 up=15 down=5"]...
+//   headless --sio-bench [--chip NCT6687D|0xD592] [--latency-ns n] [--sweeps n] [--max-sweep-ops n]
+//   headless [--trace out.ptrace] --sio-dump file.txt | --sio-replay file.txt|file.ptrace [--sweeps n]
+//   headless --to-csv file.tlog
+// Build: make (Makefile; make check also runs tests/), or by hand:
+//        g++ -std=c++20 -O2 headless.cpp LinuxSensors.cpp SensorHub.cpp PollScheduler.cpp TelemetryLog.cpp MappedFile.cpp
+//        OverlayLayout.cpp UiTree.cpp UiCanvas.cpp SoftCanvas.cpp GlyphAtlas.cpp TextLayout.cpp
+//        BenchHarness.cpp MandelBench.cpp MandelKernels.cpp MemBench.cpp MemTest.cpp CpuStress.cpp
+//        FanControl.cpp Nct6687.cpp SuperIo.cpp SimSuperIo.cpp PortTrace.cpp TelemetryExport.cpp -lpthread
+#ifdef __linux__
+#include "BenchHarness.hpp"
+#include "ChipDefs.hpp"
+#include "CpuStress.hpp"
+#include "FanControl.hpp"
+#include "LinuxSensors.hpp"
+#include "MemBench.hpp"
+#include "MemTest.hpp"
+#include "Nct6687.hpp"
+#include "OverlayLayout.hpp"
+#include "PollScheduler.hpp"
+#include "PortTrace.hpp"
+#include "SimSuperIo.hpp"
+#include "SuperIo.hpp"
+#include "SoftCanvas.hpp"
+#include "TelemetryExport.hpp"
+#include "TelemetryLog.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+// Maps the Linux sensor names onto the overlay's snapshot; sections with no source stay hidden
+static void FillSnapshot(const SensorHub& hub, StatsSnapshot& s, OverlayState& st) {
+    for (int i = 0; i < hub.SensorCount(); i++) {
+        const SensorDesc& d = hub.Sensor(i);
+        int v = (int)(hub.Value(i) + 0.5f);
+        int core = -1;
+        if (strcmp(d.name, "cpu.load") == 0) s.cpu.usage = v;
+        else if (sscanf(d.name, "cpu%d.load", &core) == 1 && core >= 0 && core < MAX_CORES) {
+            s.cpu.coreLoad[core] = v;
+            s.cpu.coreCount = (std::max)(s.cpu.coreCount, core + 1);
+        }
+        else if (sscanf(d.name, "cpu%d.mhz", &core) == 1 && core >= 0 && core < MAX_CORES) s.cpu.coreMhz[core] = v;
+        else if (strcmp(d.name, "cpu.mhz") == 0) s.cpu.avgMhz = v;
+        else if (strcmp(d.name, "cpu.mhz.base") == 0) s.cpu.baseMhz = v;
+        else if (strcmp(d.name, "cpu.throttled") == 0) s.cpu.throttledCores = v;
+        else if (strcmp(d.name, "mem.load") == 0) s.mem.load = v;
+        else if (d.unit == SensorUnit::Celsius && s.board.cpuTemp == 0) s.board.cpuTemp = v;
+    }
+    st.cpuName = L"CPU";
+    st.showGpu = false;
+    st.showDrives = false;
+    st.showBattery = false;
+}
+
+static int RenderOverlay(const SensorHub& hub, const char* path, int benchFrames) {
+    StatsSnapshot snapshot;
+    OverlayState state;
+    FillSnapshot(hub, snapshot, state);
+    UiFrame frames[2];
+    BuildOverlay(state, snapshot, UI_WIDTH_NORMAL, 850, frames[0]);
+    SoftCanvas canvas(UI_WIDTH_NORMAL, 850);
+    UiRect whole = { 0, 0, canvas.Width(), canvas.Height() };
+
+    using Clock = std::chrono::steady_clock;
+    auto micros = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+    if (benchFrames > 0) {
+        Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < benchFrames; i++) PaintUiFrame(canvas, frames[0], &whole, 1);
+        double full = micros(Clock::now() - t0) / benchFrames;
+
+        // A ticking CPU figure: rebuild, diff and repaint only what moved
+        UiRect dirty[UI_MAX_DIRTY];
+        int current = 0, rects = 0;
+        double area = 0;
+        t0 = Clock::now();
+        for (int i = 0; i < benchFrames; i++) {
+            snapshot.cpu.usage = i % 101;
+            BuildOverlay(state, snapshot, UI_WIDTH_NORMAL, 850, frames[current ^ 1]);
+            int n = DiffUiFrames(frames[current], frames[current ^ 1], dirty, UI_MAX_DIRTY, &canvas.Text());
+            current ^= 1;
+            PaintUiFrame(canvas, frames[current], dirty, n);
+            rects += n;
+            for (int r = 0; r < n; r++) area += (double)dirty[r].w * dirty[r].h;
+        }
+        double incremental = micros(Clock::now() - t0) / benchFrames;
+        fprintf(stderr, "render: full %.1f us/frame, incremental %.1f us/frame (%.1f dirty rects, %d px)\n", full, incremental, rects / (double)benchFrames, (int)(area / benchFrames));
+        fprintf(stderr, "text layouts: %zu cached, %llu hits, %llu misses\n", canvas.Text().Size(), (unsigned long long)canvas.Text().Hits(), (unsigned long long)canvas.Text().Misses());
+        BuildOverlay(state, snapshot, UI_WIDTH_NORMAL, 850, frames[0]);
+    }
+
+    if (!path) return 0;
+    PaintUiFrame(canvas, frames[0], &whole, 1);
+    size_t len = strlen(path);
+    bool ppm = len > 4 && strcmp(path + len - 4, ".ppm") == 0;
+    if (!(ppm ? canvas.WritePpm(path) : canvas.WritePng(path))) { fprintf(stderr, "cannot write %s\n", path); return 1; }
+    return 0;
+}
+
+struct BenchOptions {
+    BenchHarnessConfig harness;
+    int threads = 0;                // 0 = every hardware thread
+    const char* kernel = nullptr;
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    double thresholdPct = 5.0;
+    bool memory = false;            // --membench
+    size_t memBytes = 0;            // 0 = MemBenchConfig default
+};
+
+// Prefers the CPU package sensor of the common drivers, else the first temperature found
+static float ReadCpuTemp(SensorHub& hub, int hwmon) {
+    if (hwmon < 0 || !hub.Poll(hwmon)) return -1.0f;
+    static const char* preferred[] = { "k10temp.", "coretemp.", "zenpower.", "cpu_thermal." };
+    int first = hub.FirstSensor(hwmon), count = hub.Provider(hwmon)->SensorCount(), pick = -1;
+    for (const char* prefix : preferred) {
+        for (int i = first; i < first + count && pick < 0; i++) {
+            if (hub.Sensor(i).unit == SensorUnit::Celsius && strncmp(hub.Sensor(i).name, prefix, strlen(prefix)) == 0) pick = i;
+        }
+    }
+    for (int i = first; i < first + count && pick < 0; i++) {
+        if (hub.Sensor(i).unit == SensorUnit::Celsius) pick = i;
+    }
+    return pick < 0 ? -1.0f : hub.Value(pick);
+}
+
+static int RunBench(const BenchOptions& opt) {
+    const MandelKernelInfo* kernel = opt.kernel ? FindMandelKernel(opt.kernel) : &SelectMandelKernel();
+    if (!kernel) { fprintf(stderr, "kernel %s is unknown or unsupported on this CPU\n", opt.kernel); return 2; }
+    int threads = opt.threads > 0 ? opt.threads : (int)std::thread::hardware_concurrency();
+
+    SensorHub hub;
+    static HwmonProvider hwmon;
+    int hwmonId = hub.Add(&hwmon);
+    auto readTemp = [&]() { return ReadCpuTemp(hub, hwmonId); };
+    auto progress = [](int done, int total) { fprintf(stderr, "\rpass %d/%d", done, total); if (done == total) fprintf(stderr, "\n"); };
+    BenchRecord r;
+    if (opt.memory) {
+        MemBenchConfig cfg;
+        cfg.harness = opt.harness;
+        cfg.threads = opt.threads;
+        if (opt.memBytes) cfg.streamBytes = opt.memBytes;
+        r.tempBefore = readTemp();
+        MemBenchResult mem = RunMemBenchmark(cfg, progress);
+        r.tempAfter = readTemp();
+        MemBenchToRecord(cfg, mem, r);
+        fprintf(stderr, "copy %.1f  scale %.1f  add %.1f  triad %.1f GB/s; latency %.1f ns at %zu MiB\n",
+            mem.stream[0].median, mem.stream[1].median, mem.stream[2].median, mem.stream[3].median,
+            mem.latency.empty() ? 0.0 : mem.latency.back().ns, mem.latency.empty() ? 0 : mem.latency.back().bytes >> 20);
+    }
+    else r = RunMandelHarness(opt.harness, *kernel, threads, readTemp, progress);
+    r.cpuName = LinuxCpuModel();
+
+    const BenchSummary& s = r.summary;
+    fprintf(stderr, "%s %s x%d: median %.1f  MAD %.2f  95%% CI [%.1f, %.1f]  kept %d/%zu\n",
+        r.benchmark.c_str(), r.kernel.c_str(), r.threads, s.median, s.mad, s.ciLow, s.ciHigh, s.kept, s.samples.size());
+    std::string json = BenchRecordToJson(r);
+    if (opt.jsonPath) {
+        std::ofstream out(opt.jsonPath);
+        if (!(out << json)) { fprintf(stderr, "cannot write %s\n", opt.jsonPath); return 1; }
+    }
+    else fputs(json.c_str(), stdout);
+
+    if (!r.workConsistent) { fprintf(stderr, "passes computed different iteration counts\n"); return 4; }
+    if (!opt.baselinePath) return 0;
+    std::ifstream in(opt.baselinePath);
+    std::stringstream text;
+    text << in.rdbuf();
+    BenchBaseline base;
+    if (!in || !ParseBenchBaseline(text.str(), base)) { fprintf(stderr, "cannot read baseline %s\n", opt.baselinePath); return 1; }
+    BenchComparison c = CompareToBaseline(r, base, opt.thresholdPct);
+    if (!c.comparable) {
+        fprintf(stderr, "baseline ran %s %s x%d, not comparable with %s %s x%d\n", base.benchmark.c_str(), base.kernel.c_str(), base.threads,
+            r.benchmark.c_str(), r.kernel.c_str(), r.threads);
+        return 7;
+    }
+    fprintf(stderr, "baseline %.1f -> %.1f (%+.1f%%, threshold -%.1f%%): %s\n", base.median, s.median, c.changePct, opt.thresholdPct,
+        c.regressed ? "REGRESSION" : "ok");
+    return c.regressed ? 3 : 0;
+}
+
+static int RunStress(const CpuStressConfig& cfg, int seconds) {
+    SensorHub hub;
+    static HwmonProvider hwmon;
+    int hwmonId = hub.Add(&hwmon);
+    static CpuClockProvider cpuClock;
+    int clockId = hub.Add(&cpuClock);
+    float clocks[MAX_SENSORS] = {};
+    CpuStressEngine engine;
+    engine.Start(cfg);
+    fprintf(stderr, "%s (fma on %s), duty %d%%, %d s\n", StressProfileName(cfg.profile), engine.FmaIsa(), engine.Duty(), seconds);
+    if (clockId < 0) fprintf(stderr, "no clock source (needs /dev/cpu/*/msr or cpufreq)\n");
+    printf("time,work_per_s,cpu_temp_c,cpu_mhz,throttled_cores\n");
+    uint64_t last = 0;
+    for (int t = 1; t <= seconds; t++) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        uint64_t work = engine.Work();
+        if (clockId >= 0) hub.Poll(clockId, clocks);   // cpu.mhz, cpu.mhz.base, cpu.throttled first
+        printf("%d,%.4g,%.1f,%.0f,%.0f\n", t, (double)(work - last), ReadCpuTemp(hub, hwmonId), clocks[0], clocks[2]);
+        fflush(stdout);
+        last = work;
+    }
+    engine.Stop();
+    return 0;
+}
+
+// The overlay's controller, detection and EC writes over the simulated chip. Time is
+// simulated too (0.25 s steps, no settle waits), so a long soak runs in milliseconds.
+static int RunFanSim(int seconds, const std::vector<std::pair<int, FanChannelConfig>>& channels, const char* tracePath) {
+    auto sim = std::make_unique<SimSuperIo>(*FindSioChip(CHIP_NCT6687D_R));
+    SimThermalModel thermal;
+    thermal.Reset(*sim);
+    TracingPortIo tracer(*sim);
+    if (tracePath && !tracer.Open(tracePath)) { fprintf(stderr, "cannot write %s\n", tracePath); return 1; }
+    IPortIo* io = &tracer;
+    std::mutex ioMutex;
+    SioDetectResult chip;
+    if (!DetectSuperIo(*io, chip)) { fprintf(stderr, "simulated chip not detected\n"); return 1; }
+    int baseAddr = chip.baseAddr;
+
+    SensorHub hub;
+    SuperIoProvider sio(io, ioMutex, chip.chip, baseAddr);
+    int sioId = hub.Add(&sio);
+    Nct6687FanWriter writer(io, ioMutex, baseAddr, 0);
+    FanController fans;
+    fans.Attach(hub, writer);
+    fans.SetAutoAll();
+    for (const auto& c : channels) fans.SetChannel(c.first, c.second);
+
+    const float dt = 0.25f;
+    int steps = (int)(seconds / dt);
+    float peak = 0.0f;
+    int reversals = 0, lastDir = 0, lastPwm = -1;
+    printf("time,cpu_w,cpu_temp_c,vrm_temp_c,fan0_pct,fan0_pwm,fan0_rpm,fan1_pct,batches\n");
+    for (int step = 1; step <= steps; step++) {
+        float t = step * dt;
+        float watts = (t >= seconds * 0.15f && t < seconds * 0.6f) ? 180.0f : 40.0f;
+        thermal.Advance(*sim, watts, dt);
+        hub.Poll(sioId);
+        fans.Tick(dt);
+
+        peak = (std::max)(peak, thermal.cpuTempC);
+        int pwm = sim->Pwm(0);
+        if (lastPwm >= 0 && pwm != lastPwm) {
+            int dir = pwm > lastPwm ? 1 : -1;
+            if (lastDir && dir != lastDir) reversals++;
+            lastDir = dir;
+        }
+        lastPwm = pwm;
+        if (step % (int)(1.0f / dt) == 0) {
+            printf("%.0f,%.0f,%.1f,%.1f,%d,%d,%d,%d,%llu\n", t, watts, thermal.cpuTempC, thermal.vrmTempC,
+                fans.OutputPct(0), pwm, thermal.FanRpm(0), fans.OutputPct(1), (unsigned long long)fans.Batches());
+        }
+    }
+    fprintf(stderr, "peak cpu %.1f C; %llu write batches over %d ticks, %llu channel writes, %llu EC commits, %llu duty register writes; fan0 reversed %d times\n",
+        peak, (unsigned long long)fans.Batches(), steps, (unsigned long long)fans.ChannelWrites(), (unsigned long long)sim->PwmCommits(),
+        (unsigned long long)sim->PwmWrites(), reversals);
+    tracer.Close();
+    if (tracePath) fprintf(stderr, "%llu port ops -> %s, %llu bytes\n", (unsigned long long)tracer.Ops(), tracePath, (unsigned long long)tracer.BytesWritten());
+    return 0;
+}
+
+// Where each database input sits on the simulator's channels
+static const struct { SimSensorKind kind; int channel; } SIM_INPUTS[SIO_SENSOR_COUNT] = {
+    { SimSensorKind::Temp, 0 }, { SimSensorKind::Temp, 1 }, { SimSensorKind::Temp, 2 }, { SimSensorKind::Temp, 3 }, { SimSensorKind::Temp, 4 },
+    { SimSensorKind::Volt, 0 }, { SimSensorKind::Volt, 1 }, { SimSensorKind::Volt, 2 }, { SimSensorKind::Volt, 4 }, { SimSensorKind::Volt, 6 },
+    { SimSensorKind::Fan, 0 }, { SimSensorKind::Fan, 1 }, { SimSensorKind::Fan, 2 },
+};
+
+// Detection and the compiled sweep against every simulated chip (or one), counting port
+// ops and timing them at 'latencyNs' per op. CPU temperature, Vcore and the CPU fan follow
+// waveforms, and every reading is checked against what the chip was measuring. Detect-only
+// chips are only probed. Exits 1 on a wrong reading or a chip not found, 6 when a sweep
+// takes more than 'maxSweepOps'.
+static int RunSioBench(const char* chipName, int latencyNs, int sweeps, int maxSweepOps) {
+    const SioChip* only = chipName ? FindSioChip(chipName) : nullptr;
+    if (chipName && !only) { fprintf(stderr, "unknown chip %s\n", chipName); return 2; }
+    sweeps = (std::max)(sweeps, 1);
+    int wrong = 0, missed = 0, overBudget = 0;
+    printf("chip,id,family,probe_ops,probe_us,sensors,sweep_ops,sweep_us,est_us\n");
+    for (int c = 0; c < SioChipCount(); c++) {
+        const SioChip& info = SioChipAt(c);
+        if (only && &info != only) continue;
+        auto sim = std::make_unique<SimSuperIo>(info, info.family == SioFamily::Ite ? 0x2E : 0x4E, info.family == SioFamily::NuvotonEc ? 0xA20 : 0x290);
+        sim->SetLatencyNs(latencyNs);
+        sim->Script(SimSensorKind::Temp, 0, { SimWaveform::Sine, 55.0f, 15.0f, 10.0f });
+        sim->Script(SimSensorKind::Volt, 2, { SimWaveform::Ramp, 1.2f, 0.15f, 7.0f });
+        sim->Script(SimSensorKind::Fan, 0, { SimWaveform::Square, 1400.0f, 400.0f, 4.0f });
+
+        SioDetectResult found;
+        double start = MonotonicSeconds();
+        bool detected = DetectSuperIo(*sim, found) && found.chip == &info;
+        double probeUs = (MonotonicSeconds() - start) * 1e6;
+        unsigned long long probeOps = sim->Reads() + sim->Writes();
+        printf("%s,0x%04X,%s,%llu,%.1f", info.name, info.id, SioFamilyName(info.family), probeOps, probeUs);
+
+        IPortIo* io = sim.get();
+        std::mutex ioMutex;
+        const SioChip* chip = found.chip;
+        int baseAddr = found.baseAddr;
+        SuperIoProvider provider(io, ioMutex, chip, baseAddr);
+        if (detected && info.detectOnly) { printf(",detect-only,,,\n"); continue; }
+        if (!detected || !provider.Open()) { printf(",,,,\n"); missed++; continue; }
+        const SioRegisterMap& map = SioMap(info.family);
+        float values[SIO_SENSOR_COUNT] = {};
+        double busy = 0.0;
+        sim->ResetCounters();
+        for (int s = 0; s < sweeps; s++) {
+            sim->SetTime(s * 0.37);
+            start = MonotonicSeconds();
+            provider.Poll(values);
+            busy += MonotonicSeconds() - start;
+            for (int r = 0; r < SIO_SENSOR_COUNT; r++) {
+                int slot = provider.Slot((SioSensor)r);
+                if (slot < 0) continue;
+                float truth = sim->Value(SIM_INPUTS[r].kind, SIM_INPUTS[r].channel);
+                float tolerance = 0.51f;
+                if (SIM_INPUTS[r].kind == SimSensorKind::Volt) { truth *= map.sensors[r].multiplier; tolerance = info.voltLsbMv * 0.001f * map.sensors[r].multiplier; }
+                if (SIM_INPUTS[r].kind == SimSensorKind::Fan) tolerance = 1.0f + truth * 0.02f;
+                if (std::fabs(values[slot] - truth) > tolerance) {
+                    if (wrong++ < 10) fprintf(stderr, "%s %s: read %.3f, chip measured %.3f\n", info.name, provider.Sensor(slot).name, values[slot], truth);
+                }
+            }
+        }
+        unsigned long long ops = (sim->Reads() + sim->Writes()) / sweeps;
+        if (maxSweepOps > 0 && ops > (unsigned long long)maxSweepOps) overBudget++;
+        printf(",%d,%llu,%.1f,%d\n", provider.SensorCount(), ops, busy * 1e6 / sweeps, provider.PollCostUs());
+    }
+    if (missed) fprintf(stderr, "%d chips not detected\n", missed);
+    if (wrong) fprintf(stderr, "%d readings outside the chip's resolution\n", wrong);
+    if (overBudget) fprintf(stderr, "%d chips over the %d-op sweep budget\n", overBudget, maxSweepOps);
+    return (wrong || missed) ? 1 : overBudget ? 6 : 0;
+}
+
+// Feeds a port trace back through detection and the compiled sweep: the bytes the board
+// returned, decoded by this build. One row per sweep at its capture time, then whole passes
+// are timed until 'benchSweeps' sweeps have run, so decode changes can be compared on
+// identical input. Exits 1 if nothing could be replayed.
+static int RunTraceReplay(const char* path, const PortTraceHeader& header, const std::vector<PortTraceOp>& ops, int benchSweeps) {
+    ReplayPortIo replay(ops);
+    IPortIo* io = &replay;
+    std::mutex ioMutex;
+    const SioChip* chip = nullptr;
+    int baseAddr = 0;
+    // Returns the sweeps replayed from the top of the trace; 'rows' gets the readings
+    auto pass = [&](SuperIoProvider* provider, std::vector<float>* rows, std::vector<double>* times) {
+        replay.Rewind();
+        SioDetectResult found;
+        if (header.chipId) { chip = MatchSioChip(header.chipId); baseAddr = header.baseAddr; }
+        else if (DetectSuperIo(replay, found)) { chip = found.chip; baseAddr = found.baseAddr; }
+        if (!chip || !provider) return 0;
+        float values[SIO_SENSOR_COUNT];
+        int sweeps = 0;
+        while (!replay.AtEnd()) {
+            uint64_t unmatched = replay.Unmatched();
+            provider->Poll(values);
+            if (replay.Unmatched() != unmatched) break;     // The trace ran out, or this build reads something else
+            sweeps++;
+            if (rows) { rows->insert(rows->end(), values, values + provider->SensorCount()); times->push_back(replay.TimeNs() * 1e-9); }
+        }
+        return sweeps;
+    };
+
+    SuperIoProvider provider(io, ioMutex, chip, baseAddr);
+    pass(nullptr, nullptr, nullptr);
+    if (!chip) { fprintf(stderr, "%s: no supported chip in the trace\n", path); return 1; }
+    if (chip->detectOnly) { fprintf(stderr, "%s: %s is detect-only, no register map to decode with\n", path, chip->name); return 1; }
+    if (!provider.Open()) return 1;
+    std::vector<float> rows;
+    std::vector<double> times;
+    int sweeps = pass(&provider, &rows, &times);
+    size_t stoppedAt = replay.Position();
+    uint64_t skipped = replay.Skipped();
+
+    int n = provider.SensorCount();
+    printf("time_s");
+    for (int i = 0; i < n; i++) printf(",%s", provider.Sensor(i).name);
+    printf("\n");
+    for (int s = 0; s < sweeps; s++) {
+        printf("%.3f", times[s]);
+        for (int i = 0; i < n; i++) printf(",%.3f", rows[(size_t)s * n + i]);
+        printf("\n");
+    }
+    fprintf(stderr, "%s (%s) at 0x%03X: %d sweeps over %zu of %zu ops, %llu ops of other traffic skipped\n", chip->name,
+        SioFamilyName(chip->family), baseAddr, sweeps, stoppedAt, ops.size(), (unsigned long long)skipped);
+    if (!sweeps) return 1;
+
+    int passes = (std::max)(1, (benchSweeps + sweeps - 1) / sweeps);
+    double start = MonotonicSeconds();
+    for (int p = 0; p < passes; p++) pass(&provider, nullptr, nullptr);
+    double elapsed = MonotonicSeconds() - start;
+    fprintf(stderr, "%d passes, %.0f ns per sweep replayed\n", passes, elapsed * 1e9 / ((double)passes * sweeps));
+    return 0;
+}
+
+// Decodes a recorded register dump through the simulator: detection, the compiled sweep
+// and the database's formats, exactly as on the board the dump came from
+static int RunSioReplay(const char* path, int benchSweeps) {
+    PortTraceHeader header;
+    std::vector<PortTraceOp> ops;
+    if (ReadPortTrace(path, header, ops)) return RunTraceReplay(path, header, ops, benchSweeps);
+    SioDump dump;
+    if (!ReadSioDump(path, dump)) { fprintf(stderr, "cannot read register dump %s\n", path); return 2; }
+    const SioChip* recorded = MatchSioChip((uint16_t)dump.chipId);
+    if (!recorded) { fprintf(stderr, "%s: unknown chip 0x%04X\n", path, dump.chipId); return 1; }
+    auto sim = std::make_unique<SimSuperIo>(*recorded, (uint16_t)dump.port, (uint16_t)dump.baseAddr);
+    sim->Load(dump);
+
+    SioDetectResult found;
+    if (!DetectSuperIo(*sim, found)) { fprintf(stderr, "%s: chip 0x%04X not detected\n", path, dump.chipId); return 1; }
+    if (found.chip->detectOnly) {
+        fprintf(stderr, "%s: %s is detect-only; %zu raw registers, no register map to decode them with\n", path, found.chip->name, dump.regs.size());
+        return 1;
+    }
+    IPortIo* io = sim.get();
+    std::mutex ioMutex;
+    SuperIoProvider provider(io, ioMutex, found.chip, found.baseAddr);
+    float values[SIO_SENSOR_COUNT];
+    if (!provider.Open() || !provider.Poll(values)) return 1;
+    printf("# %s (%s) on 0x%02X, base 0x%03X\n", found.chip->name, SioFamilyName(found.chip->family), found.port, found.baseAddr);
+    for (int i = 0; i < provider.SensorCount(); i++) {
+        printf("%s,%.3f%s\n", provider.Sensor(i).name, values[i], SensorUnitSuffix(provider.Sensor(i).unit));
+    }
+    return 0;
+}
+
+// Records the board's Super I/O registers through /dev/port (root)
+static int RunSioDump(const char* path, const char* tracePath) {
+    DevPortIo devPort;
+    if (!devPort.Open()) { fprintf(stderr, "cannot open /dev/port (needs root and a kernel without lockdown)\n"); return 1; }
+    TracingPortIo port(devPort);
+    if (tracePath && !port.Open(tracePath)) { fprintf(stderr, "cannot write %s\n", tracePath); return 1; }
+    SioDetectResult found;
+    if (!DetectSuperIo(port, found)) { fprintf(stderr, "no supported super i/o chip (last ID 0x%04X)\n", found.lastId); return 1; }
+    FILE* out = fopen(path, "w");
+    if (!out) { fprintf(stderr, "cannot write %s\n", path); return 1; }
+    bool ok = WriteSioDump(port, found, out);
+    fclose(out);
+    fprintf(stderr, "%s at 0x%03X -> %s\n", found.chip->name, found.baseAddr, path);
+    return ok ? 0 : 1;
+}
+
+// A consumer of another collector's --export: one CSV row per interval, straight from the
+// mapping. Reopens when the writer restarts; rows repeat nothing it has not republished.
+static int RunReadExport(const char* name, int intervalMs, long count) {
+    TshmReader reader;
+    if (!tshm_open(&reader, name)) { fprintf(stderr, "no telemetry published as %s\n", name); return 1; }
+    fprintf(stderr, "pid %u, %u sensors, every %u ms\n", reader.header->writerPid, tshm_sensor_count(&reader), reader.header->intervalMs);
+    uint32_t columns = 0;
+    uint64_t last = 0;
+    float values[TSHM_MAX_SENSORS];
+    for (long tick = 0; count < 0 || tick < count; tick++) {
+        if (!tshm_live(&reader) || !tshm_writer_alive(&reader)) {      // Closed, or died without closing
+            tshm_close(&reader);
+            while (!tshm_open(&reader, name)) std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+            columns = 0;
+            last = 0;
+        }
+        uint64_t publishes = last;      // Unchanged if the read gave up
+        uint32_t n = tshm_read(&reader, values, TSHM_MAX_SENSORS, &publishes);
+        if (n != columns) {
+            printf("publish");
+            for (uint32_t i = 0; i < n; i++) printf(",%s[%s]", tshm_sensor(&reader, i)->name, tshm_sensor(&reader, i)->unit);
+            printf("\n");
+            columns = n;
+        }
+        if (publishes != last) {
+            printf("%llu", (unsigned long long)publishes);
+            for (uint32_t i = 0; i < n; i++) printf(",%.2f", values[i]);
+            printf("\n");
+            fflush(stdout);
+            last = publishes;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+    tshm_close(&reader);
+    return 0;
+}
+
+static int RunMemTest(const MemTestConfig& cfg) {
+    MemTester tester;
+    if (!tester.Start(cfg)) { fprintf(stderr, "cannot allocate memory to test\n"); return 1; }
+    MemTestStatus s = tester.Status();
+    fprintf(stderr, "testing %.1f MiB on %d threads%s\n", s.bytes / 1048576.0, s.threads, s.locked ? ", locked" : " (pages not locked)");
+    size_t printed = 0;
+    double start = MonotonicSeconds();
+    while (!tester.Finished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        s = tester.Status();
+        std::vector<MemTestError> errors = tester.Errors();
+        for (; printed < errors.size(); printed++) printf("error: %s\n", FormatMemTestError(errors[printed]).c_str());
+        fprintf(stderr, "\r%.1f GB verified, %d passes, %llu errors, %.0f s", s.bytesVerified / 1e9, s.passesDone,
+            (unsigned long long)s.errors, MonotonicSeconds() - start);
+    }
+    tester.Stop();
+    fprintf(stderr, "\n");
+    return s.errors ? 5 : 0;
+}
+
+int main(int argc, char** argv) {
+    int intervalMs = 500;
+    long count = -1;
+    bool printStats = false;
+    const char* logPath = nullptr;
+    const char* renderPath = nullptr;
+    int renderBench = 0;
+    bool bench = false;
+    BenchOptions benchOpt;
+    bool stress = false;
+    int seconds = -1;           // --stress / --fan-sim run length; each has its own default
+    CpuStressConfig stressCfg;
+    bool memTest = false;
+    MemTestConfig memTestCfg;
+    bool fanSim = false;
+    bool sioBench = false;
+    const char* sioChip = nullptr;
+    int sioLatencyNs = 0, sioSweeps = 1000, sioMaxOps = 0;
+    const char* sioDumpPath = nullptr;
+    const char* sioReplayPath = nullptr;
+    const char* tracePath = nullptr;
+    bool exportShm = false, readExport = false;
+    const char* shmName = TSHM_DEFAULT_NAME;
+    std::vector<std::pair<int, FanChannelConfig>> fanChannels;
+    memTestCfg.passes = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) intervalMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) count = atol(argv[++i]);
+        else if (strcmp(argv[i], "--stats") == 0) printStats = true;
+        else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) logPath = argv[++i];
+        else if (strcmp(argv[i], "--render") == 0 && i + 1 < argc) renderPath = argv[++i];
+        else if (strcmp(argv[i], "--render-bench") == 0 && i + 1 < argc) renderBench = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--bench") == 0) bench = true;
+        else if (strcmp(argv[i], "--membench") == 0) bench = benchOpt.memory = true;
+        else if (strcmp(argv[i], "--mem-mib") == 0 && i + 1 < argc) memTestCfg.maxBytes = benchOpt.memBytes = (size_t)atol(argv[++i]) << 20;
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) stressCfg.threads = memTestCfg.threads = benchOpt.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--stress") == 0 && i + 1 < argc) {
+            if (!ParseStressProfile(argv[++i], stressCfg.profile)) { fprintf(stderr, "unknown stress profile %s\n", argv[i]); return 2; }
+            stress = true;
+        }
+        else if (strcmp(argv[i], "--duty") == 0 && i + 1 < argc) stressCfg.dutyPct = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--memtest") == 0) memTest = true;
+        else if (strcmp(argv[i], "--fan-sim") == 0) fanSim = true;
+        else if (strcmp(argv[i], "--sio-bench") == 0) sioBench = true;
+        else if (strcmp(argv[i], "--chip") == 0 && i + 1 < argc) sioChip = argv[++i];
+        else if (strcmp(argv[i], "--latency-ns") == 0 && i + 1 < argc) sioLatencyNs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sweeps") == 0 && i + 1 < argc) sioSweeps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-sweep-ops") == 0 && i + 1 < argc) sioMaxOps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fan") == 0 && i + 1 < argc) {
+            const char* spec = argv[++i];
+            FanChannelConfig cfg;
+            int channel = atoi(spec);
+            const char* colon = strchr(spec, ':');
+            if (!colon || channel < 0 || channel >= NCT_FAN_CHANNELS || !ParseFanChannel(colon + 1, cfg)) { fprintf(stderr, "bad fan channel spec %s\n", spec); return 2; }
+            fanChannels.push_back({ channel, cfg });
+        }
+        else if (strcmp(argv[i], "--mem-pct") == 0 && i + 1 < argc) memTestCfg.freeFraction = atof(argv[++i]) / 100.0;
+        else if (strcmp(argv[i], "--passes") == 0 && i + 1 < argc) memTestCfg.passes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) memTestCfg.seed = strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) benchOpt.kernel = argv[++i];
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) benchOpt.harness.warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) benchOpt.harness.repetitions = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) benchOpt.jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) benchOpt.baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) benchOpt.thresholdPct = atof(argv[++i]);
+        else if (strcmp(argv[i], "--sio-dump") == 0 && i + 1 < argc) sioDumpPath = argv[++i];
+        else if (strcmp(argv[i], "--sio-replay") == 0 && i + 1 < argc) sioReplayPath = argv[++i];
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) tracePath = argv[++i];
+        else if (strcmp(argv[i], "--export") == 0) exportShm = true;
+        else if (strcmp(argv[i], "--read-export") == 0) readExport = true;
+        else if (strcmp(argv[i], "--shm-name") == 0 && i + 1 < argc) shmName = argv[++i];
+        else if (strcmp(argv[i], "--to-csv") == 0 && i + 1 < argc) {
+            TelemetryLogReader reader;
+            if (!reader.Open(argv[++i])) { fprintf(stderr, "cannot read %s\n", argv[i]); return 1; }
+            if (reader.Recovered()) fprintf(stderr, "%s: no footer, recovered %d blocks by scanning\n", argv[i], reader.BlockCount());
+            WriteTelemetryCsv(reader, std::cout, INT64_MIN, INT64_MAX);
+            return 0;
+        }
+        else { fprintf(stderr, "usage: %s [--interval ms] [--count n] [--stats] [--log file.tlog] [--export] [--render file] [--render-bench frames] | --read-export | --bench|--membench|--memtest|--stress|--fan-sim|--sio-bench [options] | --sio-dump|--sio-replay file [--trace out.ptrace] | --to-csv file.tlog\n", argv[0]); return 2; }
+    }
+    if (stress) return RunStress(stressCfg, seconds > 0 ? seconds : 60);
+    if (fanSim) return RunFanSim(seconds > 0 ? seconds : 480, fanChannels, tracePath);
+    if (sioBench) return RunSioBench(sioChip, sioLatencyNs, sioSweeps, sioMaxOps);
+    if (sioDumpPath) return RunSioDump(sioDumpPath, tracePath);
+    if (sioReplayPath) return RunSioReplay(sioReplayPath, sioSweeps);
+    if (readExport) return RunReadExport(shmName, intervalMs, count);
+    if (memTest) return RunMemTest(memTestCfg);
+    if (bench) return RunBench(benchOpt);
+
+    SensorHub hub;
+    static ProcStatProvider procStat;
+    static MemInfoProvider memInfo;
+    static DiskStatsProvider diskStats;
+    static HwmonProvider hwmon;
+    static CpuClockProvider cpuClock;
+    struct {
+        ISensorProvider* provider;
+        PollTaskConfig cfg;
+        float changeDelta;      // Smallest move that counts as "changed"
+    } tasks[] = {
+        { &procStat, { "procstat", 250, 2000, 500, 500 }, 5.0f },
+        { &memInfo, { "meminfo", 500, 5000, 1000, 200 }, 64.0f },
+        { &diskStats, { "diskstats", 500, 5000, 1000, 200 }, 1.0f },
+        { &hwmon, { "hwmon", 500, 5000, 1000, 2000 }, 1.0f },
+        { &cpuClock, { "cpuclock", 500, 5000, 1000, 500 }, 50.0f },
+    };
+
+    PollScheduler scheduler;
+    int primeMs = 0;
+    for (auto& t : tasks) {
+        int id = hub.Add(t.provider);
+        if (id < 0) { fprintf(stderr, "provider %s unavailable\n", t.provider->Name()); continue; }
+        // Prime before the first row: absolute sensors get a value now, rate sensors a baseline
+        hub.Poll(id);
+        primeMs = (std::max)(primeMs, t.cfg.minMs);
+        float changeDelta = t.changeDelta;
+        scheduler.Add(t.cfg, [&hub, id, changeDelta]() {
+            float delta = 0.0f;
+            if (!hub.Poll(id, nullptr, &delta)) return PollResult::Stable;
+            return (delta >= changeDelta) ? PollResult::Changed : PollResult::Stable;
+        });
+    }
+    // Start()'s immediate run then measures the rates over at least one full window, and the
+    // first row, sample or publish waits for it instead of showing zeros
+    std::this_thread::sleep_for(std::chrono::milliseconds(primeMs));
+    scheduler.Start();
+    for (int i = 0; i < scheduler.TaskCount(); i++) {
+        for (int waited = 0; scheduler.Stats(i).runs == 0 && waited < 2000; waited += 5) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    static TelemetryLogWriter log;
+    if (logPath) {
+        if (!log.Open(logPath)) { fprintf(stderr, "cannot create %s\n", logPath); return 1; }
+        for (int i = 0; i < hub.SensorCount(); i++) log.AddColumn(hub.Sensor(i));
+    }
+    else {
+        printf("time");
+        for (int i = 0; i < hub.SensorCount(); i++) printf(",%s[%s]", hub.Sensor(i).name, SensorUnitSuffix(hub.Sensor(i).unit));
+        printf("\n");
+    }
+
+    static TelemetryExporter exporter;
+    if (exportShm && !exporter.Open(shmName, intervalMs)) { fprintf(stderr, "cannot create shared memory %s\n", shmName); return 1; }
+
+    double start = MonotonicSeconds();
+    float row[MAX_SENSORS];
+    for (long tick = 0; count < 0 || tick < count; tick++) {
+        if (exportShm) exporter.Publish(hub, TelemetryNowMs());
+        if (logPath) {
+            for (int i = 0; i < hub.SensorCount(); i++) row[i] = hub.Value(i);
+            log.Push(TelemetryNowMs(), row, hub.SensorCount());
+        }
+        else {
+            printf("%.3f", MonotonicSeconds() - start);
+            for (int i = 0; i < hub.SensorCount(); i++) printf(",%.2f", hub.Value(i));
+            printf("\n");
+            fflush(stdout);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+    scheduler.Stop();
+    exporter.Close();
+    if (logPath) {
+        log.Close();
+        fprintf(stderr, "%s: %llu bytes, %llu rows dropped\n", logPath, (unsigned long long)log.BytesWritten(), (unsigned long long)log.Dropped());
+    }
+
+    if (printStats) {
+        fprintf(stderr, "%-12s %8s %8s %10s %10s %10s\n", "task", "interval", "runs", "avg us", "max us", "total ms");
+        for (int i = 0; i < scheduler.TaskCount(); i++) {
+            PollTaskStats st = scheduler.Stats(i);
+            fprintf(stderr, "%-12s %8d %8llu %10.1f %10.1f %10.2f\n", st.name, st.intervalMs, (unsigned long long)st.runs, st.avgUs, st.maxUs, st.totalMs);
+        }
+    }
+    if (renderPath || renderBench > 0) return RenderOverlay(hub, renderPath, renderBench);
+    return 0;
+}
+#endif
@@ -1,4 +1,9 @@
 #include "shared.hpp"
+#include "Overlay.hpp"
+#include "OverlayLayout.hpp"
+#include "RenderScheduler.hpp"
+#include "SoftCanvas.hpp"
+#include "SuperIo.hpp"
 #include <gdiplus.h>
 #include <fcntl.h>
 #include <io.h>
@@ -13,14 +18,11 @@
 #include <dxgi1_4.h>
 #include <powrprof.h>
 #include <Pdh.h>
+#include <dwmapi.h>
 
 #pragma comment(lib, "dxgi.lib")
 #pragma comment(linker, "/SUBSYSTEM:windows /ENTRY:mainCRTStartup")
 
-constexpr int UI_WIDTH_NORMAL = 550;
-constexpr int UI_WIDTH_MINI = 220;
-constexpr int CORNER_RADIUS = 18;
-constexpr int BTN_HEIGHT = 30;
 
 struct AppConfig {
     bool showCpu = true;
@@ -35,10 +37,13 @@ struct AppConfig {
     bool showUptime = true;
     bool showBattery = true;
     bool enableLogging = false;
+    bool exportTelemetry = true;    // Shared memory for capture tools and agents (TelemetryShm.h)
+    bool traceSio = false;      // Record every port op from startup, detection included
     bool miniMode = false;
     int opacity = 230;
     int xOffset = 30;
     int yOffset = 30;
+    int maxFps = 60;            // Presents are capped to a whole number of refresh periods
 };
 
 AppConfig g_Cfg;
@@ -47,10 +52,12 @@ std::atomic<bool> g_CpuStress(false);
 std::atomic<bool> g_RamStress(false);
 std::atomic<bool> g_GpuStress(false);
 std::mutex g_StatsMutex;
+PollScheduler g_Poller;
+RenderSignal g_RenderSignal;
 HWND g_hOverlay = NULL;
 HWND g_hSettings = NULL;
 
-RECT g_RectMultiCore = { 0 }, g_RectSingleCore = { 0 }, g_RectGpuTest = { 0 };
+RECT g_RectMultiCore = { 0 }, g_RectSingleCore = { 0 }, g_RectGpuTest = { 0 }, g_RectMemTest = { 0 };
 RECT g_RectCpuBurn = { 0 }, g_RectRamBurn = { 0 }, g_RectGpuBurn = { 0 };
 RECT g_RectFanControl = { 0 };
 
@@ -77,189 +84,62 @@ void OpenSettingsWindow(HINSTANCE hInst) {
     ShowWindow(g_hSettings, SW_SHOW);
 }
 
-void DrawRoundedRect(Gdiplus::Graphics* g, Gdiplus::Brush* fillBrush, Gdiplus::Pen* borderPen, int x, int y, int w, int h, int r) {
-    Gdiplus::GraphicsPath path; path.AddArc(x, y, r, r, 180, 90); path.AddArc(x + w - r, y, r, r, 270, 90);
-    path.AddArc(x + w - r, y + h - r, r, r, 0, 90); path.AddArc(x, y + h - r, r, r, 90, 90); path.CloseFigure();
-    if (fillBrush) g->FillPath(fillBrush, &path); if (borderPen) g->DrawPath(borderPen, &path);
-}
-
-void DrawPillBar(Gdiplus::Graphics* g, float x, float y, float w, float h, float pct, Gdiplus::Brush* bFill, Gdiplus::Brush* bBg) {
-    DrawRoundedRect(g, bBg, NULL, (int)x, (int)y, (int)w, (int)h, (int)h);
-    float fillW = w * pct; if (fillW < h) fillW = h; if (fillW > w) fillW = w;
-    DrawRoundedRect(g, bFill, NULL, (int)x, (int)y, (int)fillW, (int)h, (int)h);
-}
-
-void DrawStr(Gdiplus::Graphics* g, const WCHAR* s, Gdiplus::Font* f, float x, float y, Gdiplus::Brush* b) {
-    g->DrawString(s, -1, f, Gdiplus::PointF(x, y), b);
-}
-
-void DrawButton(Gdiplus::Graphics* g, const WCHAR* s, float x, float y, float w, float h, bool active, Gdiplus::Font* f) {
-    Gdiplus::SolidBrush bActive(Gdiplus::Color(200, 255, 69, 58));
-    Gdiplus::SolidBrush bIdle(Gdiplus::Color(80, 80, 80, 80));
-    Gdiplus::SolidBrush bText(Gdiplus::Color(255, 255, 255, 255));
-    DrawRoundedRect(g, active ? &bActive : &bIdle, NULL, (int)x, (int)y, (int)w, (int)h, 10);
-    Gdiplus::RectF rect(x, y + 5, w, h);
-    Gdiplus::StringFormat format; format.SetAlignment(Gdiplus::StringAlignmentCenter);
-    g->DrawString(s, -1, f, rect, &format, &bText);
-}
-
-void DrawAppleUI(Gdiplus::Graphics* g, int w, int h) {
-    Gdiplus::SolidBrush bBg(Gdiplus::Color(g_Cfg.opacity, 20, 20, 22));
-    Gdiplus::Pen pBorder(Gdiplus::Color(50, 255, 255, 255), 1);
-    DrawRoundedRect(g, &bBg, &pBorder, 0, 0, w, h, CORNER_RADIUS);
-
-    Gdiplus::SolidBrush bWhite(Gdiplus::Color(255, 255, 255, 255));
-    Gdiplus::SolidBrush bGray(Gdiplus::Color(150, 142, 142, 147));
-    Gdiplus::SolidBrush bBlue(Gdiplus::Color(255, 10, 132, 255));
-    Gdiplus::SolidBrush bRed(Gdiplus::Color(255, 255, 69, 58));
-    Gdiplus::SolidBrush bYellow(Gdiplus::Color(255, 255, 204, 0));
-    Gdiplus::SolidBrush bGreen(Gdiplus::Color(255, 46, 204, 113));
-    Gdiplus::SolidBrush bTrack(Gdiplus::Color(50, 255, 255, 255));
-
-    Gdiplus::Font fHeader(L"Segoe UI", 11, Gdiplus::FontStyleBold);
-    Gdiplus::Font fBody(L"Segoe UI", 9, Gdiplus::FontStyleRegular);
-    Gdiplus::Font fSmall(L"Segoe UI", 8, Gdiplus::FontStyleRegular);
-
-    DrawRoundedRect(g, &bRed, NULL, 20, 15, 14, 14, 7);
-    DrawRoundedRect(g, &bYellow, NULL, 40, 15, 14, 14, 7);
-
-    if (g_Cfg.miniMode) {
-        std::lock_guard<std::mutex> l(g_StatsMutex);
-        wchar_t buf[128]; swprintf_s(buf, L"CPU %d%%", g_CpuUsage);
-        DrawStr(g, buf, &fHeader, 90, 12, &bWhite);
-        swprintf_s(buf, L"%d\u00B0C", g_CpuTemp); DrawStr(g, buf, &fBody, 160, 14, &bGray);
-        return;
-    }
-
-    float y = 40.0f; float x = 25.0f; float contentW = w - 50.0f;
-    wchar_t buf[512];
-
-    if (g_Cfg.showCpu) {
-        DrawStr(g, g_CpuName.c_str(), &fBody, x, y, &bWhite); y += 18.0f;
-        DrawPillBar(g, x, y, contentW, 8, g_CpuUsage / 100.0f, (g_CpuTemp > 85) ? &bRed : &bBlue, &bTrack); y += 12.0f;
-        swprintf_s(buf, L"%d%% Load  \u2022  %d\u00B0C Temp  \u2022  %d Thr", g_CpuUsage, g_CpuTemp, g_GlobalThreads);
-        DrawStr(g, buf, &fSmall, x, y, &bGray); y += 20.0f;
-    }
-
-    if (g_Cfg.showCores && !g_CoreLoad.empty()) {
-        float startX = x; int col = 0; int maxCols = 4;
-        for (size_t i = 0; i < g_CoreLoad.size(); i++) {
-            float coreX = startX + (col * (contentW / maxCols));
-            float pct = g_CoreLoad[i] / 100.0f;
-            DrawPillBar(g, coreX, y + 4, (contentW / maxCols) - 10, 4, pct, (pct > 0.8f) ? &bRed : &bBlue, &bTrack);
-            col++; if (col >= maxCols) { col = 0; y += 8.0f; }
-        }
-        if (col != 0) y += 8.0f; y += 10.0f;
-    }
-
-    // --- MOTHERBOARD DETAILS ---
-    bool fanReady = InitFanControl();
-    if (fanReady) {
-        DrawStr(g, L"Motherboard (NCT6687D)", &fBody, x, y, &bWhite); y += 18.0f;
-
-        if (g_DetectedChipID != 0) {
-            swprintf_s(buf, L"ID: %04X (Found)", g_DetectedChipID);
-            DrawStr(g, buf, &fSmall, x, y, &bGreen); y += 14.0f;
-
-            swprintf_s(buf, L"CPU: %.3fV  SoC: %.3fV  DRAM: %.3fV", g_VoltVCore, g_VoltSoC, g_VoltDram);
-            DrawStr(g, buf, &fSmall, x, y, &bGray); y += 14.0f;
-
-            swprintf_s(buf, L"+12V: %.2fV  +5V: %.2fV", g_Volt12V, g_Volt5V);
-            DrawStr(g, buf, &fSmall, x, y, &bGray); y += 14.0f;
-
-            swprintf_s(buf, L"VRM: %d\u00B0C  Sys: %d\u00B0C  PCH: %d\u00B0C", g_TempVRM, g_TempSystem, g_TempPCH);
-            DrawStr(g, buf, &fSmall, x, y, &bGray); y += 20.0f;
-        }
-        else {
-            // Debug: Show why it failed
-            swprintf_s(buf, L"Scanning... Last: %04X", g_DebugID);
-            DrawStr(g, buf, &fSmall, x, y, &bRed); y += 20.0f;
-        }
-    }
-
-    if (g_Cfg.showGpu) {
-        DrawStr(g, g_GpuName.c_str(), &fBody, x, y, &bWhite); y += 18.0f;
-        if (g_GpuVramTotal > 0) {
-            float vramPct = (float)g_GpuVramUsed / (float)g_GpuVramTotal;
-            DrawPillBar(g, x, y, contentW, 6, vramPct, &bBlue, &bTrack);
-            swprintf_s(buf, L"VRAM: %llu / %llu MB", g_GpuVramUsed / (1024 * 1024), g_GpuVramTotal / (1024 * 1024));
-            y += 12.0f; DrawStr(g, buf, &fSmall, x, y, &bGray);
-        }
-        y += 20.0f;
-    }
-
-    if (g_Cfg.showDrives) {
-        DrawStr(g, L"Storage", &fBody, x, y, &bWhite); y += 18.0f;
-        for (const auto& drive : g_DriveInfo) {
-            DrawStr(g, drive.c_str(), &fSmall, x, y, &bGray); y += 12.0f;
-        }
-        y += 8.0f;
-    }
-
-    if (g_Cfg.showBattery && g_HasBattery) {
-        DrawStr(g, L"Battery", &fBody, x, y, &bWhite); y += 18.0f;
-        DrawPillBar(g, x, y, contentW, 8, g_BatteryPct / 100.0f, g_BatteryPct < 20 ? &bRed : &bGreen, &bTrack);
-        swprintf_s(buf, L"%d%% (%s)", g_BatteryPct, g_BatteryTime.c_str());
-        y += 12.0f; DrawStr(g, buf, &fSmall, x, y, &bGray); y += 20.0f;
-    }
-
-    // --- FAN CONTROL SLIDER ---
-    DrawStr(g, L"Fan Control", &fBody, x, y, fanReady ? &bGreen : &bRed); y += 18.0f;
-    if (fanReady) {
-        swprintf_s(buf, L"%d RPM  \u2022  Target %d%%", g_FanRPM, g_FanSpeedPct);
-        DrawStr(g, buf, &fSmall, x, y, &bGray); y += 14.0f;
-
-        // Draw Slider Pill
-        DrawPillBar(g, x, y, contentW, 8, g_FanSpeedPct / 100.0f, g_DraggingFan ? &bWhite : &bYellow, &bTrack);
-
-        // Save Click Rect
-        g_RectFanControl = { (long)x, (long)y, (long)(x + contentW), (long)(y + 8) };
-        y += 20.0f;
-    }
-    else {
-        DrawStr(g, L"Driver Missing (Run as Admin)", &fSmall, x, y, &bGray); y += 20.0f;
-    }
-
-    y += 10.0f;
-    DrawStr(g, L"Benchmarks", &fBody, x, y, &bWhite); y += 20.0f;
-
-    if (g_BenchRunning) {
-        swprintf_s(buf, L"Running CPU Test (%d%%)", g_BenchProgress.load());
-        DrawStr(g, buf, &fSmall, x, y, &bYellow);
-        DrawPillBar(g, x, y + 15, contentW, 6, g_BenchProgress / 100.0f, &bYellow, &bTrack);
-    }
-    else if (g_GpuBenchRunning) {
-        swprintf_s(buf, L"Running GPU Test (%d%%)", g_BenchProgress.load());
-        DrawStr(g, buf, &fSmall, x, y, &bYellow);
-        DrawPillBar(g, x, y + 15, contentW, 6, g_BenchProgress / 100.0f, &bYellow, &bTrack);
+void FillOverlayState(OverlayState& st) {
+    st.showCpu = g_Cfg.showCpu;
+    st.showCores = g_Cfg.showCores;
+    st.showGpu = g_Cfg.showGpu;
+    st.showDrives = g_Cfg.showDrives;
+    st.showBattery = g_Cfg.showBattery;
+    st.miniMode = g_Cfg.miniMode;
+    st.opacity = g_Cfg.opacity;
+    st.cpuName = g_CpuName.c_str();
+    st.gpuName = g_GpuName.c_str();
+    // The chip globals are only safe to read once detection has published them
+    st.fanReady = FanControlReady();
+    static std::wstring chipName;
+    if (st.fanReady) {
+        st.chipId = g_DetectedChipID;
+        if (g_SioChip && chipName.empty()) chipName.assign(g_SioChip->name, g_SioChip->name + strlen(g_SioChip->name));
+        st.chipMapped = !g_SioChip || !g_SioChip->detectOnly;
+        st.debugId = g_DebugID;
     }
-    else {
-        if (g_BenchScore > 0) { swprintf_s(buf, L"CPU Score: %d pts", g_BenchScore.load()); DrawStr(g, buf, &fHeader, x, y, &bGreen); }
-        if (g_GpuScore > 0) { swprintf_s(buf, L"GPU Score: %d pts", g_GpuScore.load()); DrawStr(g, buf, &fHeader, x + 150, y, &bBlue); }
-        if (g_BenchScore == 0 && g_GpuScore == 0) DrawStr(g, L"Ready to Test", &fSmall, x, y, &bGray);
-    }
-    y += 30.0f;
-
-    float btnW = (contentW - 15) / 3;
-    DrawButton(g, L"Multi Core", x, y, btnW, BTN_HEIGHT, g_BenchRunning && g_BenchMode.find(L"Multi") != std::wstring::npos, &fBody);
-    g_RectMultiCore = { (long)x, (long)y, (long)(x + btnW), (long)(y + BTN_HEIGHT) };
-
-    DrawButton(g, L"Single Core", x + btnW + 5, y, btnW, BTN_HEIGHT, g_BenchRunning && g_BenchMode.find(L"Single") != std::wstring::npos, &fBody);
-    g_RectSingleCore = { (long)(x + btnW + 5), (long)y, (long)(x + btnW + 5 + btnW), (long)(y + BTN_HEIGHT) };
-
-    DrawButton(g, L"GPU Test", x + (btnW * 2) + 10, y, btnW, BTN_HEIGHT, g_GpuBenchRunning, &fBody);
-    g_RectGpuTest = { (long)(x + (btnW * 2) + 10), (long)y, (long)(x + (btnW * 2) + 10 + btnW), (long)(y + BTN_HEIGHT) };
-
-    y += 45.0f;
-    float stressW = (contentW - 20) / 3;
-    DrawButton(g, L"CPU BURN", x, y, stressW, BTN_HEIGHT, g_CpuStress, &fSmall);
-    g_RectCpuBurn = { (long)x, (long)y, (long)(x + stressW), (long)(y + BTN_HEIGHT) };
-
-    DrawButton(g, L"RAM BURN", x + stressW + 10, y, stressW, BTN_HEIGHT, g_RamStress, &fSmall);
-    g_RectRamBurn = { (long)(x + stressW + 10), (long)y, (long)(x + stressW + 10 + stressW), (long)(y + BTN_HEIGHT) };
+    st.chipName = chipName.empty() ? L"Super I/O" : chipName.c_str();
+    st.fanAuto = g_FanAuto;
+    st.fanTargetPct = g_FanAuto ? g_FanController.OutputPct(0) : g_FanSpeedPct;
+    st.draggingFan = g_DraggingFan;
+    st.benchRunning = g_BenchRunning;
+    st.benchMulti = g_BenchMode.find(L"Multi") != std::wstring::npos;
+    st.benchSingle = g_BenchMode.find(L"Single") != std::wstring::npos;
+    st.memBench = g_BenchMode == L"Memory";
+    st.gpuBenchRunning = g_GpuBenchRunning;
+    st.benchProgress = g_BenchProgress;
+    st.benchScore = g_BenchScore;
+    st.gpuScore = g_GpuScore;
+    st.memBandwidth = g_MemBandwidth;
+    st.memLatency = g_MemLatency;
+    st.cpuStress = g_CpuStress;
+    st.stressProfile = g_StressProfile;
+    st.stressDuty = g_StressDuty;
+    st.ramStress = g_RamStress;
+    st.gpuStress = g_GpuStress;
+    st.ramVerifiedGB = g_RamTestVerified / 1e9;
+    st.ramPasses = g_RamTestPasses;
+    st.ramErrors = g_RamTestErrors;
+    st.ramFirstError = g_RamTestFirstError;
+    st.ramFirstBit = g_RamTestFirstBit;
+}
 
-    DrawButton(g, L"GPU BURN", x + (stressW * 2) + 20, y, stressW, BTN_HEIGHT, g_GpuStress, &fSmall);
-    g_RectGpuBurn = { (long)(x + (stressW * 2) + 20), (long)y, (long)(x + (stressW * 2) + 20 + stressW), (long)(y + BTN_HEIGHT) };
+static RECT ToRect(const UiRect& r) { return { r.x, r.y, r.Right(), r.Bottom() }; }
+
+void ApplyHitRects(const UiFrame& f) {
+    if (!f.hits[(int)UiHit::FanSlider].Empty()) g_RectFanControl = ToRect(f.hits[(int)UiHit::FanSlider]);
+    g_RectMultiCore = ToRect(f.hits[(int)UiHit::MultiCore]);
+    g_RectSingleCore = ToRect(f.hits[(int)UiHit::SingleCore]);
+    g_RectGpuTest = ToRect(f.hits[(int)UiHit::GpuTest]);
+    g_RectMemTest = ToRect(f.hits[(int)UiHit::MemTest]);
+    g_RectCpuBurn = ToRect(f.hits[(int)UiHit::CpuBurn]);
+    g_RectRamBurn = ToRect(f.hits[(int)UiHit::RamBurn]);
+    g_RectGpuBurn = ToRect(f.hits[(int)UiHit::GpuBurn]);
 }
 
 bool IsPointInRect(int x, int y, RECT r) {
@@ -282,7 +162,7 @@ void UpdateFanFromMouse(int x) {
     if (pct < 0.1f) pct = 0.1f; // Min 10%
     if (pct > 1.0f) pct = 1.0f; // Max 100%
 
-    // Set global target (system.cpp picks this up)
+    // Set global target (the fan controller thread picks this up)
     int newSpeed = (int)(pct * 100.0f);
     SetFanSpeed(newSpeed);
 }
@@ -303,7 +183,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         }
 
         // --- FAN SLIDER CLICK ---
-        if (InitFanControl() && IsPointInRect(x, y, g_RectFanControl)) {
+        if (FanControlReady() && IsPointInRect(x, y, g_RectFanControl)) {
             g_DraggingFan = true;
             SetCapture(hwnd); // Capture mouse so we can drag outside the rect
             UpdateFanFromMouse(x);
@@ -313,8 +193,9 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         if (IsPointInRect(x, y, g_RectMultiCore)) { StartBenchmark(true); return 0; }
         if (IsPointInRect(x, y, g_RectSingleCore)) { StartBenchmark(false); return 0; }
         if (IsPointInRect(x, y, g_RectGpuTest)) { StartGpuBenchmark(); return 0; }
+        if (IsPointInRect(x, y, g_RectMemTest)) { StartMemBenchmark(); return 0; }
 
-        if (IsPointInRect(x, y, g_RectCpuBurn)) { g_CpuStress = !g_CpuStress; if (g_CpuStress) StartCpuStress(); return 0; }
+        if (IsPointInRect(x, y, g_RectCpuBurn)) { if (g_CpuStress) StopCpuStress(); else StartCpuStress(); return 0; }
         if (IsPointInRect(x, y, g_RectRamBurn)) { g_RamStress = !g_RamStress; if (g_RamStress) StartRamStress(); return 0; }
         if (IsPointInRect(x, y, g_RectGpuBurn)) { g_GpuStress = !g_GpuStress; if (g_GpuStress) StartGpuStress(); return 0; }
 
@@ -327,6 +208,20 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         }
         return 0;
     }
+    // CPU BURN: right click picks the workload, the wheel sets the duty cycle.
+    // Fan slider: right click toggles Auto (temperature curves).
+    case WM_RBUTTONDOWN: {
+        int x = GET_X_LPARAM(lParam), y = GET_Y_LPARAM(lParam);
+        if (IsPointInRect(x, y, g_RectCpuBurn)) { CycleStressProfile(); g_RenderSignal.Post(RENDER_WAKE_DATA); }
+        else if (FanControlReady() && IsPointInRect(x, y, g_RectFanControl)) { SetFanAuto(!g_FanAuto); g_RenderSignal.Post(RENDER_WAKE_DATA); }
+        return 0;
+    }
+    case WM_MOUSEWHEEL: {
+        POINT pt = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };    // Screen coordinates for this message
+        ScreenToClient(hwnd, &pt);
+        if (IsPointInRect(pt.x, pt.y, g_RectCpuBurn)) { AdjustStressDuty(GET_WHEEL_DELTA_WPARAM(wParam) > 0 ? 10 : -10); g_RenderSignal.Post(RENDER_WAKE_DATA); }
+        return 0;
+    }
     case WM_LBUTTONUP: {
         if (g_DraggingFan) {
             g_DraggingFan = false;
@@ -339,43 +234,133 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     return DefWindowProc(hwnd, msg, wParam, lParam);
 }
 
-// ... (Rest of main function remains the same as previous) ...
+// Quit key, plus F9 to export the history. A low-level hook sees them without taking them from
+// other applications (RegisterHotKey would).
+static LRESULT CALLBACK HotKeyHook(int code, WPARAM wParam, LPARAM lParam) {
+    if (code == HC_ACTION && wParam == WM_KEYDOWN) {
+        DWORD vk = ((KBDLLHOOKSTRUCT*)lParam)->vkCode;
+        if (vk == VK_END) PostQuitMessage(0);
+        else if (vk == VK_F9) std::thread([]() { ExportHistory(); }).detach();     // The hook must return quickly
+    }
+    return CallNextHookEx(NULL, code, wParam, lParam);
+}
+
+// QPC and DWM timestamps share one timebase; split the multiply so it cannot overflow
+static int64_t QpcToUs(int64_t qpc) {
+    static const int64_t freq = [] { LARGE_INTEGER f; QueryPerformanceFrequency(&f); return f.QuadPart; }();
+    return qpc / freq * 1000000 + qpc % freq * 1000000 / freq;
+}
+
+static int64_t NowUs() { LARGE_INTEGER c; QueryPerformanceCounter(&c); return QpcToUs(c.QuadPart); }
+
+static void SyncRefresh(RenderPacer& pacer) {
+    DWM_TIMING_INFO info = { 0 }; info.cbSize = sizeof(info);
+    if (SUCCEEDED(DwmGetCompositionTimingInfo(NULL, &info)) && info.qpcRefreshPeriod > 0)
+        pacer.SetRefresh(QpcToUs(info.qpcRefreshPeriod), QpcToUs(info.qpcVBlank));
+}
+
 int main() {
     _setmode(_fileno(stdout), _O_U16TEXT);
+    InitCom();
     LoadSettings();
     InitDiskPdh();
+    InitCpuMonitor();
+    g_SioTraceEnabled = g_Cfg.traceSio;     // Armed only: the one-time fan init opens it in front of detection
+    std::thread(InitSystemInfo).detach();
+
+    // name, min/max/start interval (ms), cost budget (us)
+    g_Poller.Add({ "cpu", 250, 2000, 500, 2000 }, PollCpu);
+    g_Poller.Add({ "board", 250, 2000, 500, 1000 }, PollBoard);
+    g_Poller.Add({ "wmi.system", 1000, 10000, 1000, 20000 }, PollSystemCounters);
+    g_Poller.Add({ "memory", 500, 5000, 1000, 200 }, UpdateMemory);
+    g_Poller.Add({ "diskio", 1000, 5000, 1000, 500 }, UpdateDiskIo);
+    g_Poller.Add({ "gpu", 1000, 10000, 2000, 5000 }, UpdateGpuVram);
+    g_Poller.Add({ "storage", 5000, 60000, 5000, 1000 }, PollStorage);
+    g_Poller.Add({ "battery", 5000, 60000, 10000, 500 }, UpdateBattery);
+    int recorders = g_Poller.Add({ "history", 1000, 1000, 1000, 0 }, PollHistory);
+    g_Poller.Add({ "log", 500, 500, 500, 0 }, PollLog);
+    g_Poller.Add({ "export", EXPORT_INTERVAL_MS, EXPORT_INTERVAL_MS, EXPORT_INTERVAL_MS, 0 }, PollExport);
+    // Every sensor task publishes new stats; the recorders registered last only read them
+    g_Poller.SetObserver([recorders](int task, PollResult) { if (task < recorders) g_RenderSignal.Post(RENDER_WAKE_DATA); });
+    if (g_Cfg.exportTelemetry) StartExport();     // Before the poller's first PollExport
+    g_Poller.Start();
+    if (g_Cfg.enableLogging) StartLogging();
 
-    std::thread(MonitorCpu).detach();
-    std::thread(MonitorSystem).detach();
     std::thread([]() { GetDetailedRamInfo(); }).detach();
-    std::thread(CheckStorage).detach();
 
     Gdiplus::GdiplusStartupInput gsi; ULONG_PTR tok; Gdiplus::GdiplusStartup(&tok, &gsi, NULL);
+    GlyphAtlas::Install(BuildGdiplusAtlas());
     int w = UI_WIDTH_NORMAL; int h = 850; int x = GetSystemMetrics(SM_CXSCREEN) - w - g_Cfg.xOffset;
     WNDCLASSW wc = { 0 }; wc.lpfnWndProc = WndProc; wc.hInstance = GetModuleHandle(NULL); wc.lpszClassName = L"AppleOverlay"; wc.hCursor = LoadCursor(NULL, IDC_ARROW); RegisterClassW(&wc);
     g_hOverlay = CreateWindowExW(WS_EX_TOPMOST | WS_EX_LAYERED | WS_EX_TOOLWINDOW, L"AppleOverlay", L"", WS_POPUP | WS_VISIBLE, x, g_Cfg.yOffset, w, h, 0, 0, wc.hInstance, 0);
-    HDC sc = GetDC(NULL); HDC memDC = CreateCompatibleDC(sc); HBITMAP memBM = CreateCompatibleBitmap(sc, w, h); SelectObject(memDC, memBM);
-    Gdiplus::Graphics g(memDC); g.SetTextRenderingHint(Gdiplus::TextRenderingHintClearTypeGridFit); g.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
-
+    // Top-down 32bpp DIB: premultiplied BGRA, exactly what SoftCanvas writes and UpdateLayeredWindow reads
+    BITMAPINFO bi = { 0 }; bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER); bi.bmiHeader.biWidth = w; bi.bmiHeader.biHeight = -h;
+    bi.bmiHeader.biPlanes = 1; bi.bmiHeader.biBitCount = 32; bi.bmiHeader.biCompression = BI_RGB;
+    void* bits = NULL;
+    HDC sc = GetDC(NULL); HDC memDC = CreateCompatibleDC(sc); HBITMAP memBM = CreateDIBSection(sc, &bi, DIB_RGB_COLORS, &bits, NULL, 0); SelectObject(memDC, memBM);
+
+    SoftCanvas canvas((uint32_t*)bits, w, h);
+    StatsSnapshot snapshot;
+    OverlayState state;
+    UiFrame frames[2];
+    int current = 0;
+    UiRect dirty[UI_MAX_DIRTY];
+
+    RenderPacer pacer;
+    pacer.SetMaxFps(g_Cfg.maxFps);
+    SyncRefresh(pacer);
+    int64_t refreshSyncUs = NowUs();
+    HANDLE timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!timer) timer = CreateWaitableTimerW(NULL, FALSE, NULL);   // Before Windows 10 1803
+    HANDLE waits[2] = { (HANDLE)g_RenderSignal.NativeHandle(), timer };
+    HHOOK keyHook = SetWindowsHookExW(WH_KEYBOARD_LL, HotKeyHook, GetModuleHandle(NULL), 0);
+    pacer.Post(RENDER_WAKE_DATA, NowUs());  // First frame
     while (g_AppRunning) {
-        MSG msg; while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) { TranslateMessage(&msg); DispatchMessage(&msg); if (msg.message == WM_QUIT) g_AppRunning = false; }
-        if (GetAsyncKeyState(VK_END) & 0x8000) break;
-
-        MEMORYSTATUSEX m; m.dwLength = sizeof(m); GlobalMemoryStatusEx(&m);
-        {
-            std::lock_guard<std::mutex> l(g_StatsMutex); g_RamLoad = m.dwMemoryLoad;
-            double usedGB = (m.ullTotalPhys - m.ullAvailPhys) / (1024.0 * 1024.0 * 1024.0);
-            double totalGB = m.ullTotalPhys / (1024.0 * 1024.0 * 1024.0);
-            wchar_t buf[64]; swprintf_s(buf, L"%.1f/%.1f GB", usedGB, totalGB); g_RamText = buf;
+        // Sleep until new stats, input or the next due present; nothing pending means no timeout at all
+        int64_t waitUs = pacer.WaitUs(NowUs());
+        if (waitUs != 0) {
+            if (waitUs > 0) { LARGE_INTEGER due; due.QuadPart = -waitUs * 10; SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE); }
+            MsgWaitForMultipleObjectsEx(waitUs > 0 ? 2 : 1, waits, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
         }
-        UpdateDiskIo(); UpdateGpuVram(); UpdateBattery();
+        bool input = false;
+        MSG msg; while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) { input = true; TranslateMessage(&msg); DispatchMessage(&msg); if (msg.message == WM_QUIT) g_AppRunning = false; }
+        if (!g_AppRunning) break;
+
+        int64_t now = NowUs();
+        pacer.Post(g_RenderSignal.Take() | (input ? RENDER_WAKE_INPUT : 0), now);
+        // Benchmarks advance their progress without signalling; look again a few times a second
+        if (g_BenchRunning || g_GpuBenchRunning) pacer.WakeAt(now + 250000);
+        if (!pacer.BeginFrame(now)) continue;
+        if (now - refreshSyncUs > 1000000) { SyncRefresh(pacer); refreshSyncUs = now; }    // Follows refresh changes, corrects drift
+
+        ReadStats(snapshot);
+        FillOverlayState(state);
 
         int curW = g_Cfg.miniMode ? UI_WIDTH_MINI : UI_WIDTH_NORMAL; int curH = g_Cfg.miniMode ? 70 : 850;
-        g.Clear(Gdiplus::Color(0, 0, 0, 0)); DrawAppleUI(&g, curW, curH);
-        POINT pSrc = { 0,0 }; SIZE sSize = { curW, curH }; POINT pPos = { x, g_Cfg.yOffset };
-        BLENDFUNCTION bf = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
-        UpdateLayeredWindow(g_hOverlay, sc, &pPos, &sSize, memDC, &pSrc, 0, &bf, ULW_ALPHA);
-        Sleep(30);
+        const UiFrame& prev = frames[current];
+        UiFrame& next = frames[current ^ 1];
+        BuildOverlay(state, snapshot, curW, curH, next);
+        int dirtyCount = DiffUiFrames(prev, next, dirty, UI_MAX_DIRTY, &canvas.Text());
+        current ^= 1;
+        ApplyHitRects(next);
+
+        // Nothing changed: no painting and no upload
+        if (dirtyCount > 0) {
+            PaintUiFrame(canvas, next, dirty, dirtyCount);
+            UiRect bounds;
+            for (int i = 0; i < dirtyCount; i++) bounds = bounds.Union(dirty[i]);
+            RECT rcDirty = { bounds.x, bounds.y, bounds.Right(), bounds.Bottom() };
+            POINT pSrc = { 0,0 }; SIZE sSize = { curW, curH }; POINT pPos = { x, g_Cfg.yOffset };
+            BLENDFUNCTION bf = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+            UPDATELAYEREDWINDOWINFO info = { sizeof(info), sc, &pPos, &sSize, memDC, &pSrc, 0, &bf, ULW_ALPHA, &rcDirty };
+            UpdateLayeredWindowIndirect(g_hOverlay, &info);
+        }
     }
+    UnhookWindowsHookEx(keyHook);
+    CloseHandle(timer);
+    g_Poller.Stop();
+    StopLogging();  // Writes the index footer
+    StopSioTrace();
+    StopExport();   // Readers see 'live' drop and reopen
     DeleteObject(memBM); DeleteDC(memDC); ReleaseDC(NULL, sc); Gdiplus::GdiplusShutdown(tok); return 0;
 }
\ No newline at end of file
@@ -1,24 +1,94 @@
 #include "shared.hpp"
 
 // --- DEFINITIONS ---
-int g_RamLoad = 0;
-std::wstring g_RamText = L"RAM";
+SeqLock<MemStats> g_MemStats;
+std::atomic<float> g_MemBandwidth = 0.0f;
+std::atomic<float> g_MemLatency = 0.0f;
+std::atomic<uint64_t> g_RamTestVerified = 0;
+std::atomic<uint64_t> g_RamTestErrors = 0;
+std::atomic<int> g_RamTestPasses = 0;
+std::atomic<uint64_t> g_RamTestFirstError = 0;
+std::atomic<int> g_RamTestFirstBit = -1;
+WmiRamInfo g_RamInfo;
+
+PollResult UpdateMemory() {
+    MEMORYSTATUSEX m; m.dwLength = sizeof(m);
+    if (!GlobalMemoryStatusEx(&m)) return PollResult::Stable;
+    MemStats stats;
+    stats.load = m.dwMemoryLoad;
+    stats.totalBytes = m.ullTotalPhys;
+    stats.usedBytes = m.ullTotalPhys - m.ullAvailPhys;
+    MemStats prev = g_MemStats.Load();
+    g_MemStats.Store(stats);
+    if (stats.load >= 95) return PollResult::Urgent;
+    return abs(stats.load - prev.load) >= 2 ? PollResult::Changed : PollResult::Stable;
+}
 
 void GetDetailedRamInfo() {
-    WmiQuery wmi; wmi.Init();
-    IEnumWbemClassObject* pEnum = wmi.Exec(L"SELECT Capacity, Speed FROM Win32_PhysicalMemory");
-    if (pEnum) pEnum->Release();
+    WmiRamInfo info;
+    if (!GetWmiReader().RamInfo(info)) return;
+    std::lock_guard<std::mutex> l(g_StatsMutex);
+    g_RamInfo = info;
 }
 
+// Shares g_BenchRunning with the CPU benchmark so the two never overlap
+void StartMemBenchmark() {
+    if (g_BenchRunning || g_GpuBenchRunning) return;
+    g_BenchRunning = true;
+    g_BenchMode = L"Memory";
+    g_BenchProgress = 0;
+
+    std::thread([]() {
+        MemBenchConfig cfg;
+        BenchRecord record;
+        auto readTemp = []() { int t = g_BoardStats.Load().cpuTemp; return t > 0 ? (float)t : -1.0f; };
+        record.tempBefore = readTemp();
+        MemBenchResult r = RunMemBenchmark(cfg, [](int done, int total) { g_BenchProgress = done * 100 / total; });
+        record.tempAfter = readTemp();
+        MemBenchToRecord(cfg, r, record);
+        SaveBenchRecord(record);
+
+        g_MemLatency = r.latency.empty() ? 0.0f : (float)r.latency.back().ns;
+        g_MemBandwidth = (float)r.stream[(int)StreamKernel::Triad].median;
+        g_BenchProgress = 100;
+        g_BenchRunning = false;
+        }).detach();
+}
+
+// Pattern-tests half of the free memory on every core until the button is released.
+// Mismatches go to the console with address and bit, and the first one to the overlay.
 void StartRamStress() {
     g_RamStress = true;
     std::thread([]() {
-        std::vector<int*> ptrs;
+        MemTester tester;
+        MemTestConfig cfg;
+        g_RamTestVerified = 0;
+        g_RamTestErrors = 0;
+        g_RamTestPasses = 0;
+        g_RamTestFirstBit = -1;
+        if (!tester.Start(cfg)) { g_RamStress = false; g_RenderSignal.Post(RENDER_WAKE_DATA); return; }
+
+        size_t printed = 0;
         while (g_RamStress && g_AppRunning) {
-            try { ptrs.push_back(new int[1000000]); std::this_thread::sleep_for(std::chrono::milliseconds(100)); }
-            catch (...) { break; }
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            MemTestStatus s = tester.Status();
+            g_RamTestVerified = s.bytesVerified;
+            g_RamTestPasses = s.passesDone;
+            g_RamTestErrors = s.errors;
+            if (s.errors > printed) {
+                std::vector<MemTestError> errors = tester.Errors();
+                if (printed == 0 && !errors.empty()) {
+                    g_RamTestFirstError = errors[0].address;
+                    uint64_t bits = errors[0].FlippedBits();
+                    int bit = 0; while (!(bits & 1)) { bits >>= 1; bit++; }
+                    g_RamTestFirstBit = bit;
+                }
+                for (; printed < errors.size(); printed++) fprintf(stderr, "RAM error: %s\n", FormatMemTestError(errors[printed]).c_str());
+            }
+            g_RenderSignal.Post(RENDER_WAKE_DATA);
         }
-        for (auto p : ptrs) delete[] p;
+        tester.Stop();
         g_RamStress = false;
+        g_RenderSignal.Post(RENDER_WAKE_DATA);
         }).detach();
 }
\ No newline at end of file
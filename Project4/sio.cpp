@@ -0,0 +1,172 @@
+#include "shared.hpp"
+#include "Nct6687.hpp"
+#include "PortTrace.hpp"
+#include "SuperIo.hpp"
+#include <memory>
+
+// Fan Control State
+int g_FanSpeedPct = 50;
+bool g_FanControlActive = false;
+std::atomic<bool> g_FanAuto = false;
+FanController g_FanController;
+const SioChip* g_SioChip = nullptr;
+int g_SioPort = 0;
+int g_SioBaseAddr = 0;
+
+// InpOut32 Driver Pointers
+typedef void(__stdcall* lpOut32)(short, short);
+typedef short(__stdcall* lpInp32)(short);
+HINSTANCE g_hInpOutDll = NULL;
+
+std::mutex g_IoMutex;
+
+// ---------------------------------------------------------
+//  INPOUT BACKEND
+// ---------------------------------------------------------
+class InpOutPortIo : public IPortIo {
+public:
+    InpOutPortIo(lpOut32 out, lpInp32 inp) : out32(out), inp32(inp) {}
+    uint8_t In8(uint16_t port) override { return (uint8_t)(inp32((short)port) & 0xFF); }
+    void Out8(uint16_t port, uint8_t value) override { out32((short)port, (short)value); }
+private:
+    lpOut32 out32;
+    lpInp32 inp32;
+};
+
+IPortIo* g_PortIo = nullptr;
+static IPortIo* s_DriverIo = nullptr;
+
+// ---------------------------------------------------------
+//  PORT TRACE
+//  Swaps a recording wrapper in front of the driver. Started before
+//  the driver loads, the capture includes detection; started later, the
+//  header carries the chip already found so replay can skip it.
+// ---------------------------------------------------------
+bool g_SioTraceEnabled = false;
+std::wstring g_SioTracePath = L"sio_trace";
+static std::unique_ptr<TracingPortIo> s_Tracer;
+
+// Under g_IoMutex, with the driver loaded
+static bool OpenSioTrace() {
+    SYSTEMTIME st; GetLocalTime(&st);
+    wchar_t stamp[32];
+    swprintf_s(stamp, L"-%04d%02d%02d-%02d%02d%02d.ptrace", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    if (!s_Tracer) s_Tracer = std::make_unique<TracingPortIo>(*s_DriverIo);
+    return s_Tracer->Open(g_SioTracePath + stamp, (uint16_t)g_DetectedChipID, (uint16_t)g_SioBaseAddr);
+}
+
+void StartSioTrace() {
+    std::lock_guard<std::mutex> lock(g_IoMutex);
+    g_SioTraceEnabled = true;
+    if (!s_DriverIo || (s_Tracer && s_Tracer->IsOpen())) return;   // InitFanControl starts it once the driver loads
+    if (!OpenSioTrace()) { g_SioTraceEnabled = false; return; }
+    g_PortIo = s_Tracer.get();
+}
+
+void StopSioTrace() {
+    std::lock_guard<std::mutex> lock(g_IoMutex);
+    g_SioTraceEnabled = false;
+    if (!s_Tracer) return;
+    s_Tracer->Close();
+    if (g_PortIo) g_PortIo = s_DriverIo;    // The tracer stays alive; it is only ever reached under the lock
+}
+
+// ---------------------------------------------------------
+//  NCT6687D EC ACCESS (locked wrappers over Nct6687.cpp)
+// ---------------------------------------------------------
+int ReadNct6687_EC(int baseAddr, int logicalAddress) {
+    std::lock_guard<std::mutex> lock(g_IoMutex);
+    if (!g_PortIo) return 0;
+    return ReadNct6687_EC(*g_PortIo, baseAddr, logicalAddress);
+}
+
+void WriteNct6687_EC(int baseAddr, int logicalAddress, int value) {
+    std::lock_guard<std::mutex> lock(g_IoMutex);
+    if (!g_PortIo) return;
+    WriteNct6687_EC(*g_PortIo, baseAddr, logicalAddress, value);
+}
+
+int ReadNct6687_Block(int baseAddr, int startReg, int count, uint8_t out[]) {
+    std::lock_guard<std::mutex> lock(g_IoMutex);
+    if (!g_PortIo) return 0;
+    return ReadNct6687_Block(*g_PortIo, baseAddr, startReg, count, out);
+}
+
+// ---------------------------------------------------------
+//  FAN CONTROL
+//  The controller thread owns every PWM write; the slider and the
+//  Auto toggle only change its configuration.
+// ---------------------------------------------------------
+void SetFanSpeed(int pct) {
+    g_FanSpeedPct = pct;
+    g_FanAuto = false;
+    g_FanController.SetManualAll(pct);
+}
+
+void SetFanAuto(bool on) {
+    g_FanAuto = on;
+    if (on) g_FanController.SetAutoAll();
+    else g_FanController.SetManualAll(g_FanSpeedPct);
+}
+
+static void StartFanController() {
+    static Nct6687FanWriter writer(g_PortIo, g_IoMutex, g_SioBaseAddr);
+    // Only the EC's request/commit protocol is implemented; other chips are read-only
+    if (!g_SioChip || g_SioChip->family != SioFamily::NuvotonEc || g_SioBaseAddr == 0 || g_FanController.Running()) return;
+    g_FanController.SetManualAll(g_FanSpeedPct);   // Hold the slider's value until told otherwise
+    g_FanController.Start(g_Sensors, writer);
+}
+
+// ---------------------------------------------------------
+//  HARDWARE DETECTION
+//  Runs once, on whichever thread asks first (normally InitSystemInfo).
+//  Detection works on a local pointer; g_PortIo and the chip globals
+//  are published together under the I/O lock, and s_FanReady after
+//  them, so a thread that sees it set sees everything detection found.
+// ---------------------------------------------------------
+static std::once_flag s_FanInitOnce;
+static std::atomic<bool> s_FanReady{ false };
+
+// Under g_IoMutex
+static void DetectHardware(IPortIo& io) {
+    SioDetectResult found;
+    bool ok = DetectSuperIo(io, found);
+    if (found.lastId) g_DebugID = found.lastId;
+    if (!ok) return;
+    g_DetectedChipID = found.chipId;
+    g_SioChip = found.chip;
+    g_SioPort = found.port;
+    g_SioBaseAddr = found.baseAddr;
+}
+
+static void InitFanControlOnce() {
+    g_hInpOutDll = LoadLibraryW(L"inpoutx64.dll");
+    if (!g_hInpOutDll) g_hInpOutDll = LoadLibraryW(L"inpout32.dll");
+    if (!g_hInpOutDll) return;
+    lpOut32 out32 = (lpOut32)GetProcAddress(g_hInpOutDll, "Out32");
+    lpInp32 inp32 = (lpInp32)GetProcAddress(g_hInpOutDll, "Inp32");
+    if (!out32 || !inp32) return;
+
+    static InpOutPortIo inpOut(out32, inp32);
+    {
+        std::lock_guard<std::mutex> lock(g_IoMutex);
+        s_DriverIo = &inpOut;
+        IPortIo* io = &inpOut;
+        // Armed before the driver loaded: the capture starts here, so it includes detection
+        if (g_SioTraceEnabled) {
+            if (OpenSioTrace()) io = s_Tracer.get();
+            else g_SioTraceEnabled = false;
+        }
+        DetectHardware(*io);
+        g_PortIo = io;
+    }
+    s_FanReady.store(true, std::memory_order_release);
+    StartFanController();
+}
+
+bool InitFanControl() {
+    std::call_once(s_FanInitOnce, InitFanControlOnce);
+    return FanControlReady();
+}
+
+bool FanControlReady() { return s_FanReady.load(std::memory_order_acquire); }
@@ -2,7 +2,7 @@
 #include <pdh.h>
 
 // --- DEFINITIONS ---
-std::vector<std::wstring> g_DriveInfo;
+SeqLock<StorageStats> g_StorageStats;
 
 PDH_HQUERY g_PdhQuery = NULL;
 PDH_HCOUNTER g_Read = NULL, g_Write = NULL;
@@ -14,23 +14,23 @@ void InitDiskPdh() {
     PdhCollectQueryData(g_PdhQuery);
 }
 
-void UpdateDiskIo() {
-    if (!g_PdhQuery) return;
+PollResult UpdateDiskIo() {
+    if (!g_PdhQuery) return PollResult::Stable;
     PdhCollectQueryData(g_PdhQuery);
+    return PollResult::Stable;
 }
 
-void CheckStorage() {
-    while (g_AppRunning) {
-        DWORD mask = GetLogicalDrives();
-        std::vector<std::wstring> drvs;
-        for (wchar_t c = 'A'; c <= 'Z'; c++) {
-            if (mask & 1) {
-                std::wstring r = L" :\\"; r[0] = c;
-                drvs.push_back(r);
-            }
-            mask >>= 1;
+PollResult PollStorage() {
+    DWORD mask = GetLogicalDrives();
+    StorageStats stats;
+    for (wchar_t c = 'A'; c <= 'Z'; c++) {
+        if (mask & 1) {
+            wchar_t* r = stats.drives[stats.driveCount++];
+            r[0] = c; r[1] = L':'; r[2] = L'\\'; r[3] = 0;
         }
-        { std::lock_guard<std::mutex> l(g_StatsMutex); g_DriveInfo = drvs; }
-        Sleep(5000);
+        mask >>= 1;
     }
-}
\ No newline at end of file
+    StorageStats prev = g_StorageStats.Load();
+    g_StorageStats.Store(stats);
+    return memcmp(&prev, &stats, sizeof(stats)) != 0 ? PollResult::Changed : PollResult::Stable;
+}
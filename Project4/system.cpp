@@ -1,363 +1,211 @@
 #include "shared.hpp"
-#include "ChipDefs.hpp"
-#include <fstream>
+#include "SuperIo.hpp"
+#include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <thread>
 #include <iomanip>
 
 // Global Definitions
 std::wstring g_MoboName = L"Detecting...";
 std::wstring g_BiosWmi = L"...";
-int g_GlobalThreads = 0;
-int g_ContextSwitches = 0;
 
 std::wstring g_UpgradePath = L"";
 std::wstring g_BiosAnalysis = L"";
 std::wstring g_AgesaVersion = L"";
 
-bool g_HasBattery = false;
-int g_BatteryPct = 0;
-std::wstring g_BatteryTime = L"";
-
 // Detailed Sensors
 int g_DetectedChipID = 0;
 int g_DebugID = 0;
-float g_Volt12V = 0.0f;
-float g_Volt5V = 0.0f;
-float g_VoltVCore = 0.0f;
-float g_VoltDram = 0.0f;
-float g_VoltSoC = 0.0f;
-int g_TempVRM = 0;
-int g_TempPCH = 0;
-int g_TempSocket = 0;
-int g_TempSystem = 0;
-int g_FanRPM = 0;
+SeqLock<BoardStats> g_BoardStats;
+SeqLock<BatteryStats> g_BatteryStats;
+SensorHub g_Sensors;
 
-// Fan Control State
-int g_FanSpeedPct = 50;
-int g_AppliedFanSpeed = -1;
-bool g_FanControlActive = false;
-int g_SioPort = 0;
-int g_SioBaseAddr = 0;
+// History: slot -> hub sensor id. Detail sensors (per-core) may use at most half the slots.
+constexpr int HISTORY_SENSORS = 64;
+SensorHistory g_History(HISTORY_SENSORS);
+static std::atomic<int> s_HistorySensor[HISTORY_SENSORS];
+static std::atomic<int> s_HistorySlots{ 0 };
 
-// Logging
+// Logging: g_LogPath is the stem; each session gets its own timestamped .tlog
 bool g_LoggingEnabled = false;
-std::wstring g_LogPath = L"stats_log.csv";
-std::thread g_LogThread;
-
-// InpOut32 Driver Pointers
-typedef void(__stdcall* lpOut32)(short, short);
-typedef short(__stdcall* lpInp32)(short);
-lpOut32 g_Out32 = NULL;
-lpInp32 g_Inp32 = NULL;
-HINSTANCE g_hInpOutDll = NULL;
-
-std::mutex g_IoMutex;
-
-// ---------------------------------------------------------
-//  NCT6687D EC ACCESS
-// ---------------------------------------------------------
-int ReadNct6687_EC(int baseAddr, int logicalAddress) {
-    if (!g_Out32 || !g_Inp32 || baseAddr == 0) return 0;
-    std::lock_guard<std::mutex> lock(g_IoMutex);
-
-    int pagePort = baseAddr + 0x04;
-    int indexPort = baseAddr + 0x05;
-    int dataPort = baseAddr + 0x06;
-
-    // Spin wait for access
-    int timeout = 1000;
-    while ((g_Inp32(pagePort) & 0xFF) != 0xFF && timeout > 0) {
-        for (int i = 0; i < 100; i++) _mm_pause();
-        timeout--;
-    }
-    if (timeout <= 0) g_Out32(pagePort, 0xFF); // Force
-
-    g_Out32(pagePort, (logicalAddress >> 8) & 0xFF);
-    g_Out32(indexPort, logicalAddress & 0xFF);
-    int result = g_Inp32(dataPort) & 0xFF;
-    g_Out32(pagePort, 0xFF);
-
-    return result;
-}
+std::wstring g_LogPath = L"stats_log";
+TelemetryLogWriter g_TelemetryLog;
 
-void WriteNct6687_EC(int baseAddr, int logicalAddress, int value) {
-    if (!g_Out32 || !g_Inp32 || baseAddr == 0) return;
-    std::lock_guard<std::mutex> lock(g_IoMutex);
+// Export: the hub in shared memory for other processes (see TelemetryShm.h)
+TelemetryExporter g_TelemetryExport;
 
-    int pagePort = baseAddr + 0x04;
-    int indexPort = baseAddr + 0x05;
-    int dataPort = baseAddr + 0x06;
-
-    int timeout = 1000;
-    while ((g_Inp32(pagePort) & 0xFF) != 0xFF && timeout > 0) {
-        for (int i = 0; i < 100; i++) _mm_pause();
-        timeout--;
+PollResult UpdateBattery() {
+    SYSTEM_POWER_STATUS sps;
+    if (GetSystemPowerStatus(&sps)) {
+        BatteryStats stats;
+        stats.present = (sps.BatteryFlag != 128 && sps.BatteryFlag != 255);
+        if (stats.present) {
+            stats.pct = sps.BatteryLifePercent;
+            stats.charging = (sps.ACLineStatus == 1);
+            stats.lifeSeconds = (sps.BatteryLifeTime != (DWORD)-1 && sps.ACLineStatus == 0) ? (int)sps.BatteryLifeTime : -1;
+        }
+        BatteryStats prev = g_BatteryStats.Load();
+        g_BatteryStats.Store(stats);
+        if (stats.present && stats.pct < 10) return PollResult::Urgent;
+        return (stats.present != prev.present || stats.charging != prev.charging || stats.pct != prev.pct) ? PollResult::Changed : PollResult::Stable;
     }
-    if (timeout <= 0) g_Out32(pagePort, 0xFF);
-
-    g_Out32(pagePort, (logicalAddress >> 8) & 0xFF);
-    g_Out32(indexPort, logicalAddress & 0xFF);
-    g_Out32(dataPort, value & 0xFF);
-    g_Out32(pagePort, 0xFF);
-}
-
-float ReadNct6687_Temp(int baseAddr, int reg) {
-    int val = ReadNct6687_EC(baseAddr, reg);
-    int frac = ReadNct6687_EC(baseAddr, reg + 1);
-    return (float)val + ((frac & 0x80) ? 0.5f : 0.0f);
+    return PollResult::Stable;
 }
 
-float ReadNct6687_Voltage(int baseAddr, int reg, float multiplier) {
-    int high = ReadNct6687_EC(baseAddr, reg);
-    int low = ReadNct6687_EC(baseAddr, reg + 1);
-    float val = 0.001f * ((high << 4) | (low >> 4));
-    return val * multiplier;
+void ReadStats(StatsSnapshot& out) {
+    g_CpuStats.Load(out.cpu);
+    g_BoardStats.Load(out.board);
+    g_MemStats.Load(out.mem);
+    g_GpuStats.Load(out.gpu);
+    g_StorageStats.Load(out.storage);
+    g_BatteryStats.Load(out.battery);
 }
 
-int ReadNct6687_Fan(int baseAddr, int reg) {
-    int high = ReadNct6687_EC(baseAddr, reg);
-    int low = ReadNct6687_EC(baseAddr, reg + 1);
-    return (high << 8) | low;
+void InitSystemInfo() {
+    InitFanControl();
+    std::wstring product = GetWmiReader().BoardProduct();
+    if (!product.empty()) {
+        std::lock_guard<std::mutex> l(g_StatsMutex);
+        g_MoboName = product;
+        if (g_DetectedChipID != 0) {
+            std::wstringstream ss;
+            ss << L" (" << g_SioChip->name << L" @ " << std::hex << g_SioBaseAddr << L")";
+            g_MoboName += ss.str();
+        }
+        else {
+            std::wstringstream ss; ss << L" (Scanning... ID:" << std::hex << g_DebugID << L")";
+            g_MoboName += ss.str();
+        }
+    }
 }
 
-// ---------------------------------------------------------
-//  FAN CONTROL WRITING
-// ---------------------------------------------------------
-void ApplyFanSpeedInternal(int pct) {
-    if (g_SioBaseAddr == 0) return;
-    if (pct < 0) pct = 0; if (pct > 100) pct = 100;
-    int pwm = (int)(pct * 2.55f);
-
-    // Fans 0-5
-    for (int i = 0; i < 6; i++) {
-        int cmdReg = 0xA28 + i;
-        int modeReg = 0xA00;
-        int reqReg = 0xA01;
-
-        WriteNct6687_EC(g_SioBaseAddr, reqReg, 0x80); // Request
-        Sleep(20);
-
-        int curMode = ReadNct6687_EC(g_SioBaseAddr, modeReg);
-        if ((curMode & (1 << i)) == 0) {
-            WriteNct6687_EC(g_SioBaseAddr, modeReg, curMode | (1 << i)); // Manual Mode
+// Both board tasks run on the poll scheduler thread, so they share one copy
+static BoardStats s_Board;
+
+PollResult PollBoard() {
+    static SuperIoProvider sio(g_PortIo, g_IoMutex, g_SioChip, g_SioBaseAddr);
+    static int sioProvider = -1;
+    if (!FanControlReady() || !g_SioChip || g_SioChip->detectOnly || g_SioBaseAddr == 0) return PollResult::Stable;
+    if (sioProvider < 0) sioProvider = g_Sensors.Add(&sio);
+
+    float v[SIO_SENSOR_COUNT];
+    if (sioProvider < 0 || !g_Sensors.Poll(sioProvider, v)) return PollResult::Stable;
+    // Inputs the chip's family lacks read as 0
+    auto value = [&v](SioSensor s) { int slot = sio.Slot(s); return slot >= 0 ? v[slot] : 0.0f; };
+
+    BoardStats prev = s_Board;
+    float tCpu = value(SIO_TEMP_CPU);
+    if (tCpu > 0 && tCpu < 115) s_Board.cpuTemp = (int)tCpu;
+    s_Board.tempSystem = (int)value(SIO_TEMP_SYSTEM);
+    s_Board.tempVRM = (int)value(SIO_TEMP_VRM);
+    s_Board.tempPCH = (int)value(SIO_TEMP_PCH);
+    s_Board.tempSocket = (int)value(SIO_TEMP_SOC);
+
+    s_Board.volt12V = value(SIO_VOLT_12V);
+    s_Board.volt5V = value(SIO_VOLT_5V);
+    s_Board.voltVCore = value(SIO_VOLT_VCORE);
+    s_Board.voltDram = value(SIO_VOLT_DRAM);
+    s_Board.voltSoC = value(SIO_VOLT_SOC);
+
+    s_Board.fanRPM = (int)value(SIO_FAN_CPU);
+    g_BoardStats.Store(s_Board);
+
+    if (s_Board.cpuTemp >= 85 || s_Board.tempVRM >= 100) return PollResult::Urgent;
+    int dTemp = (std::max)({ abs(s_Board.cpuTemp - prev.cpuTemp), abs(s_Board.tempVRM - prev.tempVRM), abs(s_Board.tempSystem - prev.tempSystem) });
+    bool moved = dTemp >= 2 || fabsf(s_Board.voltVCore - prev.voltVCore) >= 0.05f || abs(s_Board.fanRPM - prev.fanRPM) >= 100;
+    return moved ? PollResult::Changed : PollResult::Stable;
+}
+
+PollResult PollSystemCounters() {
+    // Refresher-backed: the perf object is bound once and refreshed in place
+    WmiSystemCounters counters;
+    if (!GetWmiReader().SystemCounters(counters)) return PollResult::Stable;
+
+    int prevThreads = s_Board.globalThreads;
+    s_Board.globalThreads = counters.threads;
+    s_Board.contextSwitches = counters.contextSwitchesPerSec;
+    g_BoardStats.Store(s_Board);
+    return abs(s_Board.globalThreads - prevThreads) >= 50 ? PollResult::Changed : PollResult::Stable;
+}
+
+PollResult PollHistory() {
+    static int seen = 0, detailSlots = 0;
+    int slots = s_HistorySlots.load(std::memory_order_relaxed);
+    for (int total = g_Sensors.SensorCount(); seen < total && slots < HISTORY_SENSORS; seen++) {
+        if (g_Sensors.Sensor(seen).detail) {
+            if (detailSlots >= HISTORY_SENSORS / 2) continue;
+            detailSlots++;
         }
-
-        WriteNct6687_EC(g_SioBaseAddr, cmdReg, pwm); // PWM
-        WriteNct6687_EC(g_SioBaseAddr, reqReg, 0x40); // Commit
-        Sleep(20);
+        s_HistorySensor[slots++].store(seen, std::memory_order_relaxed);
     }
-}
+    s_HistorySlots.store(slots, std::memory_order_release);
 
-void SetFanSpeed(int pct) {
-    g_FanSpeedPct = pct;
+    float values[HISTORY_SENSORS];
+    for (int i = 0; i < slots; i++) values[i] = g_Sensors.Value(s_HistorySensor[i].load(std::memory_order_relaxed));
+    g_History.Record((int64_t)time(nullptr), values, slots);
+    return PollResult::Stable;
 }
 
-// ---------------------------------------------------------
-//  HARDWARE DETECTION (WITH UNLOCK FIX)
-// ---------------------------------------------------------
-void DetectHardware() {
-    if (g_DetectedChipID != 0) return;
-
-    std::lock_guard<std::mutex> lock(g_IoMutex);
-
-    int ports[] = { 0x4E, 0x2E };
-    for (int port : ports) {
-        if (g_Out32) {
-            g_Out32(port, 0x87); g_Out32(port, 0x87); // Enter Config
-
-            g_Out32(port, 0x20); int high = g_Inp32(port + 1);
-            g_Out32(port, 0x21); int low = g_Inp32(port + 1);
-            int id = (high << 8) | low;
+bool ExportHistory(int64_t seconds) {
+    int slots = s_HistorySlots.load(std::memory_order_acquire);
+    const char* names[HISTORY_SENSORS];
+    for (int i = 0; i < slots; i++) names[i] = g_Sensors.Sensor(s_HistorySensor[i].load(std::memory_order_relaxed)).name;
 
-            if (id != 0 && id != 0xFFFF) g_DebugID = id;
-
-            if (id == CHIP_NCT6687D || id == CHIP_NCT6687D_R) {
-                g_DetectedChipID = id;
-                g_SioPort = port;
-
-                // --- KEY FIX: UNLOCK IO SPACE ---
-                // Write to 0x28 to clear bit 4 (Lock Bit)
-                g_Out32(port, 0x28);
-                int options = g_Inp32(port + 1);
-                if ((options & 0x10) > 0) {
-                    g_Out32(port + 1, options & ~0x10);
-                }
-
-                // Select HWM (0x0B)
-                g_Out32(port, 0x07); g_Out32(port + 1, 0x0B);
-
-                // Force Active
-                g_Out32(port, 0x30);
-                if ((g_Inp32(port + 1) & 0x01) == 0) g_Out32(port + 1, 0x01);
-
-                // Get Base Address
-                g_Out32(port, 0x60); int h = g_Inp32(port + 1);
-                g_Out32(port, 0x61); int l = g_Inp32(port + 1);
-                g_SioBaseAddr = ((h << 8) | l) & 0xFFF8;
-
-                g_Out32(port, 0xAA); // Exit Config
-                return;
-            }
-            g_Out32(port, 0xAA); // Exit Config
-        }
-    }
+    SYSTEMTIME st; GetLocalTime(&st);
+    wchar_t path[64];
+    swprintf_s(path, L"history-%04d%02d%02d-%02d%02d%02d.csv", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    std::ofstream file(path);
+    if (!file) return false;
+    int64_t now = (int64_t)time(nullptr), from = now - seconds;
+    g_History.WriteCsv(file, g_History.BestTier(from, now, HISTORY_EXPORT_POINTS, now), from, now, names, slots);
+    return (bool)file;
 }
 
-bool InitFanControl() {
-    if (g_hInpOutDll) return true;
-    g_hInpOutDll = LoadLibraryW(L"inpoutx64.dll");
-    if (!g_hInpOutDll) g_hInpOutDll = LoadLibraryW(L"inpout32.dll");
-    if (g_hInpOutDll) {
-        g_Out32 = (lpOut32)GetProcAddress(g_hInpOutDll, "Out32");
-        g_Inp32 = (lpInp32)GetProcAddress(g_hInpOutDll, "Inp32");
-        if (g_Out32 && g_Inp32) {
-            DetectHardware();
-            return true;
-        }
+int FindHistorySlot(const char* sensorName) {
+    int slots = s_HistorySlots.load(std::memory_order_acquire);
+    for (int i = 0; i < slots; i++) {
+        if (strcmp(g_Sensors.Sensor(s_HistorySensor[i].load(std::memory_order_relaxed)).name, sensorName) == 0) return i;
     }
-    return false;
+    return -1;
 }
 
-void UpdateBattery() {
-    SYSTEM_POWER_STATUS sps;
-    if (GetSystemPowerStatus(&sps)) {
-        std::lock_guard<std::mutex> l(g_StatsMutex);
-        g_HasBattery = (sps.BatteryFlag != 128 && sps.BatteryFlag != 255);
-        if (g_HasBattery) {
-            g_BatteryPct = sps.BatteryLifePercent;
-            if (sps.BatteryLifeTime != -1 && sps.ACLineStatus == 0) {
-                wchar_t buf[32]; swprintf_s(buf, L"%dh %02dm", sps.BatteryLifeTime / 3600, (sps.BatteryLifeTime % 3600) / 60);
-                g_BatteryTime = buf;
-            }
-            else {
-                g_BatteryTime = (sps.ACLineStatus == 1) ? L"Charging" : L"...";
-            }
-        }
+// Every hub sensor at 2 Hz. Rows go through the writer's lock-free queue,
+// so this task never touches the disk.
+PollResult PollLog() {
+    if (!g_TelemetryLog.IsOpen()) return PollResult::Stable;
+    for (int id = g_TelemetryLog.ColumnCount(); id < g_Sensors.SensorCount(); id++) {
+        if (g_TelemetryLog.AddColumn(g_Sensors.Sensor(id)) < 0) break;
     }
+    static float row[MAX_SENSORS];
+    int count = g_TelemetryLog.ColumnCount();
+    for (int id = 0; id < count; id++) row[id] = g_Sensors.Value(id);
+    g_TelemetryLog.Push(TelemetryNowMs(), row, count);
+    return PollResult::Stable;
 }
 
-WmiQuery::WmiQuery() { CoInitializeEx(0, COINIT_MULTITHREADED); }
-WmiQuery::~WmiQuery() { if (pSvc) pSvc->Release(); if (pLoc) pLoc->Release(); CoUninitialize(); }
-bool WmiQuery::Init(const std::wstring& namesSpace) {
-    HRESULT hres = CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER, IID_IWbemLocator, (LPVOID*)&pLoc);
-    if (FAILED(hres)) return false;
-    hres = pLoc->ConnectServer(_bstr_t(namesSpace.c_str()), NULL, NULL, 0, NULL, 0, 0, &pSvc);
-    if (FAILED(hres)) return false;
-    hres = CoSetProxyBlanket(pSvc, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL, RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE);
-    return SUCCEEDED(hres);
-}
-IEnumWbemClassObject* WmiQuery::Exec(const std::wstring& query) {
-    if (!pSvc) return nullptr;
-    IEnumWbemClassObject* pEnum = nullptr;
-    pSvc->ExecQuery(bstr_t("WQL"), bstr_t(query.c_str()), WBEM_FLAG_FORWARD_ONLY, NULL, &pEnum);
-    return pEnum;
+void StartLogging() {
+    if (g_LoggingEnabled) return;
+    SYSTEMTIME st; GetLocalTime(&st);
+    wchar_t stamp[32];
+    swprintf_s(stamp, L"-%04d%02d%02d-%02d%02d%02d.tlog", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    g_LoggingEnabled = g_TelemetryLog.Open(g_LogPath + stamp);
 }
 
-static std::wstring GetVariantString(IWbemClassObject* pObj, const std::wstring& prop) {
-    VARIANT v; pObj->Get(prop.c_str(), 0, &v, 0, 0);
-    std::wstring res = (v.vt == VT_BSTR) ? v.bstrVal : L"Unknown";
-    VariantClear(&v); return res;
-}
-static int GetVariantInt(IWbemClassObject* pObj, const std::wstring& prop) {
-    VARIANT v; pObj->Get(prop.c_str(), 0, &v, 0, 0);
-    int res = (v.vt == VT_I4) ? v.intVal : (v.vt == VT_UI4) ? (int)v.uintVal : 0;
-    VariantClear(&v); return res;
+void StopLogging() {
+    g_LoggingEnabled = false;
+    g_TelemetryLog.Close();
 }
 
-void MonitorSystem() {
-    InitFanControl();
-    WmiQuery wmi; wmi.Init();
-
-    IEnumWbemClassObject* pEnum = wmi.Exec(L"SELECT Product FROM Win32_BaseBoard");
-    if (pEnum) {
-        IWbemClassObject* pObj = nullptr; ULONG uRet = 0;
-        pEnum->Next(WBEM_INFINITE, 1, &pObj, &uRet);
-        if (uRet) {
-            std::lock_guard<std::mutex> l(g_StatsMutex);
-            g_MoboName = GetVariantString(pObj, L"Product");
-            if (g_DetectedChipID != 0) {
-                std::wstringstream ss;
-                ss << L" (NCT" << std::hex << (g_DetectedChipID >> 4) << L" @ " << g_SioBaseAddr << L")";
-                g_MoboName += ss.str();
-            }
-            else {
-                std::wstringstream ss; ss << L" (Scanning... ID:" << std::hex << g_DebugID << L")";
-                g_MoboName += ss.str();
-            }
-            pObj->Release();
-        }
-        pEnum->Release();
-    }
-
-    while (g_AppRunning) {
-        if ((g_DetectedChipID == CHIP_NCT6687D || g_DetectedChipID == CHIP_NCT6687D_R) && g_SioBaseAddr > 0) {
-            float tCpu = ReadNct6687_Temp(g_SioBaseAddr, 0x100);
-            float tSys = ReadNct6687_Temp(g_SioBaseAddr, 0x102);
-            float tMos = ReadNct6687_Temp(g_SioBaseAddr, 0x104);
-            float tPch = ReadNct6687_Temp(g_SioBaseAddr, 0x106);
-            float tSoc = ReadNct6687_Temp(g_SioBaseAddr, 0x108);
-
-            float v12 = ReadNct6687_Voltage(g_SioBaseAddr, 0x120, 12.0f);
-            float v5 = ReadNct6687_Voltage(g_SioBaseAddr, 0x122, 5.0f);
-            float vCore = ReadNct6687_Voltage(g_SioBaseAddr, 0x124, 1.0f);
-            float vDram = ReadNct6687_Voltage(g_SioBaseAddr, 0x128, 2.0f);
-            float vSoc = ReadNct6687_Voltage(g_SioBaseAddr, 0x12C, 1.0f);
-
-            int rpm = ReadNct6687_Fan(g_SioBaseAddr, 0x140);
-
-            {
-                std::lock_guard<std::mutex> l(g_StatsMutex);
-                if (tCpu > 0 && tCpu < 115) g_CpuTemp = (int)tCpu;
-                g_TempSystem = (int)tSys;
-                g_TempVRM = (int)tMos;
-                g_TempPCH = (int)tPch;
-                g_TempSocket = (int)tSoc;
-
-                g_Volt12V = v12;
-                g_Volt5V = v5;
-                g_VoltVCore = vCore;
-                g_VoltDram = vDram;
-                g_VoltSoC = vSoc;
-                g_FanRPM = rpm;
-            }
-
-            // Fan Control (Background Write)
-            if (g_FanSpeedPct != g_AppliedFanSpeed) {
-                ApplyFanSpeedInternal(g_FanSpeedPct);
-                g_AppliedFanSpeed = g_FanSpeedPct;
-            }
-        }
+PollResult PollExport() {
+    g_TelemetryExport.Publish(g_Sensors, TelemetryNowMs());
+    return PollResult::Stable;
+}
 
-        pEnum = wmi.Exec(L"SELECT Threads, ContextSwitchesPerSec FROM Win32_PerfFormattedData_PerfOS_System");
-        if (pEnum) {
-            IWbemClassObject* pObj = nullptr; ULONG uRet = 0;
-            pEnum->Next(WBEM_INFINITE, 1, &pObj, &uRet);
-            if (uRet) {
-                int t = GetVariantInt(pObj, L"Threads");
-                int c = GetVariantInt(pObj, L"ContextSwitchesPerSec");
-                { std::lock_guard<std::mutex> l(g_StatsMutex); g_GlobalThreads = t; g_ContextSwitches = c; }
-                pObj->Release();
-            }
-            pEnum->Release();
-        }
-        Sleep(500);
-    }
+bool StartExport() {
+    return g_TelemetryExport.IsOpen() || g_TelemetryExport.Open(TSHM_DEFAULT_NAME, EXPORT_INTERVAL_MS);
 }
 
-void LogWorker() {
-    std::ofstream file(g_LogPath, std::ios::app);
-    if (!file.is_open()) return;
-    file << "Timestamp,CPU_Usage,CPU_Temp\n";
-    while (g_LoggingEnabled && g_AppRunning) {
-        {
-            std::lock_guard<std::mutex> l(g_StatsMutex);
-            auto now = std::chrono::system_clock::now();
-            auto timeT = std::chrono::system_clock::to_time_t(now);
-            file << timeT << "," << g_CpuUsage << "," << g_CpuTemp << "\n";
-        }
-        file.flush(); Sleep(1000);
-    }
+void StopExport() {
+    g_TelemetryExport.Close();
 }
-void StartLogging() { if (g_LoggingEnabled) return; g_LoggingEnabled = true; g_LogThread = std::thread(LogWorker); g_LogThread.detach(); }
-void StopLogging() { g_LoggingEnabled = false; }
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+
+// ---------------------------------------------------------
+//  TEST CHECKS
+//  Every test is one standalone Linux program built with the line in
+//  its header comment. CHECK records a failure and carries on (it is
+//  safe from any thread); main returns TestResult(), non-zero on any
+//  failure.
+// ---------------------------------------------------------
+inline std::atomic<int> g_TestFailures{ 0 };
+
+#define CHECK(cond) do { if (!(cond)) { g_TestFailures++; fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); } } while (0)
+
+inline int TestResult(const char* name) {
+    int failures = g_TestFailures.load();
+    fprintf(stderr, "%s: %s\n", name, failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,143 @@
+// GpuMonitor against a scripted IGpuBackend: the adapter cache and the multi-adapter logic
+// without DXGI.
+//   1. The adapter list is enumerated once; every poll only queries usage, per adapter.
+//   2. "Changed" means an adapter came or went, or usage moved >= 1% of its memory
+//      (dedicated, else the budget for an integrated GPU).
+//   3. NeedsRefresh and a failed query (adapter lost) both lead to a fresh enumeration.
+// Build: g++ -std=c++20 -O2 -I.. gpu_monitor_test.cpp ../GpuMemory.cpp ../PollScheduler.cpp -lpthread -o gpu_monitor_test
+#include "../GpuMemory.hpp"
+#include "TestCheck.hpp"
+#include <cwchar>
+#include <vector>
+
+constexpr uint64_t GiB = 1ull << 30;
+
+struct FakeAdapter {
+    const wchar_t* name;
+    uint64_t dedicatedBytes;
+    GpuMemoryUsage usage;
+    bool lost = false;
+};
+
+class FakeGpuBackend : public IGpuBackend {
+public:
+    std::vector<FakeAdapter> adapters;
+    bool stale = false;
+    int enumerateCalls = 0;
+    int queryCalls = 0;
+
+    int EnumerateAdapters(GpuAdapterInfo* out, int max) override {
+        enumerateCalls++;
+        stale = false;
+        int n = 0;
+        for (const FakeAdapter& a : adapters) {
+            if (n == max) break;
+            if (a.lost) continue;
+            swprintf(out[n].name, 64, L"%ls", a.name);
+            out[n].dedicatedBytes = a.dedicatedBytes;
+            n++;
+        }
+        return n;
+    }
+    bool NeedsRefresh() override { return stale; }
+    bool QueryMemory(int adapter, GpuMemoryUsage& out) override {
+        queryCalls++;
+        if (adapter < 0 || adapter >= (int)adapters.size() || adapters[adapter].lost) return false;
+        out = adapters[adapter].usage;
+        return true;
+    }
+};
+
+static void TestCaching() {
+    FakeGpuBackend backend;
+    backend.adapters = {
+        { L"Discrete", 8 * GiB, { 1 * GiB, 7 * GiB } },
+        { L"Integrated", 0, { 256ull << 20, 2 * GiB } },
+        { L"Second discrete", 12 * GiB, { 3 * GiB, 11 * GiB } },
+    };
+    GpuMonitor monitor(backend);
+    CHECK(monitor.Poll() == PollResult::Changed);       // Adapters appeared
+    for (int i = 0; i < 50; i++) monitor.Poll();
+    CHECK(backend.enumerateCalls == 1 && monitor.EnumerationCount() == 1);
+    CHECK(backend.queryCalls == 51 * 3);
+
+    CHECK(monitor.AdapterCount() == 3);
+    CHECK(wcscmp(monitor.Adapter(1).info.name, L"Integrated") == 0);
+    CHECK(monitor.Adapter(0).usage.usedBytes == 1 * GiB);
+    CHECK(monitor.Adapter(1).usage.usedBytes == (256ull << 20));
+    CHECK(monitor.Adapter(2).info.dedicatedBytes == 12 * GiB && monitor.Adapter(2).usage.budgetBytes == 11 * GiB);
+}
+
+static void TestChangeThreshold() {
+    FakeGpuBackend backend;
+    backend.adapters = { { L"Discrete", 8 * GiB, { 1 * GiB, 7 * GiB } }, { L"Integrated", 0, { 0, 2 * GiB } } };
+    GpuMonitor monitor(backend);
+    monitor.Poll();
+    CHECK(monitor.Poll() == PollResult::Stable);
+
+    // 1% of the dedicated 8 GiB is ~82 MiB
+    backend.adapters[0].usage.usedBytes += 80ull << 20;
+    CHECK(monitor.Poll() == PollResult::Stable);
+    backend.adapters[0].usage.usedBytes += 90ull << 20;
+    CHECK(monitor.Poll() == PollResult::Changed);
+    backend.adapters[0].usage.usedBytes -= 90ull << 20;     // Falling counts too
+    CHECK(monitor.Poll() == PollResult::Changed);
+
+    // No dedicated memory: 1% of the 2 GiB budget (~20 MiB), on the second adapter alone
+    backend.adapters[1].usage.usedBytes += 30ull << 20;
+    CHECK(monitor.Poll() == PollResult::Changed);
+    backend.adapters[1].usage.usedBytes += 10ull << 20;
+    CHECK(monitor.Poll() == PollResult::Stable);
+
+    // Neither size known: usage alone never reports a change
+    backend.adapters[1].usage.budgetBytes = 0;
+    backend.adapters[1].usage.usedBytes += 1 * GiB;
+    CHECK(monitor.Poll() == PollResult::Stable);
+}
+
+static void TestRefresh() {
+    FakeGpuBackend backend;
+    backend.adapters = { { L"Discrete", 8 * GiB, { 1 * GiB, 7 * GiB } } };
+    GpuMonitor monitor(backend);
+    monitor.Poll();
+
+    // Hot-plug: the backend flags the list stale
+    backend.adapters.push_back({ L"eGPU", 16 * GiB, { 0, 15 * GiB } });
+    backend.stale = true;
+    CHECK(monitor.Poll() == PollResult::Changed);
+    CHECK(monitor.AdapterCount() == 2 && monitor.EnumerationCount() == 2);
+    CHECK(wcscmp(monitor.Adapter(1).info.name, L"eGPU") == 0);
+
+    // Driver reset: a query fails before the backend noticed; the next poll re-enumerates
+    backend.adapters[1].lost = true;
+    CHECK(monitor.Poll() == PollResult::Changed);
+    CHECK(monitor.EnumerationCount() == 2);
+    CHECK(monitor.Poll() == PollResult::Changed);
+    CHECK(monitor.AdapterCount() == 1 && monitor.EnumerationCount() == 3);
+    CHECK(monitor.Poll() == PollResult::Stable);
+
+    // Re-enumerating the same adapters is not a change in itself
+    backend.stale = true;
+    CHECK(monitor.Poll() == PollResult::Stable);
+    CHECK(monitor.EnumerationCount() == 4);
+
+    // One adapter swapped for another: same count, still a change
+    backend.adapters = { { L"Replacement", 4 * GiB, { 0, 3 * GiB } } };     // Idle: usage alone would not flag it
+    backend.stale = true;
+    CHECK(monitor.Poll() == PollResult::Changed);
+    CHECK(wcscmp(monitor.Adapter(0).info.name, L"Replacement") == 0 && monitor.Adapter(0).info.dedicatedBytes == 4 * GiB);
+
+    // Everything gone: no queries for adapters that no longer exist
+    backend.adapters.clear();
+    backend.stale = true;
+    int queries = backend.queryCalls;
+    CHECK(monitor.Poll() == PollResult::Changed);
+    CHECK(monitor.AdapterCount() == 0 && backend.queryCalls == queries);
+}
+
+int main() {
+    TestCaching();
+    TestChangeThreshold();
+    TestRefresh();
+    return TestResult("gpu_monitor_test");
+}
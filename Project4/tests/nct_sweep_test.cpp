@@ -0,0 +1,97 @@
+// Port-op budget of the NCT6687D sweep, against the simulated chip. Every op is a slow ISA
+// cycle (~1 us on real boards), so the count is the cost.
+//   1. The EC map plans into one page, five runs, 26 bytes, and a sweep costs exactly
+//      idle check + page select + index/data per byte + release = 55 ops, which is what
+//      SioSweep::PortOps() (the provider's cost estimate) predicts.
+//   2. The sweep returns the same bytes as reading every register on its own, at under
+//      half the ops.
+//   3. The planner: touching/overlapping pairs merge, pages split runs (one select each),
+//      a pair straddling a page and too many runs are refused. ReadNct6687_Block clamps to
+//      its page.
+// Build: g++ -std=c++20 -O2 -I.. nct_sweep_test.cpp ../Nct6687.cpp ../SuperIo.cpp ../SimSuperIo.cpp ../SensorHub.cpp ../FanControl.cpp -lpthread -o nct_sweep_test
+#include "../Nct6687.hpp"
+#include "../SimSuperIo.hpp"
+#include "../SuperIo.hpp"
+#include "TestCheck.hpp"
+
+constexpr int EC_BASE = 0xA20;
+constexpr uint64_t NCT6687D_SWEEP_OPS = 55;     // Raise only with a reason: every op is ~1 us on the board
+
+static uint64_t Ops(const SimSuperIo& sim) { return sim.Reads() + sim.Writes(); }
+
+static void TestEcSweep() {
+    const SioChip* chip = FindSioChip("NCT6687D");
+    CHECK(chip != nullptr);
+    if (!chip) return;
+    SimSuperIo sim(*chip, 0x4E, EC_BASE);
+    sim.Script(SimSensorKind::Temp, 0, { SimWaveform::Sine, 55.0f, 15.0f, 10.0f });
+    sim.Script(SimSensorKind::Fan, 0, { SimWaveform::Square, 1400.0f, 400.0f, 4.0f });
+    sim.SetTime(1.3);
+
+    SioSweep sweep;
+    CHECK(CompileSioSweep(SioMap(SioFamily::NuvotonEc), sweep));
+    CHECK(sweep.ec.runCount == 5 && sweep.ec.byteCount == 26);
+    CHECK(sweep.PortOps() == (int)NCT6687D_SWEEP_OPS);
+
+    uint8_t raw[SIO_MAX_SWEEP_BYTES] = {};
+    sim.ResetCounters();
+    RunSioSweep(sim, EC_BASE, sweep, raw);
+    uint64_t sweepOps = Ops(sim);
+    CHECK(sweepOps == NCT6687D_SWEEP_OPS);
+
+    // The same bytes one register at a time
+    sim.ResetCounters();
+    bool same = true;
+    for (int r = 0; r < sweep.ec.runCount; r++) {
+        const NctRun& run = sweep.ec.runs[r];
+        for (int i = 0; i < run.count; i++) same = same && ReadNct6687_EC(sim, EC_BASE, run.startReg + i) == raw[run.bufOffset + i];
+    }
+    uint64_t singleOps = Ops(sim);
+    CHECK(same);
+    CHECK(sweepOps * 2 < singleOps);
+    fprintf(stderr, "NCT6687D sweep: %llu ops for %d bytes (%llu reading them one by one)\n",
+        (unsigned long long)sweepOps, sweep.ec.byteCount, (unsigned long long)singleOps);
+}
+
+static void TestPlanner() {
+    NctSweepPlan plan;
+    // Touching (0x10/0x12) and overlapping (0x13 shares 0x12's low byte) pairs merge: 0x110..0x114
+    const uint16_t merged[] = { 0x112, 0x110, 0x113 };
+    CHECK(PlanNct6687_Sweep(merged, 3, plan));
+    CHECK(plan.runCount == 1 && plan.runs[0].startReg == 0x110 && plan.runs[0].count == 5 && plan.byteCount == 5);
+    CHECK(plan.offsets[0] == 2 && plan.offsets[1] == 0 && plan.offsets[2] == 3);
+
+    // Two pages: a run each, and the sweep selects each page once
+    const uint16_t paged[] = { 0x100, 0x102, 0x200, 0x104 };
+    CHECK(PlanNct6687_Sweep(paged, 4, plan));
+    CHECK(plan.runCount == 2 && plan.byteCount == 8);
+    const SioChip* chip = FindSioChip("NCT6687D");
+    if (chip) {
+        SimSuperIo sim(*chip, 0x4E, EC_BASE);
+        uint8_t out[NCT_MAX_SWEEP_BYTES];
+        sim.ResetCounters();
+        ReadNct6687_Sweep(sim, EC_BASE, plan, out);
+        CHECK(Ops(sim) == 1 + 2 + 2 * 8 + 1);
+
+        // A block read stops at the end of its page
+        sim.ResetCounters();
+        CHECK(ReadNct6687_Block(sim, EC_BASE, 0x1FC, 10, out) == 4);
+        CHECK(Ops(sim) == 1 + 1 + 2 * 4 + 1);
+    }
+
+    // A pair at 0x?FF would straddle two pages
+    const uint16_t straddle[] = { 0x1FF };
+    CHECK(!PlanNct6687_Sweep(straddle, 1, plan));
+
+    // More separate runs than the plan holds
+    uint16_t spread[NCT_MAX_RUNS + 1];
+    for (int i = 0; i <= NCT_MAX_RUNS; i++) spread[i] = (uint16_t)(0x100 + i * 4);
+    CHECK(!PlanNct6687_Sweep(spread, NCT_MAX_RUNS + 1, plan));
+    CHECK(PlanNct6687_Sweep(spread, NCT_MAX_RUNS, plan) && plan.runCount == NCT_MAX_RUNS);
+}
+
+int main() {
+    TestEcSweep();
+    TestPlanner();
+    return TestResult("nct_sweep_test");
+}
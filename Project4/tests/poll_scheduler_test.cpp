@@ -0,0 +1,111 @@
+// PollScheduler under a fake clock: RunDue is the scheduler thread's pass, and the loop below
+// sleeps exactly until the deadline it returns, so every pass counts as one thread wake-up.
+//   1. Idle with one stable 1 s task: one wake-up per second, not one per 10 ms tick.
+//   2. Tasks run on their own intervals, including ones longer than a turn of the wheel.
+//   3. Back-off: a stable task stretches to maxMs, a changing one shrinks to minMs, and an
+//      urgent result snaps straight back.
+//   4. Wake() runs a task on the next pass and it reschedules from that moment; a late pass
+//      (a slow task) runs everything it missed once, in due order.
+// Build: g++ -std=c++20 -O2 -I.. poll_scheduler_test.cpp ../PollScheduler.cpp -lpthread -o poll_scheduler_test
+#include "../PollScheduler.hpp"
+#include "TestCheck.hpp"
+#include <vector>
+
+// Sleeps to each deadline until 'endMs'; returns the number of passes (thread wake-ups)
+static int RunUntil(PollScheduler& s, int64_t& now, int64_t endMs) {
+    int passes = 0;
+    for (;;) {
+        int64_t next = s.RunDue(now);
+        passes++;
+        if (next == PollScheduler::NO_DEADLINE || next >= endMs) break;
+        CHECK(next > now);
+        if (next <= now) break;
+        now = next;
+    }
+    now = endMs;
+    return passes;
+}
+
+static PollTaskConfig Fixed(const char* name, int ms) { return { name, ms, ms, ms, 0 }; }
+
+static void TestIdleWakeups() {
+    PollScheduler s;        // Default 10 ms tick
+    int runs = 0;
+    s.Add(Fixed("slow", 1000), [&] { runs++; return PollResult::Stable; });
+    s.Wake(0);              // What Start() does: the first poll is immediate
+    int64_t now = 0;
+    int passes = RunUntil(s, now, 10000);
+    fprintf(stderr, "idle, one 1 s task: %d wake-ups and %d runs in 10 s\n", passes, runs);
+    CHECK(runs >= 9 && runs <= 10);
+    CHECK(passes <= runs + 1);
+    CHECK(s.Stats(0).runs == (uint64_t)runs);
+}
+
+static void TestIntervals() {
+    PollScheduler s;
+    std::vector<int64_t> fast, slow;
+    int64_t now = 0;
+    s.Add(Fixed("fast", 250), [&] { fast.push_back(now); return PollResult::Stable; });
+    s.Add(Fixed("slow", 5000), [&] { slow.push_back(now); return PollResult::Stable; });     // 500 ticks: two turns of the wheel
+    for (int i = 0; i < 2; i++) s.Wake(i);
+    int64_t next = s.RunDue(0);
+    CHECK(fast.size() == 1 && slow.size() == 1);
+    CHECK(next == 250);
+    while (next < 20000) { now = next; next = s.RunDue(now); }
+    CHECK(fast.size() == 80);
+    CHECK(slow.size() == 4 && slow[1] == 5000 && slow[3] == 15000);
+    for (size_t i = 1; i < fast.size(); i++) CHECK(fast[i] - fast[i - 1] == 250);
+}
+
+static void TestBackoff() {
+    PollScheduler s;
+    PollResult result = PollResult::Stable;
+    s.Add({ "adaptive", 250, 4000, 1000, 0 }, [&] { return result; });
+    s.Wake(0);
+    int64_t now = 0;
+    RunUntil(s, now, 60000);
+    CHECK(s.Stats(0).intervalMs == 4000);
+    result = PollResult::Changed;
+    RunUntil(s, now, 80000);
+    CHECK(s.Stats(0).intervalMs == 250);
+
+    result = PollResult::Stable;
+    RunUntil(s, now, 140000);
+    CHECK(s.Stats(0).intervalMs == 4000);
+    result = PollResult::Urgent;
+    s.Wake(0);
+    s.RunDue(now);
+    CHECK(s.Stats(0).intervalMs == 250);
+}
+
+static void TestWakeAndLatePass() {
+    PollScheduler s;
+    std::vector<int> order;
+    s.Add(Fixed("a", 1000), [&] { order.push_back(0); return PollResult::Stable; });
+    s.Add(Fixed("b", 600), [&] { order.push_back(1); return PollResult::Stable; });
+    s.Wake(0);
+    s.Wake(1);
+    CHECK(s.RunDue(0) == 600);
+
+    // Woken at 400 ms: runs then, and is next due a full interval later
+    order.clear();
+    s.Wake(0);
+    CHECK(s.RunDue(400) == 600);
+    CHECK(order == std::vector<int>{ 0 });
+    CHECK(s.RunDue(600) == 1200);       // b; a is due at 1400
+
+    // A pass 3 s late: each missed task runs once, the earlier-due first, and both
+    // reschedule from the late pass
+    order.clear();
+    CHECK(s.RunDue(4200) == 4800);
+    CHECK((order == std::vector<int>{ 1, 0 }));
+    CHECK(s.RunDue(4800) == 5200);
+}
+
+int main() {
+    TestIdleWakeups();
+    TestIntervals();
+    TestBackoff();
+    TestWakeAndLatePass();
+    return TestResult("poll_scheduler_test");
+}
@@ -0,0 +1,121 @@
+// RenderPacer under a fake clock: the render loop is replayed in simulated microseconds
+// (sleep WaitUs, then BeginFrame), so every present time is exact and the run is instant.
+//   1. Idle never wakes; a post presents on the next vblank, and posts within a period coalesce.
+//   2. A wake-up a little early presents in this slot; a late one presents at once, never skips.
+//   3. The fps cap rounds to whole refresh periods and presents stay on the vblank grid.
+//   4. WakeAt timers, the earliest winning, and a shifted vblank phase.
+// Build: g++ -std=c++20 -O2 -I.. render_pacer_test.cpp ../RenderScheduler.cpp -lpthread -o render_pacer_test
+#include "../RenderScheduler.hpp"
+#include "TestCheck.hpp"
+#include <vector>
+
+constexpr int64_t PERIOD_60HZ = 16667;
+constexpr int64_t PERIOD_144HZ = 6944;
+
+struct Present {
+    int64_t timeUs;
+    uint32_t reasons;
+};
+
+// The overlay's loop with a fake clock: sleep what the pacer asks, render when it says so.
+// 'now' ends at the last wake-up before 'endUs' (or where the pacer went idle).
+static std::vector<Present> RunUntil(RenderPacer& pacer, int64_t& now, int64_t endUs) {
+    std::vector<Present> presents;
+    for (int spins = 0; now < endUs; ) {
+        int64_t wait = pacer.WaitUs(now);
+        if (wait == RenderPacer::WAIT_FOREVER || now + wait >= endUs) break;
+        now += wait;
+        uint32_t reasons = pacer.BeginFrame(now);
+        if (reasons) { presents.push_back({ now, reasons }); spins = 0; }
+        else if (++spins > 2) { CHECK(!"pacer keeps asking for zero-length waits"); break; }
+    }
+    return presents;
+}
+
+static bool OnGrid(int64_t t, int64_t period, int64_t phase) { return (t - phase) % period == 0; }
+
+static void TestIdleAndCoalesce() {
+    RenderPacer pacer;
+    pacer.SetRefresh(PERIOD_60HZ, 0);
+    CHECK(pacer.WaitUs(0) == RenderPacer::WAIT_FOREVER);
+    CHECK(pacer.BeginFrame(1000) == 0);
+
+    // Three events inside one period become a single present on the next vblank
+    pacer.Post(RENDER_WAKE_DATA, 1000);
+    CHECK(pacer.WaitUs(1000) == PERIOD_60HZ - 1000);
+    pacer.Post(RENDER_WAKE_INPUT, 5000);
+    pacer.Post(RENDER_WAKE_DATA, 12000);
+    int64_t now = 12000;
+    std::vector<Present> p = RunUntil(pacer, now, 200000);
+    CHECK(p.size() == 1);
+    CHECK(!p.empty() && p[0].timeUs == PERIOD_60HZ && p[0].reasons == (RENDER_WAKE_DATA | RENDER_WAKE_INPUT));
+    CHECK(pacer.WaitUs(now) == RenderPacer::WAIT_FOREVER);     // Consumed: idle again
+}
+
+static void TestEarlyAndLateWake() {
+    RenderPacer pacer;
+    pacer.SetRefresh(PERIOD_60HZ, 0);
+
+    // Timer granularity: waking up to a quarter period early still presents in this slot
+    pacer.Post(RENDER_WAKE_DATA, 1000);
+    CHECK(pacer.BeginFrame(PERIOD_60HZ - PERIOD_60HZ / 4 - 10) == 0);
+    CHECK(pacer.BeginFrame(PERIOD_60HZ - 3000) == RENDER_WAKE_DATA);
+
+    // Woken two vblanks late (a long stall): presents immediately rather than waiting again
+    pacer.Post(RENDER_WAKE_INPUT, 100000);
+    CHECK(pacer.WaitUs(140000) == 0);
+    CHECK(pacer.BeginFrame(140000) == RENDER_WAKE_INPUT);
+}
+
+// Animating for one simulated second: every present on the grid, spaced by the capped interval
+static void CheckCap(int64_t period, int maxFps, int64_t wantIntervalUs) {
+    RenderPacer pacer;
+    pacer.SetRefresh(period, 0);
+    pacer.SetMaxFps(maxFps);
+    CHECK(pacer.FrameIntervalUs() == wantIntervalUs);
+
+    pacer.SetAnimating(true);
+    int64_t now = 0;
+    std::vector<Present> p = RunUntil(pacer, now, 1000000);
+    int64_t expected = 1000000 / wantIntervalUs;
+    CHECK((int64_t)p.size() >= expected - 1 && (int64_t)p.size() <= expected + 1);
+    for (size_t i = 0; i < p.size(); i++) {
+        CHECK(OnGrid(p[i].timeUs, period, 0));
+        CHECK(p[i].reasons & RENDER_WAKE_ANIMATION);
+        if (i) CHECK(p[i].timeUs - p[i - 1].timeUs == wantIntervalUs);
+    }
+    fprintf(stderr, "%lld us refresh, cap %d fps: %zu presents in 1 s, every %lld us\n",
+        (long long)period, maxFps, p.size(), (long long)wantIntervalUs);
+}
+
+static void TestTimersAndPhase() {
+    RenderPacer pacer;
+    pacer.SetRefresh(PERIOD_60HZ, 0);
+    pacer.WakeAt(80000);
+    pacer.WakeAt(50000);        // The earlier one wins
+    CHECK(pacer.WaitUs(0) == 50000);
+    int64_t now = 0;
+    std::vector<Present> p = RunUntil(pacer, now, 200000);
+    CHECK(p.size() == 1);
+    CHECK(!p.empty() && p[0].reasons == RENDER_WAKE_TIMER && p[0].timeUs >= 50000 && p[0].timeUs <= 50000 + PERIOD_60HZ);
+    CHECK(pacer.WaitUs(now) == RenderPacer::WAIT_FOREVER);     // One-shot
+
+    // The grid follows the reported vblank phase
+    RenderPacer shifted;
+    shifted.SetRefresh(PERIOD_60HZ, 5000);
+    shifted.Post(RENDER_WAKE_DATA, 6000);
+    now = 6000;
+    p = RunUntil(shifted, now, 200000);
+    CHECK(p.size() == 1 && p[0].timeUs == 5000 + PERIOD_60HZ);
+}
+
+int main() {
+    TestIdleAndCoalesce();
+    TestEarlyAndLateWake();
+    CheckCap(PERIOD_60HZ, 0, PERIOD_60HZ);              // Uncapped: every vblank
+    CheckCap(PERIOD_144HZ, 60, 2 * PERIOD_144HZ);       // 60 fps on 144 Hz: every other vblank (72 fps)
+    CheckCap(PERIOD_144HZ, 30, 5 * PERIOD_144HZ);       // 33.3 ms rounds to 5 periods
+    CheckCap(PERIOD_60HZ, 240, PERIOD_60HZ);            // A cap above the refresh rate changes nothing
+    TestTimersAndPhase();
+    return TestResult("render_pacer_test");
+}
@@ -0,0 +1,114 @@
+// Stress test for SeqLock: writers hammer their sections while readers check that every
+// copy is one whole Store, never a mix of two, and that no section goes backwards.
+//   1. One section, one writer, a reader on every other core.
+//   2. Concurrent sections: one writer per section (as the stats sections have), readers
+//      copying all of them in a row the way ReadStats() does.
+//   seqlock_test [seconds per case]
+// Build: g++ -std=c++20 -O2 -I.. seqlock_test.cpp -lpthread -o seqlock_test
+#include "../SeqLock.hpp"
+#include "TestCheck.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Several cache lines on purpose: a torn copy mixes words from two generations
+struct Payload {
+    uint32_t section;
+    uint32_t pad;
+    uint64_t generation;
+    uint64_t words[30];         // generation * (i + 1)
+    uint64_t checksum;          // generation ^ every word
+};
+
+static Payload Make(uint32_t section, uint64_t generation) {
+    Payload p = {};
+    p.section = section;
+    p.generation = generation;
+    p.checksum = generation;
+    for (int i = 0; i < 30; i++) { p.words[i] = generation * (i + 1); p.checksum ^= p.words[i]; }
+    return p;
+}
+
+static bool Whole(const Payload& p, uint32_t section) {
+    if (p.generation == 0) return p.section == 0 && p.checksum == 0;     // Never stored yet
+    uint64_t sum = p.generation;
+    for (int i = 0; i < 30; i++) {
+        if (p.words[i] != p.generation * (i + 1)) return false;
+        sum ^= p.words[i];
+    }
+    return p.section == section && p.checksum == sum;
+}
+
+struct Counters {
+    std::atomic<uint64_t> reads{ 0 };
+    std::atomic<uint64_t> torn{ 0 };
+    std::atomic<uint64_t> backwards{ 0 };
+    std::atomic<uint64_t> generationsSeen{ 0 };
+};
+
+// 'sections' SeqLocks, one writer each, 'readers' threads reading all of them in turn
+static void RunCase(const char* name, int sections, int readers, double seconds) {
+    std::vector<SeqLock<Payload>> locks(sections);
+    std::atomic<bool> stop{ false };
+    std::vector<uint64_t> written(sections, 0);
+    Counters c;
+
+    std::vector<std::thread> threads;
+    for (int s = 0; s < sections; s++) {
+        threads.emplace_back([&, s]() {
+            uint64_t g = 0;
+            while (!stop.load(std::memory_order_relaxed)) locks[s].Store(Make((uint32_t)s, ++g));
+            written[s] = g;
+        });
+    }
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&]() {
+            std::vector<uint64_t> last(sections, 0);
+            std::vector<uint32_t> lastVersion(sections, 0);
+            uint64_t reads = 0, torn = 0, backwards = 0, changes = 0;
+            Payload p;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int s = 0; s < sections; s++) {
+                    locks[s].Load(p);
+                    uint32_t version = locks[s].Version();
+                    reads++;
+                    if (!Whole(p, (uint32_t)s)) torn++;
+                    if (p.generation < last[s] || version < lastVersion[s]) backwards++;
+                    if (p.generation != last[s]) changes++;
+                    last[s] = p.generation;
+                    lastVersion[s] = version;
+                }
+            }
+            c.reads += reads; c.torn += torn; c.backwards += backwards; c.generationsSeen += changes;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (auto& t : threads) t.join();
+
+    uint64_t stores = 0;
+    for (uint64_t w : written) stores += w;
+    fprintf(stderr, "%s: %d sections, %d readers: %llu stores, %llu reads, %llu generations seen, %llu torn, %llu backwards\n",
+        name, sections, readers, (unsigned long long)stores, (unsigned long long)c.reads.load(), (unsigned long long)c.generationsSeen.load(),
+        (unsigned long long)c.torn.load(), (unsigned long long)c.backwards.load());
+    CHECK(c.torn == 0);
+    CHECK(c.backwards == 0);
+    // The run only means something if readers actually raced the writers
+    CHECK(stores > 1000);
+    CHECK(c.generationsSeen > 100);
+    for (int s = 0; s < sections; s++) CHECK(Whole(locks[s].Load(), (uint32_t)s) && locks[s].Load().generation == written[s]);
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 1.0;
+    int cores = (int)(std::max)(std::thread::hardware_concurrency(), 2u);
+
+    SeqLock<Payload> fresh;
+    CHECK(Whole(fresh.Load(), 0));      // Zero-initialized before any writer runs
+
+    RunCase("single section", 1, (std::max)(cores - 1, 3), seconds);
+    RunCase("concurrent sections", 4, (std::max)(cores - 4, 3), seconds);
+    return TestResult("seqlock_test");
+}
@@ -0,0 +1,165 @@
+// DiffUiFrames: which rects a frame change dirties.
+//   1. First frame or a resize dirties everything; an identical frame nothing.
+//   2. A changed widget dirties its rect; a moved one its old and new rects; an added or
+//      removed one its own. Results are clipped to the frame.
+//   3. Overlapping rects merge; more than 'max' collapse to their bounding box.
+//   4. With the layout cache a digit change dirties only those glyphs; any other text change
+//      (or no cache) the whole line.
+//   5. The real overlay: one changed reading repaints a small part of the window.
+// Build: g++ -std=c++20 -O2 -I.. ui_diff_test.cpp ../UiTree.cpp ../TextLayout.cpp ../GlyphAtlas.cpp ../OverlayLayout.cpp -o ui_diff_test
+#include "../OverlayLayout.hpp"
+#include "../TextLayout.hpp"
+#include "../UiTree.hpp"
+#include "TestCheck.hpp"
+#include <cwchar>
+#include <memory>
+
+static int64_t Area(const UiRect* rects, int n) {
+    int64_t a = 0;
+    for (int i = 0; i < n; i++) a += (int64_t)rects[i].w * rects[i].h;
+    return a;
+}
+
+static bool Covers(const UiRect& outer, const UiRect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y && inner.Right() <= outer.Right() && inner.Bottom() <= outer.Bottom();
+}
+
+// A few widgets spread down a 400x600 frame
+static void BuildSample(UiFrame& f, float barValue = 0.5f, const wchar_t* label = L"CPU 42%") {
+    f.Clear(400, 600);
+    f.Add(UiKind::Panel, { 0, 0, 400, 600 }).alpha = 230;
+    f.Text(UiFont::Header, UiColor::White, 20, 20, label);
+    UiWidget& bar = f.Add(UiKind::Bar, { 20, 50, 360, 8 });
+    bar.value = barValue;
+    f.Text(UiFont::Body, UiColor::Gray, 20, 300, L"Fan Control");
+    f.Add(UiKind::Button, { 20, 540, 170, 30 });
+}
+
+static void TestWholeAndNothing() {
+    UiFrame empty, a, b;
+    UiRect out[UI_MAX_DIRTY];
+    BuildSample(a);
+    BuildSample(b);
+    CHECK(DiffUiFrames(empty, a, out, UI_MAX_DIRTY) == 1 && out[0] == (UiRect{ 0, 0, 400, 600 }));
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 0);
+    b.Clear(400, 640);
+    BuildSample(b);
+    b.height = 640;
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 1 && out[0] == (UiRect{ 0, 0, 400, 640 }));
+}
+
+static void TestWidgetChanges() {
+    UiFrame a, b;
+    UiRect out[UI_MAX_DIRTY];
+    BuildSample(a, 0.5f);
+    BuildSample(b, 0.75f);
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 1 && out[0] == (UiRect{ 20, 50, 360, 8 }));
+
+    // Moved: the old and the new position both repaint
+    BuildSample(b);
+    b.widgets[4].rect = { 210, 540, 170, 30 };
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 1 && out[0] == (UiRect{ 20, 540, 360, 30 }));
+
+    // Added at the end, then removed again
+    BuildSample(b);
+    b.Add(UiKind::Dot, { 380, 10, 10, 10 });
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 1 && out[0] == (UiRect{ 380, 10, 10, 10 }));
+    CHECK(DiffUiFrames(b, a, out, UI_MAX_DIRTY) == 1 && out[0] == (UiRect{ 380, 10, 10, 10 }));
+
+    // Hanging off the frame: clipped
+    BuildSample(b);
+    b.widgets[4].rect = { 350, 580, 100, 50 };
+    int n = DiffUiFrames(a, b, out, UI_MAX_DIRTY);
+    CHECK(n >= 1);
+    for (int i = 0; i < n; i++) CHECK(Covers({ 0, 0, 400, 600 }, out[i]));
+}
+
+static void TestMergeAndCollapse() {
+    UiFrame a, b;
+    UiRect out[UI_MAX_DIRTY];
+
+    // Two changes far apart stay two rects
+    BuildSample(a, 0.5f);
+    BuildSample(b, 0.75f);
+    b.widgets[4].active = true;
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 2);
+
+    // Overlapping ones merge into their union
+    a.Clear(400, 600);
+    b.Clear(400, 600);
+    for (int i = 0; i < 3; i++) {
+        a.Add(UiKind::Dot, { 100 + i * 15, 100, 20, 20 });
+        b.Add(UiKind::Dot, { 100 + i * 15, 100, 20, 20 }).active = true;
+    }
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 1 && out[0] == (UiRect{ 100, 100, 50, 20 }));
+
+    // More separate rects than allowed: one bounding box
+    a.Clear(400, 600);
+    b.Clear(400, 600);
+    for (int i = 0; i < UI_MAX_DIRTY + 2; i++) {
+        a.Add(UiKind::Dot, { 10 + i * 30, 10 + i * 50, 10, 10 });
+        b.Add(UiKind::Dot, { 10 + i * 30, 10 + i * 50, 10, 10 }).active = true;
+    }
+    int last = UI_MAX_DIRTY + 1;
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 1 && out[0] == (UiRect{ 10, 10, last * 30 + 10, last * 50 + 10 }));
+    CHECK(DiffUiFrames(a, b, out, 2) == 1);
+}
+
+static void TestTextSpans() {
+    UiFrame a, b;
+    UiRect out[UI_MAX_DIRTY];
+    TextLayoutCache cache;
+    const UiRect line = { 20, 20, 380, UiLineHeight(UiFont::Header) };
+
+    // Only the changed digit: inside the line, much narrower than it, right of the "CPU " prefix
+    BuildSample(a, 0.5f, L"CPU 42%");
+    BuildSample(b, 0.5f, L"CPU 47%");
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY, &cache) == 1);
+    CHECK(Covers(line, out[0]) && out[0].h == line.h);
+    int prefix = cache.Layout(UiFont::Header, L"CPU 4").width;
+    CHECK(out[0].w > 0 && out[0].w < 40 && out[0].x >= line.x + prefix - 4);
+
+    // Without the cache, the whole line
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY) == 1 && out[0] == line);
+
+    // A non-digit or length change cannot reuse the layout: the whole line
+    BuildSample(b, 0.5f, L"CPU 42% !");
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY, &cache) == 1 && out[0] == line);
+    BuildSample(b, 0.5f, L"GPU 42%");
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY, &cache) == 1 && out[0] == line);
+}
+
+static void TestOverlay() {
+    OverlayState st;
+    st.cpuName = L"Test CPU";
+    st.gpuName = L"Test GPU";
+    auto s = std::make_unique<StatsSnapshot>();
+    s->cpu.usage = 42;
+    s->cpu.coreCount = 8;
+    for (int i = 0; i < 8; i++) s->cpu.coreLoad[i] = 10 * i;
+    s->board.cpuTemp = 55;
+
+    UiFrame a, b;
+    UiRect out[UI_MAX_DIRTY];
+    TextLayoutCache cache;
+    BuildOverlay(st, *s, UI_WIDTH_NORMAL, 850, a);
+    BuildOverlay(st, *s, UI_WIDTH_NORMAL, 850, b);
+    CHECK(DiffUiFrames(a, b, out, UI_MAX_DIRTY, &cache) == 0);
+
+    s->board.cpuTemp = 56;
+    BuildOverlay(st, *s, UI_WIDTH_NORMAL, 850, b);
+    int n = DiffUiFrames(a, b, out, UI_MAX_DIRTY, &cache);
+    int64_t area = Area(out, n);
+    fprintf(stderr, "overlay, CPU temperature 55 -> 56: %d rect(s), %lld px of %d\n", n, (long long)area, UI_WIDTH_NORMAL * 850);
+    CHECK(n >= 1);
+    CHECK(area > 0 && area < UI_WIDTH_NORMAL * 850 / 50);
+}
+
+int main() {
+    TestWholeAndNothing();
+    TestWidgetChanges();
+    TestMergeAndCollapse();
+    TestTextSpans();
+    TestOverlay();
+    return TestResult("ui_diff_test");
+}
@@ -0,0 +1,143 @@
+// WmiReader against a scripted IWmiSource: the query layer without COM.
+//   1. Each WQL text is prepared once; every later read re-runs the prepared id.
+//   2. Results decode as the overlay uses them: first row, module sums, 64-bit
+//      capacities that arrive as strings.
+//   3. The perf object is bound to the refresher once; each read is one Refresh.
+//   4. While the service is down nothing is cached, and the first call after it comes
+//      up prepares/binds.
+// Build: g++ -std=c++20 -O2 -I.. wmi_source_test.cpp ../WmiReader.cpp -o wmi_source_test
+#include "../WmiReader.hpp"
+#include "TestCheck.hpp"
+#include <cwchar>
+#include <map>
+#include <vector>
+
+// Every property as text, the way CIM hands over 64-bit integers
+struct FakeRow : IWmiRow {
+    std::map<std::wstring, std::wstring> props;
+    std::wstring String(const wchar_t* prop) const override {
+        auto it = props.find(prop);
+        return it == props.end() ? L"" : it->second;
+    }
+    long long Int(const wchar_t* prop) const override { return wcstoll(String(prop).c_str(), nullptr, 10); }
+};
+
+class FakeWmiSource : public IWmiSource {
+public:
+    bool up = true;
+    std::map<std::wstring, std::vector<FakeRow>> tables;          // WQL text -> rows
+    std::map<std::wstring, std::vector<long long>> perfObjects;   // Object path -> property values
+    std::vector<std::wstring> prepared;
+    int prepareCalls = 0, execCalls = 0, addRefreshedCalls = 0, refreshCalls = 0;
+    std::vector<int> execIds;
+
+    int Prepare(const wchar_t* wql) override {
+        prepareCalls++;
+        if (!up) return -1;
+        for (size_t i = 0; i < prepared.size(); i++) if (prepared[i] == wql) return (int)i;
+        prepared.push_back(wql);
+        return (int)prepared.size() - 1;
+    }
+    bool Exec(int query, const std::function<bool(const IWmiRow&)>& onRow) override {
+        execCalls++;
+        execIds.push_back(query);
+        if (!up || query < 0 || query >= (int)prepared.size()) return false;
+        for (const FakeRow& row : tables[prepared[query]]) if (!onRow(row)) break;
+        return true;
+    }
+    int AddRefreshed(const wchar_t* objectPath, const wchar_t* const* props, int propCount) override {
+        addRefreshedCalls++;
+        if (!up || !perfObjects.count(objectPath)) return -1;
+        bound.push_back({ objectPath, propCount });
+        CHECK(propCount == 2 && wcscmp(props[0], L"Threads") == 0);
+        return (int)bound.size() - 1;
+    }
+    bool Refresh() override { refreshCalls++; return up; }
+    bool ReadRefreshed(int handle, long long* out) override {
+        if (handle < 0 || handle >= (int)bound.size()) return false;
+        const std::vector<long long>& v = perfObjects[bound[handle].first];
+        for (int i = 0; i < bound[handle].second; i++) out[i] = i < (int)v.size() ? v[i] : 0;
+        return true;
+    }
+
+private:
+    std::vector<std::pair<std::wstring, int>> bound;
+};
+
+static FakeRow Row(std::initializer_list<std::pair<const std::wstring, std::wstring>> props) {
+    FakeRow r;
+    r.props = props;
+    return r;
+}
+
+static void Populate(FakeWmiSource& wmi) {
+    wmi.tables[L"SELECT Product FROM Win32_BaseBoard"] = { Row({ { L"Product", L"MAG B550 TOMAHAWK (MS-7C91)" } }) };
+    wmi.tables[L"SELECT Name FROM Win32_VideoController"] = { Row({ { L"Name", L"Discrete" } }), Row({ { L"Name", L"Integrated" } }) };
+    wmi.tables[L"SELECT Capacity, Speed FROM Win32_PhysicalMemory"] = {
+        Row({ { L"Capacity", L"17179869184" }, { L"Speed", L"3200" } }),
+        Row({ { L"Capacity", L"17179869184" }, { L"Speed", L"3600" } }),
+    };
+    wmi.perfObjects[L"Win32_PerfFormattedData_PerfOS_System=@"] = { 2841, 51234 };
+}
+
+static void TestPreparedReuse() {
+    FakeWmiSource wmi;
+    Populate(wmi);
+    WmiReader reader(wmi);
+    WmiRamInfo ram;
+    for (int i = 0; i < 5; i++) {
+        CHECK(reader.RamInfo(ram));
+        CHECK(reader.BoardProduct() == L"MAG B550 TOMAHAWK (MS-7C91)");
+    }
+    CHECK(wmi.prepareCalls == 2 && wmi.prepared.size() == 2);
+    CHECK(wmi.execCalls == 10);
+    int ramId = wmi.execIds[0];
+    for (size_t i = 0; i < wmi.execIds.size(); i += 2) CHECK(wmi.execIds[i] == ramId);
+
+    CHECK(ram.modules == 2 && ram.capacityBytes == 32ull << 30 && ram.speedMTs == 3600);
+    CHECK(reader.GpuName() == L"Discrete");         // The first row only
+
+    wmi.tables[L"SELECT Capacity, Speed FROM Win32_PhysicalMemory"].clear();
+    CHECK(!reader.RamInfo(ram) && ram.modules == 2);    // No modules: false, output untouched
+    wmi.tables[L"SELECT Product FROM Win32_BaseBoard"].clear();
+    CHECK(reader.BoardProduct().empty());
+}
+
+static void TestRefresher() {
+    FakeWmiSource wmi;
+    Populate(wmi);
+    WmiReader reader(wmi);
+    WmiSystemCounters c;
+    for (int i = 0; i < 10; i++) {
+        wmi.perfObjects[L"Win32_PerfFormattedData_PerfOS_System=@"][0] = 2800 + i;
+        CHECK(reader.SystemCounters(c));
+        CHECK(c.threads == 2800 + i && c.contextSwitchesPerSec == 51234);
+    }
+    CHECK(wmi.addRefreshedCalls == 1 && wmi.refreshCalls == 10);
+    CHECK(wmi.prepareCalls == 0 && wmi.execCalls == 0);     // No queries on the polling path
+}
+
+static void TestServiceDown() {
+    FakeWmiSource wmi;
+    Populate(wmi);
+    wmi.up = false;
+    WmiReader reader(wmi);
+    WmiRamInfo ram;
+    WmiSystemCounters c;
+    CHECK(!reader.RamInfo(ram) && reader.GpuName().empty() && !reader.SystemCounters(c));
+    CHECK(!reader.RamInfo(ram) && !reader.SystemCounters(c));
+    CHECK(wmi.prepareCalls == 3 && wmi.addRefreshedCalls == 2 && wmi.execCalls == 0);
+
+    // Comes up: prepared and bound on the next call, then reused
+    wmi.up = true;
+    CHECK(reader.RamInfo(ram) && reader.RamInfo(ram) && ram.modules == 2);
+    CHECK(reader.SystemCounters(c) && reader.SystemCounters(c) && c.threads == 2841);
+    CHECK(wmi.prepareCalls == 4 && wmi.addRefreshedCalls == 3);
+}
+
+int main() {
+    TestPreparedReuse();
+    TestRefresher();
+    TestServiceDown();
+    return TestResult("wmi_source_test");
+}
@@ -0,0 +1,153 @@
+// Query tool for telemetry logs (.tlog) from one or many machines.
+// Logs are memory-mapped; only blocks in the window and matching
+// columns are decoded, and files are scanned in parallel.
+//   tlogquery [--from T] [--to T] [--last 7d] [--sensor name|prefix*]...
+//             [--above [sensor=]value]... [--max-gap ms] [--no-detail]
+//             [--threads n] [--per-file] [--csv] file.tlog...
+// T is unix seconds or UTC "YYYY-MM-DD[THH:MM[:SS]]"; --last is relative
+// to the newest sample in the given logs.
+// Build: make, or g++ -std=c++20 -O2 tlogquery.cpp TelemetryQuery.cpp TelemetryLog.cpp MappedFile.cpp SensorHub.cpp -lpthread
+#include "TelemetryQuery.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+// Days since 1970-01-01 for a proleptic Gregorian date (no timegm on every platform)
+static int64_t DaysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static bool ParseTime(const char* s, int64_t& ms) {
+    int y, mo, d, h = 0, mi = 0, sec = 0;
+    if (sscanf(s, "%d-%d-%d", &y, &mo, &d) == 3) {
+        const char* t = strpbrk(s, "T ");
+        if (t && sscanf(t + 1, "%d:%d:%d", &h, &mi, &sec) < 2) return false;
+        ms = ((DaysFromCivil(y, mo, d) * 24 + h) * 60 + mi) * 60000LL + sec * 1000LL;
+        return true;
+    }
+    char* end;
+    double v = strtod(s, &end);
+    if (end == s || *end) return false;
+    ms = (int64_t)(v * 1000.0);
+    return true;
+}
+
+static bool ParseDuration(const char* s, int64_t& ms) {
+    char* end;
+    double v = strtod(s, &end);
+    if (end == s) return false;
+    switch (*end) {
+    case 's': ms = (int64_t)(v * 1000.0); break;
+    case 'm': ms = (int64_t)(v * 60000.0); break;
+    case 'h': ms = (int64_t)(v * 3600000.0); break;
+    case 'd': ms = (int64_t)(v * 86400000.0); break;
+    case 'w': ms = (int64_t)(v * 604800000.0); break;
+    default: return false;
+    }
+    return end[1] == 0;
+}
+
+static void FormatDuration(int64_t ms, char* out, size_t size) {
+    int64_t s = ms / 1000;
+    if (s >= 86400) snprintf(out, size, "%lldd%02lldh", (long long)(s / 86400), (long long)(s % 86400 / 3600));
+    else if (s >= 3600) snprintf(out, size, "%lldh%02lldm", (long long)(s / 3600), (long long)(s % 3600 / 60));
+    else if (s >= 60) snprintf(out, size, "%lldm%02llds", (long long)(s / 60), (long long)(s % 60));
+    else snprintf(out, size, "%llds", (long long)s);
+}
+
+static void PrintHeader(bool csv) {
+    if (csv) printf("source,sensor,unit,samples,min,avg,p50,p95,p99,max,threshold,above_s,above_pct\n");
+    else printf("%-28s %-5s %9s %9s %9s %9s %9s %9s %9s %10s %7s\n", "sensor", "unit", "samples", "min", "avg", "p50", "p95", "p99", "max", "above", "above%");
+}
+
+static void PrintAggregate(const char* source, const SensorAggregate& a, bool csv) {
+    if (a.samples == 0) return;
+    double avg = a.sum / (double)a.samples;
+    // Sketch values are bucket midpoints; keep them inside the observed range
+    double p50 = std::clamp(a.sketch.Quantile(0.50), (double)a.min, (double)a.max);
+    double p95 = std::clamp(a.sketch.Quantile(0.95), (double)a.min, (double)a.max);
+    double p99 = std::clamp(a.sketch.Quantile(0.99), (double)a.min, (double)a.max);
+    double abovePct = a.coveredMs > 0 ? 100.0 * (double)a.aboveMs / (double)a.coveredMs : 0.0;
+    if (csv) {
+        printf("%s,%s,%s,%llu,%g,%g,%g,%g,%g,%g,", source, a.name.c_str(), SensorUnitSuffix(a.unit), (unsigned long long)a.samples, a.min, avg, p50, p95, p99, a.max);
+        if (a.hasThreshold) printf("%g,%.3f,%.2f\n", a.threshold, a.aboveMs / 1000.0, abovePct);
+        else printf(",,\n");
+        return;
+    }
+    char above[32] = "-", pct[16] = "-";
+    if (a.hasThreshold) {
+        FormatDuration(a.aboveMs, above, sizeof(above));
+        snprintf(pct, sizeof(pct), "%.1f", abovePct);
+    }
+    printf("%-28s %-5s %9llu %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %10s %7s\n", a.name.c_str(), SensorUnitSuffix(a.unit),
+        (unsigned long long)a.samples, a.min, avg, p50, p95, p99, a.max, above, pct);
+}
+
+static int Usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--from T] [--to T] [--last 7d] [--sensor name|prefix*]... [--above [sensor=]value]...\n"
+        "       [--max-gap ms] [--no-detail] [--threads n] [--per-file] [--csv] file.tlog...\n", argv0);
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    TelemetryQuery query;
+    std::vector<std::string> files;
+    int64_t lastMs = 0;
+    int threads = (int)(std::max)(1u, std::thread::hardware_concurrency());
+    bool perFile = false, csv = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(a, "--from") == 0 && hasValue) { if (!ParseTime(argv[++i], query.fromMs)) return Usage(argv[0]); }
+        else if (strcmp(a, "--to") == 0 && hasValue) { if (!ParseTime(argv[++i], query.toMs)) return Usage(argv[0]); }
+        else if (strcmp(a, "--last") == 0 && hasValue) { if (!ParseDuration(argv[++i], lastMs)) return Usage(argv[0]); }
+        else if (strcmp(a, "--sensor") == 0 && hasValue) query.sensors.push_back(argv[++i]);
+        else if (strcmp(a, "--above") == 0 && hasValue) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            std::string name = eq == std::string::npos ? "" : spec.substr(0, eq);
+            query.thresholds[name] = atof(spec.c_str() + (eq == std::string::npos ? 0 : eq + 1));
+        }
+        else if (strcmp(a, "--max-gap") == 0 && hasValue) query.maxGapMs = atoll(argv[++i]);
+        else if (strcmp(a, "--no-detail") == 0) query.includeDetail = false;
+        else if (strcmp(a, "--threads") == 0 && hasValue) threads = atoi(argv[++i]);
+        else if (strcmp(a, "--per-file") == 0) perFile = true;
+        else if (strcmp(a, "--csv") == 0) csv = true;
+        else if (a[0] == '-') return Usage(argv[0]);
+        else files.push_back(a);
+    }
+    if (files.empty()) return Usage(argv[0]);
+
+    if (lastMs > 0) {
+        int64_t newest = TelemetryNewestMs(files);
+        if (newest != INT64_MIN) query.fromMs = (std::max)(query.fromMs, newest - lastMs);
+    }
+
+    std::vector<TelemetryFileResult> results;
+    std::vector<SensorAggregate> merged;
+    RunTelemetryQuery(files, query, threads, results, merged);
+
+    for (const TelemetryFileResult& r : results) {
+        if (!r.ok) fprintf(stderr, "%s: not a telemetry log\n", r.path.c_str());
+        else if (r.recovered) fprintf(stderr, "%s: no footer, index rebuilt by scanning\n", r.path.c_str());
+    }
+
+    PrintHeader(csv);
+    if (perFile) {
+        for (const TelemetryFileResult& r : results) {
+            if (!csv) printf("# %s (%d blocks)\n", r.path.c_str(), r.blocksRead);
+            for (const SensorAggregate& a : r.sensors) PrintAggregate(r.path.c_str(), a, csv);
+        }
+        if (!csv) printf("# all\n");
+    }
+    for (const SensorAggregate& a : merged) PrintAggregate("all", a, csv);
+    return 0;
+}
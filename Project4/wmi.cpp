@@ -0,0 +1,188 @@
+#include "shared.hpp"
+#include "WmiReader.hpp"
+#include "WmiSource.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+constexpr ULONGLONG WMI_RETRY_MIN_MS = 1000;
+constexpr ULONGLONG WMI_RETRY_MAX_MS = 60000;
+
+// The main thread joins the MTA and never leaves, so the MTA (and every proxy the session
+// holds) outlives all worker threads, short-lived ones included; they use it implicitly
+void InitCom() {
+    CoInitializeEx(0, COINIT_MULTITHREADED);
+}
+
+class ComRow : public IWmiRow {
+public:
+    explicit ComRow(IWbemClassObject* obj) : obj(obj) {}
+    std::wstring String(const wchar_t* prop) const override {
+        VARIANT v; VariantInit(&v);
+        if (FAILED(obj->Get(prop, 0, &v, 0, 0))) return L"Unknown";
+        std::wstring res = (v.vt == VT_BSTR) ? v.bstrVal : L"Unknown";
+        VariantClear(&v); return res;
+    }
+    long long Int(const wchar_t* prop) const override {
+        VARIANT v; VariantInit(&v);
+        if (FAILED(obj->Get(prop, 0, &v, 0, 0))) return 0;
+        long long res = (v.vt == VT_I4) ? v.intVal : (v.vt == VT_UI4) ? (long long)v.uintVal
+            : (v.vt == VT_BSTR) ? _wtoi64(v.bstrVal) : 0; // 64-bit CIM values arrive as strings
+        VariantClear(&v); return res;
+    }
+private:
+    IWbemClassObject* obj;
+};
+
+// ---------------------------------------------------------
+//  WMI SESSION
+//  One locator/service connection for the whole process.
+// ---------------------------------------------------------
+class WmiSession : public IWmiSource {
+public:
+    explicit WmiSession(const wchar_t* ns) : ns(ns) {}
+    ~WmiSession() {
+        for (auto& r : refreshed) if (r.access) r.access->Release();
+        if (config) config->Release();
+        if (refresher) refresher->Release();
+        if (pSvc) pSvc->Release();
+        if (pLoc) pLoc->Release();
+    }
+
+    int Prepare(const wchar_t* wql) override {
+        std::lock_guard<std::mutex> l(mutex);
+        if (!Connect()) return -1;
+        auto it = ids.find(wql);
+        if (it != ids.end()) return it->second;
+        int id = (int)prepared.size();
+        prepared.push_back(_bstr_t(wql));
+        ids.emplace(wql, id);
+        return id;
+    }
+
+    bool Exec(int query, const std::function<bool(const IWmiRow&)>& onRow) override {
+        _bstr_t text;
+        {
+            std::lock_guard<std::mutex> l(mutex);
+            if (query < 0 || query >= (int)prepared.size() || !pSvc) return false;
+            text = prepared[query];
+        }
+        IEnumWbemClassObject* pEnum = nullptr;
+        HRESULT hr = pSvc->ExecQuery(wql, text, WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, NULL, &pEnum);
+        if (FAILED(hr) || !pEnum) return false;
+
+        IWbemClassObject* pObj = nullptr; ULONG uRet = 0;
+        bool more = true;
+        while (more && SUCCEEDED(pEnum->Next(WBEM_INFINITE, 1, &pObj, &uRet)) && uRet) {
+            more = onRow(ComRow(pObj));
+            pObj->Release();
+        }
+        pEnum->Release();
+        return true;
+    }
+
+    int AddRefreshed(const wchar_t* objectPath, const wchar_t* const* props, int propCount) override {
+        std::lock_guard<std::mutex> l(mutex);
+        if (!Connect()) return -1;
+        if (!refresher) {
+            if (FAILED(CoCreateInstance(CLSID_WbemRefresher, NULL, CLSCTX_INPROC_SERVER, IID_IWbemRefresher, (void**)&refresher))) return -1;
+            if (FAILED(refresher->QueryInterface(IID_IWbemConfigureRefresher, (void**)&config))) { refresher->Release(); refresher = nullptr; config = nullptr; return -1; }
+        }
+
+        Refreshed r;
+        IWbemClassObject* pObj = nullptr; long lId = 0;
+        if (FAILED(config->AddObjectByPath(pSvc, objectPath, 0, NULL, &pObj, &lId)) || !pObj) return -1;
+        HRESULT hr = pObj->QueryInterface(IID_IWbemObjectAccess, (void**)&r.access);
+        pObj->Release();
+        if (FAILED(hr)) return -1;
+
+        for (int i = 0; i < propCount; i++) {
+            Refreshed::Prop p;
+            if (FAILED(r.access->GetPropertyHandle(props[i], &p.type, &p.handle))) p.handle = -1;
+            r.props.push_back(p);
+        }
+        refreshed.push_back(std::move(r));
+        return (int)refreshed.size() - 1;
+    }
+
+    bool Refresh() override {
+        return refresher && SUCCEEDED(refresher->Refresh(0L));
+    }
+
+    bool ReadRefreshed(int handle, long long* out) override {
+        if (handle < 0 || handle >= (int)refreshed.size()) return false;
+        const Refreshed& r = refreshed[handle];
+        for (size_t i = 0; i < r.props.size(); i++) {
+            const Refreshed::Prop& p = r.props[i];
+            out[i] = 0;
+            if (p.handle < 0) continue;
+            if (p.type == CIM_UINT64 || p.type == CIM_SINT64) {
+                unsigned __int64 q = 0; r.access->ReadQWORD(p.handle, &q); out[i] = (long long)q;
+            }
+            else {
+                DWORD d = 0; r.access->ReadDWORD(p.handle, &d); out[i] = d;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Refreshed {
+        struct Prop { long handle = -1; CIMTYPE type = CIM_EMPTY; };
+        IWbemObjectAccess* access = nullptr;
+        std::vector<Prop> props;
+    };
+
+    // A failure (WMI still starting after boot, the service restarting) is retried
+    // on later calls, backing off from 1 s to a minute
+    bool Connect() {
+        if (pSvc) return true;
+        ULONGLONG now = GetTickCount64();
+        if (now < retryAt) return false;
+        if (!pLoc && FAILED(CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER, IID_IWbemLocator, (LPVOID*)&pLoc))) {
+            pLoc = nullptr;
+            return Backoff(now);
+        }
+        if (FAILED(pLoc->ConnectServer(_bstr_t(ns), NULL, NULL, 0, NULL, 0, 0, &pSvc))) { pSvc = nullptr; return Backoff(now); }
+        HRESULT hres = CoSetProxyBlanket(pSvc, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL, RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE);
+        if (FAILED(hres)) { pSvc->Release(); pSvc = nullptr; return Backoff(now); }
+        retryDelayMs = 0;
+        return true;
+    }
+
+    bool Backoff(ULONGLONG now) {
+        retryDelayMs = retryDelayMs ? (std::min)(retryDelayMs * 2, WMI_RETRY_MAX_MS) : WMI_RETRY_MIN_MS;
+        retryAt = now + retryDelayMs;
+        return false;
+    }
+
+    const wchar_t* ns;
+    std::mutex mutex;
+    IWbemLocator* pLoc = nullptr;
+    IWbemServices* pSvc = nullptr;
+    ULONGLONG retryAt = 0;
+    ULONGLONG retryDelayMs = 0;
+    _bstr_t wql = L"WQL";
+    std::vector<_bstr_t> prepared;
+    std::unordered_map<std::wstring, int> ids;
+    IWbemRefresher* refresher = nullptr;
+    IWbemConfigureRefresher* config = nullptr;
+    std::vector<Refreshed> refreshed;
+};
+
+static std::atomic<IWmiSource*> s_WmiOverride{ nullptr };
+
+IWmiSource& GetWmi() {
+    if (IWmiSource* o = s_WmiOverride.load()) return *o;
+    // Never destroyed: releasing COM proxies from a static destructor runs after the
+    // threads that used them are gone and under the loader lock
+    static WmiSession* session = new WmiSession(L"ROOT\\CIMV2");
+    return *session;
+}
+
+void SetWmiSource(IWmiSource* source) { s_WmiOverride = source; }
+
+// Bound to whatever GetWmi() returns on first use; never destroyed, like the session
+WmiReader& GetWmiReader() {
+    static WmiReader* reader = new WmiReader(GetWmi());
+    return *reader;
+}